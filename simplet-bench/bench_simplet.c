@@ -0,0 +1,747 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "simplet.h"
+#include "simplet_template.h"
+#include "simplet_dictionary.h"
+#include "simplet_scan.h"
+
+/*
+ * Microbenchmarks for the renderer and dictionary
+ * Usage: simplet_bench [results.jsonl]
+ * Prints a table and writes one JSON object per benchmark (JSON Lines) so
+ * runs of different builds can be compared. Inputs are generated from a
+ * fixed seed; each figure is the median of BENCH_RUNS timed runs.
+ */
+
+#define BENCH_RUNS 5
+#define BENCH_MIN_NS 20000000ull   // Each timed run lasts at least 20 ms
+#define BENCH_VALUE "value123"
+
+// Allocation counting, available when linked with --wrap (see CMakeLists.txt)
+static size_t allocation_count = 0;
+
+#ifdef SIMPLET_BENCH_COUNT_ALLOCATIONS
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocation_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocation_count++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size) {
+    allocation_count++;
+    return __real_realloc(pointer, size);
+}
+#endif
+
+typedef struct {
+    double ns_per_op;
+    double allocations_per_op;
+} bench_result_t;
+
+// Time and allocations of the measured sections of a run
+typedef struct {
+    uint64_t started;
+    size_t allocations_at_start;
+    uint64_t elapsed_ns;
+    size_t allocations;
+} bench_timer_t;
+
+typedef void (*bench_fn)(void *context, size_t iterations, bench_timer_t *timer);
+
+static FILE *results = NULL;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void timer_start(bench_timer_t *timer) {
+    timer->allocations_at_start = allocation_count;
+    timer->started = now_ns();
+}
+
+static void timer_stop(bench_timer_t *timer) {
+    timer->elapsed_ns += now_ns() - timer->started;
+    timer->allocations += allocation_count - timer->allocations_at_start;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Times fn, doubling the iteration count until a run is long enough
+ * Only the sections fn brackets with timer_start/timer_stop are counted.
+ * Returns: median ns per operation and allocations per operation
+ */
+static bench_result_t run_benchmark(bench_fn fn, void *context, size_t ops_per_iteration) {
+    size_t iterations = 1;
+    for (;;) {
+        bench_timer_t timer = { 0 };
+        fn(context, iterations, &timer);
+        if (timer.elapsed_ns >= BENCH_MIN_NS / 4 || iterations >= ((size_t)1 << 30)) break;
+        iterations *= 2;
+    }
+    iterations *= 4;
+
+    double samples[BENCH_RUNS];
+    size_t allocations = 0;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        bench_timer_t timer = { 0 };
+        fn(context, iterations, &timer);
+        samples[run] = (double)timer.elapsed_ns / (double)(iterations * ops_per_iteration);
+        allocations = timer.allocations;
+    }
+
+    qsort(samples, BENCH_RUNS, sizeof(double), compare_doubles);
+
+    bench_result_t result;
+    result.ns_per_op = samples[BENCH_RUNS / 2];
+#ifdef SIMPLET_BENCH_COUNT_ALLOCATIONS
+    result.allocations_per_op = (double)allocations / (double)(iterations * ops_per_iteration);
+#else
+    (void)allocations;
+    result.allocations_per_op = -1.0;
+#endif
+    return result;
+}
+
+/* Writes a result line to stdout and, if open, the JSON Lines file
+ * params is a preformatted list of "key":value pairs; bytes_per_op is the
+ * output produced per operation (0 when throughput does not apply).
+ */
+static void report(const char *name, const char *params, const char *label, bench_result_t result, double bytes_per_op) {
+    double bytes_per_second = bytes_per_op > 0 ? bytes_per_op * 1e9 / result.ns_per_op : 0;
+
+    printf("%-18s %-36s %10.1f ns/op", name, label, result.ns_per_op);
+    if (bytes_per_op > 0) printf(" %10.1f MB/s", bytes_per_second / 1e6);
+    else printf(" %15s", "");
+    printf(" %8.2f allocs/op\n", result.allocations_per_op);
+
+    if (results) {
+        fprintf(results, "{\"benchmark\":\"%s\",%s,\"backend\":\"%s\",\"scan\":\"%s\","
+                         "\"ns_per_op\":%.3f,\"bytes_per_second\":%.0f,\"allocations_per_op\":%.3f}\n",
+                name, params, SIMPLET_DICTIONARY_BACKEND, SIMPLET_SCAN_IMPL,
+                result.ns_per_op, bytes_per_second, result.allocations_per_op);
+    }
+}
+
+// Renderer benchmarks
+
+typedef struct {
+    char *html;
+    simplet_template_t *compiled;
+    simplet_dictionary_t *dictionary;
+} render_context_t;
+
+static void format_key(char *key, size_t key_length, size_t index) {
+    int written = snprintf(key, key_length + 1, "k%zu", index);
+    for (size_t i = (size_t)written; i < key_length; i++) key[i] = '_';
+    key[key_length] = '\0';
+}
+
+/* Builds a template of exactly size bytes with a placeholder every spacing bytes
+ * Every key is set in dictionary. spacing 0 means literal text only.
+ */
+static char* build_template(size_t size, size_t spacing, size_t key_length, simplet_dictionary_t *dictionary) {
+    static const char filler[] = "<div class=\"row\"><span>Lorem ipsum dolor sit amet</span></div>\n";
+    char *html = malloc(size + 1);
+    size_t length = 0;
+    size_t index = 0;
+    size_t placeholder_length = key_length + 4;   // Key plus "{{" and "}}"
+
+    while (length < size) {
+        if (spacing && length % spacing == 0 && length + placeholder_length <= size) {
+            char key[MAX_KEY_SIZE];
+            format_key(key, key_length, index++ % 64);
+            simplet_dictionary_set(dictionary, key, BENCH_VALUE);
+            length += (size_t)sprintf(html + length, "{{%s}}", key);
+            continue;
+        }
+        html[length] = filler[length % (sizeof(filler) - 1)];
+        length++;
+    }
+    html[length] = '\0';
+    return html;
+}
+
+static void bench_render_html(void *context, size_t iterations, bench_timer_t *timer) {
+    render_context_t *render = context;
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        free(simplet_render_html(render->html, render->dictionary));
+    }
+    timer_stop(timer);
+}
+
+static void bench_template_render(void *context, size_t iterations, bench_timer_t *timer) {
+    render_context_t *render = context;
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        free(simplet_template_render(render->compiled, render->dictionary));
+    }
+    timer_stop(timer);
+}
+
+static void run_render_benchmarks(void) {
+    static const size_t sizes[] = { 256, 1024, 4096, 8192 };
+    static const size_t spacings[] = { 0, 256, 32 };
+    static const size_t key_lengths[] = { 4, 32 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (size_t d = 0; d < sizeof(spacings) / sizeof(spacings[0]); d++) {
+            for (size_t k = 0; k < sizeof(key_lengths) / sizeof(key_lengths[0]); k++) {
+                // Key length is irrelevant without placeholders
+                if (spacings[d] == 0 && k > 0) continue;
+
+                render_context_t render;
+                render.dictionary = create_simplet_dictionary(SIZE_SMALL, true);
+                render.html = build_template(sizes[s], spacings[d], key_lengths[k], render.dictionary);
+                render.compiled = compile_simplet_template(render.html);
+
+                char *page = simplet_render_html(render.html, render.dictionary);
+                double output_bytes = (double)strlen(page);
+                free(page);
+
+                char params[128];
+                char label[64];
+                snprintf(params, sizeof(params), "\"template_size\":%zu,\"placeholder_spacing\":%zu,\"key_length\":%zu",
+                         sizes[s], spacings[d], key_lengths[k]);
+                snprintf(label, sizeof(label), "size=%zu spacing=%zu key=%zu", sizes[s], spacings[d], key_lengths[k]);
+
+                report("render_html", params, label, run_benchmark(bench_render_html, &render, 1), output_bytes);
+                report("template_render", params, label, run_benchmark(bench_template_render, &render, 1), output_bytes);
+
+                destroy_simplet_template(render.compiled);
+                destroy_simplet_dictionary(render.dictionary);
+                free(render.html);
+            }
+        }
+    }
+}
+
+// Escaping filter benchmarks
+
+typedef struct {
+    simplet_filter_t filter;
+    const char *value;
+    size_t length;
+    char *output;
+} escape_context_t;
+
+static void bench_escape(void *context, size_t iterations, bench_timer_t *timer) {
+    escape_context_t *escape = context;
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        simplet_escape(escape->filter, escape->value, escape->length, escape->output);
+    }
+    timer_stop(timer);
+}
+
+static void run_escape_benchmarks(void) {
+    static const simplet_filter_t filters[] = { SIMPLET_FILTER_HTML, SIMPLET_FILTER_URL, SIMPLET_FILTER_JSON };
+    static const char *filter_names[] = { "html", "url", "json" };
+    static const size_t lengths[] = { 64, 1024 };
+    static const size_t densities[] = { 0, 32 };   // One special byte every n bytes, 0 for none
+
+    for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            for (size_t d = 0; d < sizeof(densities) / sizeof(densities[0]); d++) {
+                char *value = malloc(lengths[l]);
+                for (size_t i = 0; i < lengths[l]; i++) {
+                    value[i] = densities[d] && i % densities[d] == densities[d] - 1 ? '"' : (char)('a' + i % 26);
+                }
+
+                escape_context_t escape = { filters[f], value, lengths[l], NULL };
+                escape.output = malloc(lengths[l] * SIMPLET_FILTER_MAX_EXPANSION);
+
+                char params[128];
+                char label[64];
+                snprintf(params, sizeof(params), "\"filter\":\"%s\",\"value_length\":%zu,\"special_spacing\":%zu",
+                         filter_names[f], lengths[l], densities[d]);
+                snprintf(label, sizeof(label), "filter=%s length=%zu special=%zu", filter_names[f], lengths[l], densities[d]);
+
+                report("escape", params, label, run_benchmark(bench_escape, &escape, 1), (double)lengths[l]);
+
+                free(escape.output);
+                free(value);
+            }
+        }
+    }
+}
+
+// Per-request setup: copying global values into each request dictionary vs layering over them
+
+#define REQUEST_GLOBALS 40
+#define REQUEST_LOCALS 4
+
+typedef struct {
+    simplet_dictionary_t *global;
+    simplet_template_t *compiled;
+    bool layered;
+} request_context_t;
+
+static void bench_request(void *context, size_t iterations, bench_timer_t *timer) {
+    request_context_t *request = context;
+    char key[24];
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_TINY, true);
+        if (request->layered) {
+            simplet_dictionary_set_parent(dict, request->global);
+        } else {
+            for (size_t g = 0; g < REQUEST_GLOBALS; g++) {
+                snprintf(key, sizeof(key), "global_%zu", g);
+                simplet_dictionary_set(dict, key, simplet_dictionary_get(request->global, key));
+            }
+        }
+        for (size_t l = 0; l < REQUEST_LOCALS; l++) {
+            snprintf(key, sizeof(key), "local_%zu", l);
+            simplet_dictionary_set(dict, key, BENCH_VALUE);
+        }
+
+        free(simplet_template_render(request->compiled, dict));
+        destroy_simplet_dictionary(dict);
+    }
+    timer_stop(timer);
+}
+
+static void run_request_benchmarks(void) {
+    request_context_t request;
+    request.global = create_simplet_dictionary(SIZE_SMALL, true);
+    char key[24];
+    for (size_t g = 0; g < REQUEST_GLOBALS; g++) {
+        snprintf(key, sizeof(key), "global_%zu", g);
+        simplet_dictionary_set(request.global, key, BENCH_VALUE);
+    }
+    request.compiled = compile_simplet_template("<h1>{{global_0}}</h1><p>{{global_1}} {{global_2}} {{global_3}}</p>"
+                                                "<p>{{local_0}} {{local_1}} {{local_2}} {{local_3}}</p>");
+
+    for (int layered = 0; layered <= 1; layered++) {
+        request.layered = layered;
+        char params[128];
+        char label[64];
+        snprintf(params, sizeof(params), "\"globals\":%d,\"locals\":%d,\"layered\":%s", REQUEST_GLOBALS,
+                 REQUEST_LOCALS, layered ? "true" : "false");
+        snprintf(label, sizeof(label), "%s globals=%d locals=%d", layered ? "layered" : "copied", REQUEST_GLOBALS,
+                 REQUEST_LOCALS);
+        report("request_setup", params, label, run_benchmark(bench_request, &request, 1), 0);
+    }
+
+    destroy_simplet_template(request.compiled);
+    destroy_simplet_dictionary(request.global);
+}
+
+// Status values: formatted into the dictionary before every render vs providers run by the renderer
+
+#define STATUS_VALUES 8
+#define STATUS_USED 3
+
+typedef struct {
+    simplet_template_t *compiled;
+    bool provided;
+} status_context_t;
+
+static void write_status_value(void *context, simplet_value_writer_t *writer) {
+    simplet_value_printf(writer, "%lu", (unsigned long)(uintptr_t)context);
+}
+
+static void bench_status(void *context, size_t iterations, bench_timer_t *timer) {
+    status_context_t *status = context;
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    char key[24];
+    char value[24];
+
+    if (status->provided) {
+        for (size_t v = 0; v < STATUS_VALUES; v++) {
+            snprintf(key, sizeof(key), "status_%zu", v);
+            simplet_dictionary_set_provider(dict, key, write_status_value, (void *)(uintptr_t)(v * 1000 + 7));
+        }
+    }
+
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        if (!status->provided) {
+            for (size_t v = 0; v < STATUS_VALUES; v++) {
+                snprintf(key, sizeof(key), "status_%zu", v);
+                snprintf(value, sizeof(value), "%lu", (unsigned long)(v * 1000 + 7));
+                simplet_dictionary_set(dict, key, value);
+            }
+        }
+        free(simplet_template_render(status->compiled, dict));
+    }
+    timer_stop(timer);
+
+    destroy_simplet_dictionary(dict);
+}
+
+static void run_status_benchmarks(void) {
+    status_context_t status;
+    status.compiled = compile_simplet_template("<p>Uptime {{status_0}}s</p><p>Heap {{status_1}}</p>"
+                                               "<p>RSSI {{status_2}}</p>");
+
+    for (int provided = 0; provided <= 1; provided++) {
+        status.provided = provided;
+        char params[128];
+        char label[64];
+        snprintf(params, sizeof(params), "\"values\":%d,\"used\":%d,\"provided\":%s", STATUS_VALUES, STATUS_USED,
+                 provided ? "true" : "false");
+        snprintf(label, sizeof(label), "%s values=%d used=%d", provided ? "provided" : "formatted", STATUS_VALUES,
+                 STATUS_USED);
+        report("status_values", params, label, run_benchmark(bench_status, &status, 1), 0);
+    }
+
+    destroy_simplet_template(status.compiled);
+}
+
+// Numeric readings: snprintf into the dictionary vs typed values formatted by the renderer
+
+#define NUMERIC_VALUES 8
+
+typedef struct {
+    simplet_template_t *compiled;
+    bool typed;
+} numeric_context_t;
+
+static void bench_numeric(void *context, size_t iterations, bench_timer_t *timer) {
+    numeric_context_t *numeric = context;
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    char keys[NUMERIC_VALUES][24];
+    char value[24];
+    for (size_t v = 0; v < NUMERIC_VALUES; v++) {
+        snprintf(keys[v], sizeof(keys[v]), "reading_%zu", v);
+    }
+
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        // Readings change on every render, as on a live status page
+        for (size_t v = 0; v < NUMERIC_VALUES; v++) {
+            int64_t reading = (int64_t)(i * 7919 + v * 104729);
+            if (numeric->typed) {
+                simplet_dictionary_set_int(dict, keys[v], reading);
+            } else {
+                snprintf(value, sizeof(value), "%lld", (long long)reading);
+                simplet_dictionary_set(dict, keys[v], value);
+            }
+        }
+        free(simplet_template_render(numeric->compiled, dict));
+    }
+    timer_stop(timer);
+
+    destroy_simplet_dictionary(dict);
+}
+
+static void run_numeric_benchmarks(void) {
+    numeric_context_t numeric;
+    numeric.compiled = compile_simplet_template("<td>{{reading_0}}</td><td>{{reading_1}}</td><td>{{reading_2}}</td>"
+                                                "<td>{{reading_3}}</td><td>{{reading_4}}</td><td>{{reading_5}}</td>"
+                                                "<td>{{reading_6}}</td><td>{{reading_7}}</td>");
+
+    for (int typed = 0; typed <= 1; typed++) {
+        numeric.typed = typed;
+        char params[64];
+        char label[64];
+        snprintf(params, sizeof(params), "\"values\":%d,\"typed\":%s", NUMERIC_VALUES, typed ? "true" : "false");
+        snprintf(label, sizeof(label), "%s values=%d", typed ? "typed" : "snprintf", NUMERIC_VALUES);
+        report("numeric_values", params, label, run_benchmark(bench_numeric, &numeric, 1), 0);
+    }
+
+    destroy_simplet_template(numeric.compiled);
+}
+
+// Batch export: one render and append per row vs one batch, serial and split across workers
+
+#define BATCH_ROWS 1000
+
+typedef struct {
+    simplet_template_t *compiled;
+    simplet_dictionary_t *rows[BATCH_ROWS];
+    size_t workers;     // 0 renders and appends row by row
+} batch_context_t;
+
+static void bench_batch(void *context, size_t iterations, bench_timer_t *timer) {
+    batch_context_t *batch = context;
+    const simplet_dictionary_t *const *rows = (const simplet_dictionary_t *const *)batch->rows;
+
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        char *output = NULL;
+        if (batch->workers == 0) {
+            size_t length = 0;
+            for (size_t row = 0; row < BATCH_ROWS; row++) {
+                char *rendered = simplet_template_render(batch->compiled, rows[row]);
+                size_t rendered_length = strlen(rendered);
+                output = realloc(output, length + rendered_length + 1);
+                memcpy(output + length, rendered, rendered_length + 1);
+                length += rendered_length;
+                free(rendered);
+            }
+        } else {
+            simplet_render_batch(batch->compiled, rows, BATCH_ROWS, batch->workers, &output, NULL);
+        }
+        free(output);
+    }
+    timer_stop(timer);
+}
+
+static void run_batch_benchmarks(void) {
+    static batch_context_t batch;
+    batch.compiled = compile_simplet_template("<tr><td>{{id}}</td><td>{{ name | html }}</td><td>{{email}}</td>"
+                                              "<td>{{ balance | %.2f }}</td><td>{{?active}}yes{{/active}}</td></tr>\n");
+
+    char text[48];
+    for (size_t row = 0; row < BATCH_ROWS; row++) {
+        batch.rows[row] = create_simplet_dictionary(SIZE_SMALL, true);
+        simplet_dictionary_set_uint(batch.rows[row], "id", row);
+        snprintf(text, sizeof(text), "Customer %zu", row);
+        simplet_dictionary_set(batch.rows[row], "name", text);
+        snprintf(text, sizeof(text), "customer%zu@example.com", row);
+        simplet_dictionary_set(batch.rows[row], "email", text);
+        simplet_dictionary_set_float(batch.rows[row], "balance", (double)row * 3.25);
+        simplet_dictionary_set_bool(batch.rows[row], "active", row % 3 != 0);
+    }
+
+    size_t workers[] = {0, 1, 4};
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        batch.workers = workers[i];
+        char params[64];
+        char label[64];
+        snprintf(params, sizeof(params), "\"rows\":%d,\"workers\":%zu", BATCH_ROWS, workers[i]);
+        if (workers[i] == 0) {
+            snprintf(label, sizeof(label), "per-row rows=%d", BATCH_ROWS);
+        } else {
+            snprintf(label, sizeof(label), "batch rows=%d workers=%zu", BATCH_ROWS, workers[i]);
+        }
+        report("batch_rows", params, label, run_benchmark(bench_batch, &batch, BATCH_ROWS), 0);
+    }
+
+    for (size_t row = 0; row < BATCH_ROWS; row++) destroy_simplet_dictionary(batch.rows[row]);
+    destroy_simplet_template(batch.compiled);
+}
+
+// Large pages: one thread vs segments rendered on several workers
+
+#define PARALLEL_PAGE_SIZE 65536
+
+static void run_parallel_benchmarks(void) {
+    render_context_t render;
+    render.dictionary = create_simplet_dictionary(SIZE_SMALL, true);
+    render.html = build_template(PARALLEL_PAGE_SIZE, 32, 8, render.dictionary);
+    render.compiled = compile_simplet_template_n(render.html, PARALLEL_PAGE_SIZE);
+
+    size_t workers[] = {1, 2, 4};
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        simplet_set_parallel_render(workers[i], 0);
+
+        char *page = simplet_template_render(render.compiled, render.dictionary);
+        double output_bytes = (double)strlen(page);
+        free(page);
+
+        char params[64];
+        char label[64];
+        snprintf(params, sizeof(params), "\"template_size\":%d,\"workers\":%zu", PARALLEL_PAGE_SIZE, workers[i]);
+        snprintf(label, sizeof(label), "size=%d workers=%zu", PARALLEL_PAGE_SIZE, workers[i]);
+        report("parallel_render", params, label, run_benchmark(bench_template_render, &render, 1), output_bytes);
+    }
+    simplet_set_parallel_render(0, 0);
+
+    destroy_simplet_template(render.compiled);
+    destroy_simplet_dictionary(render.dictionary);
+    free(render.html);
+}
+
+// Boot-time configuration: one set per key vs loading a saved blob
+
+#define CONFIG_KEYS 300
+
+typedef struct {
+    char keys[CONFIG_KEYS][24];
+    char values[CONFIG_KEYS][24];
+    char *blob;
+    size_t blob_size;
+    int mode;           // 0 sets every key, 1 loads a copy, 2 loads borrowing the blob
+} config_context_t;
+
+static void bench_config(void *context, size_t iterations, bench_timer_t *timer) {
+    config_context_t *config = context;
+
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        simplet_dictionary_t *dict;
+        if (config->mode == 0) {
+            dict = create_simplet_dictionary(SIZE_TINY, true);
+            for (size_t k = 0; k < CONFIG_KEYS; k++) {
+                simplet_dictionary_set(dict, config->keys[k], config->values[k]);
+            }
+        } else {
+            dict = simplet_dictionary_load(config->blob, config->blob_size, config->mode == 2);
+        }
+        destroy_simplet_dictionary(dict);
+    }
+    timer_stop(timer);
+}
+
+static void run_config_benchmarks(void) {
+    static config_context_t config;
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_TINY, true);
+    for (size_t k = 0; k < CONFIG_KEYS; k++) {
+        snprintf(config.keys[k], sizeof(config.keys[k]), "config.option_%zu", k);
+        snprintf(config.values[k], sizeof(config.values[k]), "value-%zu", k * 7919);
+        simplet_dictionary_set(dict, config.keys[k], config.values[k]);
+    }
+
+    simplet_dictionary_save(dict, NULL, 0, &config.blob_size);
+    config.blob = malloc(config.blob_size);
+    simplet_dictionary_save(dict, config.blob, config.blob_size, NULL);
+    destroy_simplet_dictionary(dict);
+
+    static const char *const modes[] = { "set", "load", "load_borrowed" };
+    for (int mode = 0; mode < 3; mode++) {
+        config.mode = mode;
+        char params[64];
+        char label[64];
+        snprintf(params, sizeof(params), "\"keys\":%d,\"mode\":\"%s\"", CONFIG_KEYS, modes[mode]);
+        snprintf(label, sizeof(label), "%s keys=%d", modes[mode], CONFIG_KEYS);
+        report("config_boot", params, label, run_benchmark(bench_config, &config, 1), 0);
+    }
+
+    free(config.blob);
+}
+
+// Dictionary benchmarks
+
+typedef struct {
+    simplet_dictionary_size_t preset;
+    bool auto_resize;
+    size_t key_count;
+    char (*keys)[24];
+    simplet_dictionary_t *dictionary;
+} dictionary_context_t;
+
+static void fill_dictionary(simplet_dictionary_t *dict, const dictionary_context_t *bench) {
+    for (size_t k = 0; k < bench->key_count; k++) {
+        simplet_dictionary_set(dict, bench->keys[k], BENCH_VALUE);
+    }
+}
+
+/* Inserts every key into a fresh dictionary (creation and destruction not timed) */
+static void bench_dictionary_set(void *context, size_t iterations, bench_timer_t *timer) {
+    dictionary_context_t *bench = context;
+    for (size_t i = 0; i < iterations; i++) {
+        simplet_dictionary_t *dict = create_simplet_dictionary(bench->preset, bench->auto_resize);
+        timer_start(timer);
+        fill_dictionary(dict, bench);
+        timer_stop(timer);
+        destroy_simplet_dictionary(dict);
+    }
+}
+
+static void bench_dictionary_get(void *context, size_t iterations, bench_timer_t *timer) {
+    dictionary_context_t *bench = context;
+    size_t found = 0;
+    timer_start(timer);
+    for (size_t i = 0; i < iterations; i++) {
+        for (size_t k = 0; k < bench->key_count; k++) {
+            found += simplet_dictionary_get(bench->dictionary, bench->keys[k]) != NULL;
+        }
+    }
+    timer_stop(timer);
+    if (found != iterations * bench->key_count) abort();
+}
+
+/* Removes every key from a filled dictionary (filling not timed) */
+static void bench_dictionary_remove(void *context, size_t iterations, bench_timer_t *timer) {
+    dictionary_context_t *bench = context;
+    for (size_t i = 0; i < iterations; i++) {
+        simplet_dictionary_t *dict = create_simplet_dictionary(bench->preset, bench->auto_resize);
+        fill_dictionary(dict, bench);
+        timer_start(timer);
+        for (size_t k = 0; k < bench->key_count; k++) {
+            simplet_dictionary_remove(dict, bench->keys[k]);
+        }
+        timer_stop(timer);
+        destroy_simplet_dictionary(dict);
+    }
+}
+
+static void run_dictionary_benchmarks(void) {
+    static const simplet_dictionary_size_t presets[] = { SIZE_TINY, SIZE_SMALL, SIZE_MEDIUM, SIZE_LARGE, SIZE_HUGE };
+    static const char *preset_names[] = { "tiny", "small", "medium", "large", "huge" };
+
+    for (size_t p = 0; p < sizeof(presets) / sizeof(presets[0]); p++) {
+        for (int resize = 0; resize <= 1; resize++) {
+            dictionary_context_t bench;
+            bench.preset = presets[p];
+            bench.auto_resize = resize;
+            bench.key_count = (size_t)presets[p];   // Fills the preset to a load factor of about 1
+            bench.keys = malloc(bench.key_count * sizeof(*bench.keys));
+            for (size_t k = 0; k < bench.key_count; k++) {
+                snprintf(bench.keys[k], sizeof(bench.keys[k]), "key_%zu", k * 7919);
+            }
+
+            bench.dictionary = create_simplet_dictionary(bench.preset, bench.auto_resize);
+            fill_dictionary(bench.dictionary, &bench);
+
+            char params[128];
+            char label[64];
+            snprintf(params, sizeof(params), "\"preset\":\"%s\",\"auto_resize\":%s,\"keys\":%zu",
+                     preset_names[p], resize ? "true" : "false", bench.key_count);
+            snprintf(label, sizeof(label), "%s auto_resize=%d keys=%zu", preset_names[p], resize, bench.key_count);
+
+            report("dictionary_set", params, label, run_benchmark(bench_dictionary_set, &bench, bench.key_count), 0);
+            report("dictionary_get", params, label, run_benchmark(bench_dictionary_get, &bench, bench.key_count), 0);
+            report("dictionary_remove", params, label,
+                   run_benchmark(bench_dictionary_remove, &bench, bench.key_count), 0);
+
+            destroy_simplet_dictionary(bench.dictionary);
+            free(bench.keys);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        results = fopen(argv[1], "w");
+        if (!results) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    printf("simplet benchmarks (backend %s, scan %s)\n\n", SIMPLET_DICTIONARY_BACKEND, SIMPLET_SCAN_IMPL);
+
+    run_render_benchmarks();
+    printf("\n");
+    run_escape_benchmarks();
+    printf("\n");
+    run_request_benchmarks();
+    printf("\n");
+    run_status_benchmarks();
+    printf("\n");
+    run_numeric_benchmarks();
+    printf("\n");
+    run_batch_benchmarks();
+    printf("\n");
+    run_parallel_benchmarks();
+    printf("\n");
+    run_config_benchmarks();
+    printf("\n");
+    run_dictionary_benchmarks();
+
+    if (results) fclose(results);
+    return 0;
+}
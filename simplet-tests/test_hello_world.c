@@ -8,6 +8,7 @@
 
 #include "simplet.h"
 #include "simplet_dictionary.h"
+#include "test_support.h"
 
 TEST_CASE(simplet_renders_hello_world_template, "[simplet]") {
     const char* template_html = "<div><p>{{ hello-world }}</p></div>";
@@ -110,3 +111,164 @@ TEST_CASE(simplet_handles_empty_string_value, "[simplet]") {
     destroy_simplet_dictionary(dict);
     free(rendered_html);
 }
+
+TEST_CASE(simplet_renders_html_to_sink, "[simplet]") {
+    const char* template_html = "<h1>{{ title }}</h1><p>{{ missing }}</p>";
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "title", "Test Title") == SUCCESS);
+
+    char output[128] = "";
+    assert(simplet_render_html_to_sink(template_html, dict, append_sink, output) == SUCCESS);
+    assert(strcmp("<h1>Test Title</h1><p></p>", output) == 0);
+
+    assert(simplet_render_html_to_sink(NULL, dict, append_sink, output) == ERROR_NULL_PARAM);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_sizes_output_for_repeated_keys, "[simplet]") {
+    const char* template_html = "{{v}}{{v}}{{v}}{{v}}";
+
+    char value[201];
+    memset(value, 'x', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "v", value) == SUCCESS);
+
+    char* rendered_html = simplet_render_html(template_html, dict);
+    assert(rendered_html != NULL);
+    ASSERT_NULL_TERMINATED(rendered_html);
+    assert(strlen(rendered_html) == 4 * strlen(value));
+
+    destroy_simplet_dictionary(dict);
+    free(rendered_html);
+}
+
+/* Byte-at-a-time reference renderer following the original scanning rules */
+static void reference_render(const char* template_html, const char* key, const char* value, char* output) {
+    size_t length = strlen(template_html);
+    size_t position = 0;
+    size_t output_length = 0;
+
+    while (position < length) {
+        if (position + 2 <= length && memcmp(template_html + position, "{{", 2) == 0) {
+            size_t key_start = position + 2;
+            while (key_start < length && (template_html[key_start] == ' ' || template_html[key_start] == '\t')) key_start++;
+
+            size_t key_end = 0;
+            for (size_t i = key_start; i + 1 < length; i++) {
+                if (memcmp(template_html + i, "}}", 2) == 0) { key_end = i; break; }
+            }
+
+            if (key_end > 0) {
+                size_t trimmed = key_end;
+                while (trimmed > key_start && (template_html[trimmed - 1] == ' ' || template_html[trimmed - 1] == '\t')) trimmed--;
+                if (trimmed > key_start) {
+                    if (trimmed - key_start == strlen(key) && memcmp(template_html + key_start, key, trimmed - key_start) == 0) {
+                        strcpy(output + output_length, value);
+                        output_length += strlen(value);
+                    }
+                    position = key_end + 2;
+                    continue;
+                }
+            }
+        }
+        output[output_length++] = template_html[position++];
+    }
+    output[output_length] = '\0';
+}
+
+TEST_CASE(simplet_scans_delimiters_at_every_offset, "[simplet]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "k", "V") == SUCCESS);
+
+    char template_html[128];
+    char expected[256];
+
+    // Placeholder at every alignment across word and vector boundaries
+    for (size_t offset = 0; offset < 48; offset++) {
+        memset(template_html, 'x', offset);
+        strcpy(template_html + offset, "{{ k }}tail{");
+        reference_render(template_html, "k", "V", expected);
+
+        char* rendered_html = simplet_render_html(template_html, dict);
+        assert(strcmp(expected, rendered_html) == 0);
+        free(rendered_html);
+    }
+
+    // Pseudo-random templates dense in braces
+    const char alphabet[] = "{}{} k\tx";
+    uint32_t seed = 12345;
+    for (int round = 0; round < 2000; round++) {
+        size_t length = (size_t)(round % 96);
+        for (size_t i = 0; i < length; i++) {
+            seed = seed * 1103515245u + 12345u;
+            template_html[i] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+        }
+        template_html[length] = '\0';
+        reference_render(template_html, "k", "V", expected);
+
+        char* rendered_html = simplet_render_html(template_html, dict);
+        assert(strcmp(expected, rendered_html) == 0);
+        free(rendered_html);
+    }
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_skips_keys_longer_than_dictionary_limit, "[simplet]") {
+    char template_html[MAX_KEY_SIZE + 32];
+    char key[MAX_KEY_SIZE + 8];
+    memset(key, 'k', sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    snprintf(template_html, sizeof(template_html), "<p>{{ %s }}</p>", key);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, key, "value") == ERROR_KEY_TOO_LONG);
+
+    char* rendered_html = simplet_render_html(template_html, dict);
+    assert(rendered_html != NULL);
+    assert(strcmp("<p></p>", rendered_html) == 0);
+
+    destroy_simplet_dictionary(dict);
+    free(rendered_html);
+}
+
+TEST_CASE(simplet_renders_templates_by_pointer_and_length, "[simplet]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(simplet_dictionary_set(dict, "name", "World") == SUCCESS);
+
+    // Only the first length bytes count, with no terminator needed
+    const char buffer[] = { 'H', 'i', ' ', '{', '{', 'n', 'a', 'm', 'e', '}', '}', '!', '{', '{' };
+    char* rendered_html = simplet_render_html_n(buffer, 12, dict);
+    assert(strcmp("Hi World!", rendered_html) == 0);
+    free(rendered_html);
+
+    rendered_html = simplet_render_html_n(buffer, 0, dict);
+    assert(strcmp("", rendered_html) == 0);
+    free(rendered_html);
+
+    // Larger than the 8 KB string limit is fine when the length is given
+    size_t length = 3 * 8192;
+    char* large = malloc(length);
+    memset(large, '.', length);
+    memcpy(large + length - 8, "{{name}}", 8);
+    rendered_html = simplet_render_html_n(large, length, dict);
+    assert(strlen(rendered_html) == length - 8 + 5);
+    assert(strcmp(rendered_html + length - 8, "World") == 0);
+    free(rendered_html);
+
+    char output[64] = "";
+    assert(simplet_render_html_n_to_sink(buffer, 12, dict, append_sink, output) == SUCCESS);
+    assert(strcmp("Hi World!", output) == 0);
+    assert(simplet_render_html_n_to_sink(NULL, 1, dict, append_sink, output) == ERROR_NULL_PARAM);
+
+    free(large);
+    destroy_simplet_dictionary(dict);
+}
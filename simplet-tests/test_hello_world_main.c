@@ -7,6 +7,11 @@ void test_simplet_handles_missing_placeholder_gracefully(void);
 void test_simplet_handles_empty_template(void);
 void test_simplet_handles_NULL_dictionary(void);
 void test_simplet_handles_empty_string_value(void);
+void test_simplet_renders_html_to_sink(void);
+void test_simplet_sizes_output_for_repeated_keys(void);
+void test_simplet_scans_delimiters_at_every_offset(void);
+void test_simplet_skips_keys_longer_than_dictionary_limit(void);
+void test_simplet_renders_templates_by_pointer_and_length(void);
 
 int main(void) {
     printf("Running simplet tests...\n");
@@ -29,6 +34,21 @@ int main(void) {
     test_simplet_handles_empty_string_value();
     printf("✓ test_simplet_handles_empty_string_value\n");
 
+    test_simplet_renders_html_to_sink();
+    printf("✓ test_simplet_renders_html_to_sink\n");
+
+    test_simplet_sizes_output_for_repeated_keys();
+    printf("✓ test_simplet_sizes_output_for_repeated_keys\n");
+
+    test_simplet_scans_delimiters_at_every_offset();
+    printf("✓ test_simplet_scans_delimiters_at_every_offset\n");
+
+    test_simplet_skips_keys_longer_than_dictionary_limit();
+    printf("✓ test_simplet_skips_keys_longer_than_dictionary_limit\n");
+
+    test_simplet_renders_templates_by_pointer_and_length();
+    printf("✓ test_simplet_renders_templates_by_pointer_and_length\n");
+
     printf("\nAll tests passed!\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+
+#define ROWS 100
+
+static const char *ROW_TEMPLATE =
+    "<tr><td>{{id}}</td><td>{{ name | html }}</td>{{?admin}}<td>admin</td>{{/admin}}<td>{{ score | %.1f }}</td></tr>\n";
+
+static simplet_dictionary_t *rows[ROWS];
+
+static void create_rows(void) {
+    char name[32];
+    for (int i = 0; i < ROWS; i++) {
+        rows[i] = create_simplet_dictionary(SIZE_SMALL, true);
+        snprintf(name, sizeof(name), "user <%d>", i);
+        assert(simplet_dictionary_set_int(rows[i], "id", i) == SUCCESS);
+        assert(simplet_dictionary_set(rows[i], "name", name) == SUCCESS);
+        assert(simplet_dictionary_set_bool(rows[i], "admin", i % 7 == 0) == SUCCESS);
+        assert(simplet_dictionary_set_float(rows[i], "score", i * 1.5) == SUCCESS);
+    }
+}
+
+static void destroy_rows(void) {
+    for (int i = 0; i < ROWS; i++) destroy_simplet_dictionary(rows[i]);
+}
+
+// The concatenation of one render per dictionary
+static char* render_each(const simplet_template_t *compiled, const simplet_dictionary_t *const *dicts, size_t count) {
+    size_t length = 0;
+    char *joined = calloc(1, 1);
+    for (size_t i = 0; i < count; i++) {
+        char *row = simplet_template_render(compiled, dicts[i]);
+        joined = realloc(joined, length + strlen(row) + 1);
+        memcpy(joined + length, row, strlen(row) + 1);
+        length += strlen(row);
+        free(row);
+    }
+    return joined;
+}
+
+static int append_sink(void *context, const char *data, size_t length) {
+    char **out = context;
+    size_t used = strlen(*out);
+    *out = realloc(*out, used + length + 1);
+    memcpy(*out + used, data, length);
+    (*out)[used + length] = '\0';
+    return 0;
+}
+
+static int failing_sink(void *context, const char *data, size_t length) {
+    (void)data;
+    (void)length;
+    int *calls = context;
+    (*calls)++;
+    return -1;
+}
+
+TEST_CASE(simplet_batch_matches_single_renders, "[simplet_batch]") {
+    create_rows();
+    simplet_template_t *compiled = compile_simplet_template(ROW_TEMPLATE);
+    const simplet_dictionary_t *const *dicts = (const simplet_dictionary_t *const *)rows;
+
+    char *expected = render_each(compiled, dicts, ROWS);
+    char *output = NULL;
+    size_t length = 0;
+    assert(simplet_render_batch(compiled, dicts, ROWS, 1, &output, &length) == SUCCESS);
+    assert(length == strlen(expected));
+    assert(strcmp(output, expected) == 0);
+    assert(strstr(output, "<tr><td>7</td><td>user &lt;7&gt;</td><td>admin</td><td>10.5</td></tr>\n") != NULL);
+    free(output);
+    free(expected);
+
+    // NULL dictionaries render the template without values
+    const simplet_dictionary_t *sparse[3] = {rows[1], NULL, rows[2]};
+    assert(simplet_render_batch(compiled, sparse, 3, 0, &output, NULL) == SUCCESS);
+    assert(strcmp(output,
+                  "<tr><td>1</td><td>user &lt;1&gt;</td><td>1.5</td></tr>\n"
+                  "<tr><td></td><td></td><td></td></tr>\n"
+                  "<tr><td>2</td><td>user &lt;2&gt;</td><td>3.0</td></tr>\n") == 0);
+    free(output);
+
+    destroy_simplet_template(compiled);
+    destroy_rows();
+}
+
+TEST_CASE(simplet_batch_workers, "[simplet_batch]") {
+    create_rows();
+    simplet_template_t *compiled = compile_simplet_template(ROW_TEMPLATE);
+    const simplet_dictionary_t *const *dicts = (const simplet_dictionary_t *const *)rows;
+    char *expected = render_each(compiled, dicts, ROWS);
+
+    // Any number of workers produces the same output, in row order
+    size_t workers[] = {2, 3, 7, SIMPLET_BATCH_MAX_WORKERS, 1000};
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        char *output = NULL;
+        size_t length = 0;
+        assert(simplet_render_batch(compiled, dicts, ROWS, workers[i], &output, &length) == SUCCESS);
+        assert(length == strlen(expected));
+        assert(strcmp(output, expected) == 0);
+        free(output);
+    }
+
+    // Runs share the built-in pool once it is started
+    simplet_set_parallel_render(4, 0);
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        char *output = NULL;
+        assert(simplet_render_batch(compiled, dicts, ROWS, workers[i], &output, NULL) == SUCCESS);
+        assert(strcmp(output, expected) == 0);
+        free(output);
+    }
+    simplet_set_parallel_render(0, 0);
+
+    // Fewer rows than workers
+    char *output = NULL;
+    assert(simplet_render_batch(compiled, dicts, 2, 8, &output, NULL) == SUCCESS);
+    char *two = render_each(compiled, dicts, 2);
+    assert(strcmp(output, two) == 0);
+    free(two);
+    free(output);
+
+    free(expected);
+    destroy_simplet_template(compiled);
+    destroy_rows();
+}
+
+TEST_CASE(simplet_batch_to_sink, "[simplet_batch]") {
+    create_rows();
+    simplet_template_t *compiled = compile_simplet_template(ROW_TEMPLATE);
+    const simplet_dictionary_t *const *dicts = (const simplet_dictionary_t *const *)rows;
+    char *expected = render_each(compiled, dicts, ROWS);
+
+    char *sunk = calloc(1, 1);
+    assert(simplet_render_batch_to_sink(compiled, dicts, ROWS, append_sink, &sunk) == SUCCESS);
+    assert(strcmp(sunk, expected) == 0);
+    free(sunk);
+
+    // The first failed write stops the batch
+    int calls = 0;
+    assert(simplet_render_batch_to_sink(compiled, dicts, ROWS, failing_sink, &calls) == ERROR_WRITE_FAILED);
+    assert(calls == 1);
+
+    assert(simplet_render_batch_to_sink(NULL, dicts, ROWS, append_sink, &sunk) == ERROR_NULL_PARAM);
+    assert(simplet_render_batch_to_sink(compiled, dicts, ROWS, NULL, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_render_batch_to_sink(compiled, NULL, 1, append_sink, &sunk) == ERROR_NULL_PARAM);
+
+    free(expected);
+    destroy_simplet_template(compiled);
+    destroy_rows();
+}
+
+TEST_CASE(simplet_batch_edge_cases, "[simplet_batch]") {
+    simplet_template_t *compiled = compile_simplet_template("[{{value}}]");
+    char *stale = malloc(1);
+    char *output = stale;
+    size_t length = 1;
+
+    assert(simplet_render_batch(NULL, NULL, 0, 1, &output, NULL) == ERROR_NULL_PARAM);
+    assert(output == NULL);
+    free(stale);
+    assert(simplet_render_batch(compiled, NULL, 0, 1, NULL, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_render_batch(compiled, NULL, 3, 1, &output, NULL) == ERROR_NULL_PARAM);
+
+    // No rows is an empty string
+    assert(simplet_render_batch(compiled, NULL, 0, 4, &output, &length) == SUCCESS);
+    assert(strcmp(output, "") == 0 && length == 0);
+    free(output);
+
+    // A row much larger than the first grows the buffer mid-batch
+    enum { LARGE = 1000 };
+    char *large = malloc(LARGE + 1);
+    memset(large, 'x', LARGE);
+    large[LARGE] = '\0';
+
+    simplet_dictionary_t *small = create_simplet_dictionary(SIZE_SMALL, true);
+    simplet_dictionary_t *big = create_simplet_dictionary(SIZE_SMALL, true);
+    assert(simplet_dictionary_set(small, "value", "a") == SUCCESS);
+    assert(simplet_dictionary_set(big, "value", large) == SUCCESS);
+
+    const simplet_dictionary_t *dicts[4] = {small, small, big, small};
+    assert(simplet_render_batch(compiled, dicts, 4, 1, &output, &length) == SUCCESS);
+    assert(length == 3 * 3 + LARGE + 2);
+    assert(strncmp(output, "[a][a][x", 8) == 0);
+    assert(strcmp(output + length - 5, "x][a]") == 0);
+    free(output);
+
+    free(large);
+    destroy_simplet_dictionary(small);
+    destroy_simplet_dictionary(big);
+    destroy_simplet_template(compiled);
+}
@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_batch.c
+void test_simplet_batch_matches_single_renders(void);
+void test_simplet_batch_workers(void);
+void test_simplet_batch_to_sink(void);
+void test_simplet_batch_edge_cases(void);
+
+int main(void) {
+    printf("Running simplet_batch tests...\n");
+
+    test_simplet_batch_matches_single_renders();
+    printf("✓ test_simplet_batch_matches_single_renders\n");
+
+    test_simplet_batch_workers();
+    printf("✓ test_simplet_batch_workers\n");
+
+    test_simplet_batch_to_sink();
+    printf("✓ test_simplet_batch_to_sink\n");
+
+    test_simplet_batch_edge_cases();
+    printf("✓ test_simplet_batch_edge_cases\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
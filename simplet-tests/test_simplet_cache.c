@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_cache.h"
+#include "simplet_dictionary.h"
+
+TEST_CASE(simplet_cache_serves_unchanged_pages, "[simplet_cache]") {
+    static const char page[] = "<p>{{status}} at {{time}}</p>";
+    simplet_render_cache_t* cache = create_simplet_render_cache(4096);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    assert(cache != NULL && dict != NULL);
+
+    simplet_dictionary_set(dict, "status", "ok");
+    simplet_dictionary_set(dict, "time", "12:00");
+
+    size_t length = 0;
+    const char* first = simplet_render_cache_html(cache, page, dict, &length);
+    assert(strcmp(first, "<p>ok at 12:00</p>") == 0);
+    assert(length == strlen(first));
+
+    const char* second = simplet_render_cache_html(cache, page, dict, NULL);
+    assert(second == first);
+
+    // Setting the same value is not a change
+    simplet_dictionary_set(dict, "status", "ok");
+    assert(simplet_render_cache_html(cache, page, dict, NULL) == first);
+
+    simplet_render_cache_stats_t stats;
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.hits == 2);
+    assert(stats.misses == 1);
+    assert(stats.entry_count == 1);
+
+    simplet_dictionary_set(dict, "status", "degraded");
+    assert(strcmp(simplet_render_cache_html(cache, page, dict, NULL), "<p>degraded at 12:00</p>") == 0);
+
+    simplet_dictionary_remove(dict, "time");
+    assert(strcmp(simplet_render_cache_html(cache, page, dict, NULL), "<p>degraded at </p>") == 0);
+
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.hits == 2);
+    assert(stats.misses == 3);
+    assert(stats.entry_count == 1);
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_render_cache(cache);
+}
+
+TEST_CASE(simplet_cache_keys_by_template_and_dictionary, "[simplet_cache]") {
+    static const char page_a[] = "A:{{name}}";
+    static const char page_b[] = "B:{{name}}";
+    simplet_render_cache_t* cache = create_simplet_render_cache(4096);
+    simplet_dictionary_t* first = create_simplet_dictionary(16, true);
+    simplet_dictionary_t* second = create_simplet_dictionary(16, true);
+    simplet_template_t* compiled = compile_simplet_template(page_a);
+
+    simplet_dictionary_set(first, "name", "one");
+    simplet_dictionary_set(second, "name", "two");
+
+    assert(strcmp(simplet_render_cache_html(cache, page_a, first, NULL), "A:one") == 0);
+    assert(strcmp(simplet_render_cache_html(cache, page_b, first, NULL), "B:one") == 0);
+    assert(strcmp(simplet_render_cache_html(cache, page_a, second, NULL), "A:two") == 0);
+    assert(strcmp(simplet_render_cache_template(cache, compiled, second, NULL), "A:two") == 0);
+    assert(strcmp(simplet_render_cache_template(cache, compiled, second, NULL), "A:two") == 0);
+    assert(strcmp(simplet_render_cache_html(cache, page_a, NULL, NULL), "A:") == 0);
+
+    simplet_render_cache_stats_t stats;
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.misses == 5);
+    assert(stats.hits == 1);
+    assert(stats.entry_count == 5);
+
+    // A new dictionary at a recycled address still starts a new generation
+    destroy_simplet_dictionary(second);
+    second = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(second, "name", "three");
+    assert(strcmp(simplet_render_cache_html(cache, page_a, second, NULL), "A:three") == 0);
+
+    assert(simplet_render_cache_html(NULL, page_a, first, NULL) == NULL);
+    assert(simplet_render_cache_html(cache, NULL, first, NULL) == NULL);
+    assert(simplet_render_cache_template(cache, NULL, first, NULL) == NULL);
+
+    clear_simplet_render_cache(cache);
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.entry_count == 0);
+    assert(stats.bytes_used == 0);
+
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(first);
+    destroy_simplet_dictionary(second);
+    destroy_simplet_render_cache(cache);
+}
+
+TEST_CASE(simplet_cache_evicts_least_recently_used, "[simplet_cache]") {
+    static const char pages[4][16] = { "0:{{v}}", "1:{{v}}", "2:{{v}}", "3:{{v}}" };
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "v", "0123456789012345678901234567890123456789");
+
+    // Room for exactly three pages
+    size_t page_cost = sizeof(simplet_cache_entry_t) + 42 + 1;
+    simplet_render_cache_t* cache = create_simplet_render_cache(3 * page_cost);
+
+    simplet_render_cache_html(cache, pages[0], dict, NULL);
+    simplet_render_cache_html(cache, pages[1], dict, NULL);
+    simplet_render_cache_html(cache, pages[2], dict, NULL);
+    simplet_render_cache_html(cache, pages[0], dict, NULL);   // 1 is now least recently used
+    simplet_render_cache_html(cache, pages[3], dict, NULL);   // Evicts 1
+
+    simplet_render_cache_stats_t stats;
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.evictions == 1);
+    assert(stats.entry_count == 3);
+    assert(stats.bytes_used <= 3 * page_cost);
+    assert(stats.hits == 1);
+
+    simplet_render_cache_html(cache, pages[0], dict, NULL);
+    simplet_render_cache_html(cache, pages[2], dict, NULL);
+    simplet_render_cache_html(cache, pages[3], dict, NULL);
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.hits == 4);
+
+    simplet_render_cache_html(cache, pages[1], dict, NULL);
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.misses == 5);
+    assert(stats.evictions == 2);
+
+    destroy_simplet_render_cache(cache);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_cache_returns_pages_larger_than_budget, "[simplet_cache]") {
+    static const char page[] = "<html>{{body}}</html>";
+    simplet_render_cache_t* cache = create_simplet_render_cache(16);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "body", "too large to keep");
+
+    const char* text = simplet_render_cache_html(cache, page, dict, NULL);
+    assert(strcmp(text, "<html>too large to keep</html>") == 0);
+
+    text = simplet_render_cache_html(cache, page, dict, NULL);
+    assert(strcmp(text, "<html>too large to keep</html>") == 0);
+
+    simplet_render_cache_stats_t stats;
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.misses == 2);
+    assert(stats.entry_count == 0);
+    assert(stats.bytes_used == 0);
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_render_cache(cache);
+}
+
+TEST_CASE(simplet_cache_sees_parent_changes, "[simplet_cache]") {
+    static const char page[] = "{{device}} {{path}}";
+    simplet_render_cache_t* cache = create_simplet_render_cache(4096);
+    simplet_dictionary_t* global = create_simplet_dictionary(16, true);
+    simplet_dictionary_t* request = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(global, "device", "esp32");
+    simplet_dictionary_set(request, "path", "/");
+    simplet_dictionary_set_parent(request, global);
+
+    const char* first = simplet_render_cache_html(cache, page, request, NULL);
+    assert(strcmp(first, "esp32 /") == 0);
+    assert(simplet_render_cache_html(cache, page, request, NULL) == first);
+
+    // Only the parent changed, yet the page is rendered again
+    simplet_dictionary_set(global, "device", "esp32s3");
+    assert(strcmp(simplet_render_cache_html(cache, page, request, NULL), "esp32s3 /") == 0);
+
+    destroy_simplet_render_cache(cache);
+    destroy_simplet_dictionary(request);
+    destroy_simplet_dictionary(global);
+}
@@ -0,0 +1,30 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_cache.c
+void test_simplet_cache_serves_unchanged_pages(void);
+void test_simplet_cache_keys_by_template_and_dictionary(void);
+void test_simplet_cache_evicts_least_recently_used(void);
+void test_simplet_cache_returns_pages_larger_than_budget(void);
+void test_simplet_cache_sees_parent_changes(void);
+
+int main(void) {
+    printf("Running simplet_cache tests...\n");
+
+    test_simplet_cache_serves_unchanged_pages();
+    printf("✓ test_simplet_cache_serves_unchanged_pages\n");
+
+    test_simplet_cache_keys_by_template_and_dictionary();
+    printf("✓ test_simplet_cache_keys_by_template_and_dictionary\n");
+
+    test_simplet_cache_evicts_least_recently_used();
+    printf("✓ test_simplet_cache_evicts_least_recently_used\n");
+
+    test_simplet_cache_returns_pages_larger_than_budget();
+    printf("✓ test_simplet_cache_returns_pages_larger_than_budget\n");
+
+    test_simplet_cache_sees_parent_changes();
+    printf("✓ test_simplet_cache_sees_parent_changes\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "test_support.h"
+#include "status_page_template.h"
+#include "device_list_template.h"
+
+// Source of a generated template, rendered at runtime for comparison
+static char* read_template_file(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+
+    static char text[4096];
+    *length = fread(text, 1, sizeof(text), file);
+    fclose(file);
+    assert(*length > 0 && *length < sizeof(text));
+    return text;
+}
+
+static char* read_template(size_t *length) {
+    return read_template_file(SIMPLET_COMPILED_TEMPLATE_PATH, length);
+}
+
+static void write_uptime(void *context, simplet_value_writer_t *writer) {
+    (void)context;
+    simplet_value_printf(writer, "%d", 99);
+}
+
+TEST_CASE(simplet_compiled_matches_runtime_render, "[simplet_compiled]") {
+    size_t length;
+    const char *source = read_template(&length);
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    assert(dict != NULL);
+
+    // Empty dictionary, then NULL: only the literal text remains
+    char *compiled = simplet_render_status_page(dict);
+    char *runtime = simplet_render_html_n(source, length, dict);
+    assert(compiled != NULL && runtime != NULL);
+    assert(strcmp(compiled, runtime) == 0);
+    assert(strlen(compiled) == SIMPLET_STATUS_PAGE_LITERAL_LENGTH);
+    assert(simplet_render_status_page_length(NULL) == SIMPLET_STATUS_PAGE_LITERAL_LENGTH);
+    free(compiled);
+    free(runtime);
+
+    compiled = simplet_render_status_page(NULL);
+    assert(compiled != NULL && strlen(compiled) == SIMPLET_STATUS_PAGE_LITERAL_LENGTH);
+    free(compiled);
+
+    // Repeated keys, trimmed keys, empty values and values with delimiters
+    simplet_dictionary_set(dict, "title", "Kitchen \"node\" {{title}}");
+    simplet_dictionary_set(dict, "theme", "dark");
+    simplet_dictionary_set(dict, "uptime", "86400");
+    simplet_dictionary_set(dict, "load", "");
+    simplet_dictionary_set(dict, "unrelated", "never shown");
+
+    compiled = simplet_render_status_page(dict);
+    runtime = simplet_render_html_n(source, length, dict);
+    assert(strcmp(compiled, runtime) == 0);
+    assert(strstr(compiled, "<body class=\"dark\">") != NULL);
+    assert(strstr(compiled, "report?\?=") != NULL);
+    assert(strlen(compiled) == simplet_render_status_page_length(dict));
+    free(compiled);
+    free(runtime);
+
+#if SIMPLET_INSTRUMENTATION
+    // Reported to observers and counters the way the generic renderer reports it
+    simplet_stats_t generic_stats, generated_stats;
+    simplet_reset_stats();
+    free(simplet_template_render(&simplet_template_status_page, dict));
+    simplet_get_stats(&generic_stats);
+    simplet_reset_stats();
+    free(simplet_render_status_page(dict));
+    simplet_get_stats(&generated_stats);
+    assert(generated_stats.renders == 1 && generic_stats.renders == 1);
+    assert(generated_stats.bytes_emitted == generic_stats.bytes_emitted);
+    assert(generated_stats.placeholders_resolved == generic_stats.placeholders_resolved);
+    assert(generated_stats.placeholders_missed == generic_stats.placeholders_missed);
+#endif
+
+    // Providers and numbers hand the render to the generic renderer
+    simplet_dictionary_set_provider(dict, "uptime", write_uptime, NULL);
+    simplet_dictionary_set_float(dict, "load", 0.5);
+    compiled = simplet_render_status_page(dict);
+    runtime = simplet_render_html_n(source, length, dict);
+    assert(strcmp(compiled, runtime) == 0);
+    assert(strstr(compiled, "Uptime: 99s, load 0.50") != NULL);
+    assert(strlen(compiled) == simplet_render_status_page_length(dict));
+    free(compiled);
+    free(runtime);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_compiled_template_works_with_generic_api, "[simplet_compiled]") {
+    size_t length;
+    const char *source = read_template(&length);
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "title", "Status");
+    simplet_dictionary_set(dict, "uptime", "12");
+
+    char *expected = simplet_render_html_n(source, length, dict);
+    assert(expected != NULL);
+
+    // The generated template is an ordinary compiled template
+    char *rendered = simplet_template_render(&simplet_template_status_page, dict);
+    assert(strcmp(rendered, expected) == 0);
+    free(rendered);
+
+    static char streamed[4096];
+    streamed[0] = '\0';
+    assert(simplet_render_to_sink(&simplet_template_status_page, dict, append_sink, streamed) == SUCCESS);
+    assert(strcmp(streamed, expected) == 0);
+
+    char small[16];
+    size_t needed = 0;
+    assert(simplet_render_into(small, sizeof(small), &simplet_template_status_page, dict, &needed) == ERROR_BUFFER_TOO_SMALL);
+    assert(strncmp(small, expected, sizeof(small) - 1) == 0);
+    assert(needed == strlen(expected));
+    assert(simplet_render_length(&simplet_template_status_page, dict) == strlen(expected));
+
+    // Incremental renders patch the generated template like a runtime one
+    simplet_incremental_t *page = create_simplet_incremental(&simplet_template_status_page);
+    assert(page != NULL);
+    assert(simplet_incremental_render(page, dict) == SUCCESS);
+    simplet_dictionary_set(dict, "uptime", "13");
+    simplet_change_t changes[4];
+    size_t change_count = 0;
+    assert(simplet_incremental_update(page, dict, changes, 4, &change_count) == SUCCESS);
+    assert(change_count == 1);
+
+    char *updated = simplet_render_status_page(dict);
+    assert(strcmp(simplet_incremental_output(page, NULL), updated) == 0);
+    free(updated);
+
+    destroy_simplet_incremental(page);
+    free(expected);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_compiled_sections_match_runtime_render, "[simplet_compiled]") {
+    size_t length;
+    const char *source = read_template_file(SIMPLET_COMPILED_SECTIONS_PATH, &length);
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_t *devices[2] = { create_simplet_dictionary(4, true), create_simplet_dictionary(4, true) };
+    simplet_dictionary_set(dict, "site", "<lab>");
+    simplet_dictionary_set(dict, "footer", "end");
+    simplet_dictionary_set(devices[0], "name", "pump & co");
+    simplet_dictionary_set(devices[0], "on", "yes");
+    simplet_dictionary_set(devices[1], "name", "fan");
+
+    // Blocks nested past SIMPLET_MAX_BLOCK_DEPTH are not counted
+    assert(simplet_template_device_list.block_count == 6 + SIMPLET_MAX_BLOCK_DEPTH);
+
+    // Without devices, then with a list, then with an empty list
+    for (int pass = 0; pass < 3; pass++) {
+        if (pass == 1) simplet_dictionary_set_list(dict, "devices", devices, 2);
+        if (pass == 2) simplet_dictionary_set_list(dict, "devices", devices, 0);
+        if (pass == 2) simplet_dictionary_set(dict, "unclosed", "1");
+
+        char *compiled = simplet_render_device_list(dict);
+        char *runtime = simplet_render_html_n(source, length, dict);
+        assert(compiled != NULL && runtime != NULL);
+        assert(strcmp(compiled, runtime) == 0);
+        assert(strlen(compiled) == simplet_render_device_list_length(dict));
+        assert((strstr(compiled, "<td>pump &amp; co</td><td>on</td><td><lab></td>") != NULL) == (pass == 1));
+        assert((strstr(compiled, "No devices") != NULL) == (pass != 1));
+        assert((strstr(compiled, "<footer>end") != NULL) == (pass == 2));
+        assert(strstr(compiled, "<p>leak</p>") == NULL && strstr(compiled, "<p>deep</p>") != NULL);
+        free(compiled);
+        free(runtime);
+    }
+
+    // Partials in a generated template are linked like any other
+    assert(simplet_template_device_list.partial_count == 1);
+    simplet_partials_t *partials = create_simplet_partials();
+    assert(simplet_partials_add(partials, "legend", "<small>{{site}}</small>") == SUCCESS);
+    assert(simplet_partials_link(partials, &simplet_template_device_list) == SUCCESS);
+    char *linked = simplet_render_device_list(dict);
+    assert(strstr(linked, "<small><lab></small>") != NULL);
+    assert(strlen(linked) == simplet_render_device_list_length(dict));
+    free(linked);
+    destroy_simplet_partials(partials);
+
+    destroy_simplet_dictionary(devices[0]);
+    destroy_simplet_dictionary(devices[1]);
+    destroy_simplet_dictionary(dict);
+}
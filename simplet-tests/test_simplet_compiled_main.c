@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_compiled.c
+void test_simplet_compiled_matches_runtime_render(void);
+void test_simplet_compiled_template_works_with_generic_api(void);
+void test_simplet_compiled_sections_match_runtime_render(void);
+
+int main(void) {
+    printf("Running simplet_compiled tests...\n");
+
+    test_simplet_compiled_matches_runtime_render();
+    printf("✓ test_simplet_compiled_matches_runtime_render\n");
+
+    test_simplet_compiled_template_works_with_generic_api();
+    printf("✓ test_simplet_compiled_template_works_with_generic_api\n");
+
+    test_simplet_compiled_sections_match_runtime_render();
+    printf("✓ test_simplet_compiled_sections_match_runtime_render\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define TEST_CASE(name, tags) void test_##name(void)
 
@@ -79,3 +81,492 @@ TEST_CASE(stunt_dict_handles_special_characters_in_values, "[stunt_dict]") {
 
     destroy_simplet_dictionary(dict);
 }
+
+TEST_CASE(stunt_dict_survives_growth_and_removal, "[stunt_dict]") {
+    for (int auto_resize = 0; auto_resize <= 1; auto_resize++) {
+        simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_TINY, auto_resize);
+        assert(dict != NULL);
+
+        char key[MAX_KEY_SIZE];
+        char value[32];
+
+        // Mix of short keys and keys long enough to be stored out of line
+        for (int i = 0; i < 1000; i++) {
+            snprintf(key, sizeof(key), i % 3 ? "k%d" : "a-much-longer-key-name-%d", i);
+            snprintf(value, sizeof(value), "v%d", i);
+            assert(simplet_dictionary_set(dict, key, value) == SUCCESS);
+        }
+        assert(simplet_dictionary_count(dict) == 1000);
+
+        for (int i = 0; i < 1000; i += 2) {
+            snprintf(key, sizeof(key), i % 3 ? "k%d" : "a-much-longer-key-name-%d", i);
+            assert(simplet_dictionary_remove(dict, key) == SUCCESS);
+            assert(simplet_dictionary_remove(dict, key) == ERROR_KEY_NOT_FOUND);
+        }
+        assert(simplet_dictionary_count(dict) == 500);
+
+        for (int i = 0; i < 1000; i++) {
+            snprintf(key, sizeof(key), i % 3 ? "k%d" : "a-much-longer-key-name-%d", i);
+            snprintf(value, sizeof(value), "v%d", i);
+            const char* found = simplet_dictionary_get(dict, key);
+            if (i % 2) {
+                assert(found != NULL && strcmp(value, found) == 0);
+            } else {
+                assert(found == NULL);
+            }
+        }
+
+        clear_simplet_dictionary(dict);
+        assert(simplet_dictionary_is_empty(dict));
+        assert(simplet_dictionary_allocated_size(dict) == 0);
+        assert(simplet_dictionary_get(dict, "k1") == NULL);
+
+        destroy_simplet_dictionary(dict);
+    }
+}
+
+TEST_CASE(stunt_dict_uses_caller_arena, "[stunt_dict]") {
+    static char arena_buffer[512];
+    simplet_dictionary_t* dict = create_simplet_dictionary_with_arena(SIZE_TINY, false, arena_buffer, sizeof(arena_buffer));
+    assert(dict != NULL);
+
+    assert(simplet_dictionary_set(dict, "title", "Status") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "title", "Config") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "a-key-longer-than-sixteen-bytes", "long") == SUCCESS);
+
+    const char* value = simplet_dictionary_get(dict, "title");
+    assert(value != NULL && strcmp("Config", value) == 0);
+    assert(value >= arena_buffer && value < arena_buffer + sizeof(arena_buffer));
+
+    assert(simplet_dictionary_remove(dict, "title") == SUCCESS);
+    assert(simplet_dictionary_get(dict, "title") == NULL);
+
+    // A full caller arena reports out of memory
+    char big_value[300];
+    memset(big_value, 'x', sizeof(big_value) - 1);
+    big_value[sizeof(big_value) - 1] = '\0';
+    assert(simplet_dictionary_set(dict, "big1", big_value) == SUCCESS);
+    assert(simplet_dictionary_set(dict, "big2", big_value) == ERROR_NO_MEMORY);
+    assert(simplet_dictionary_get(dict, "big2") == NULL);
+
+    // Clearing resets the arena for reuse
+    clear_simplet_dictionary(dict);
+    assert(simplet_dictionary_is_empty(dict));
+    assert(simplet_dictionary_set(dict, "big2", big_value) == SUCCESS);
+    assert(simplet_dictionary_get(dict, "big1") == NULL);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_reuses_growable_arena_chunks, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary_with_arena(SIZE_SMALL, false, NULL, 0);
+    assert(dict != NULL);
+
+    char key[32];
+    char value[64];
+    size_t warm_chunks = 0;
+
+    for (int request = 0; request < 10; request++) {
+        for (int i = 0; i < 60; i++) {
+            snprintf(key, sizeof(key), "key-%d", i);
+            snprintf(value, sizeof(value), "request %d value %d", request, i);
+            assert(simplet_dictionary_set(dict, key, value) == SUCCESS);
+        }
+
+        assert(simplet_dictionary_count(dict) == 60);
+        const char* found = simplet_dictionary_get(dict, "key-59");
+        snprintf(value, sizeof(value), "request %d value %d", request, 59);
+        assert(found != NULL && strcmp(value, found) == 0);
+
+        // After the first request the arena serves everything from retained chunks
+        size_t chunks = 0;
+        for (simplet_arena_chunk_t* chunk = dict->arena->first.next; chunk; chunk = chunk->next) chunks++;
+        if (request == 0) warm_chunks = chunks;
+        assert(chunks > 0 && chunks == warm_chunks);
+
+        clear_simplet_dictionary(dict);
+    }
+
+    destroy_simplet_dictionary(dict);
+}
+
+// No entry is left anywhere in the table
+static void assert_table_empty(const simplet_dictionary_t* dict) {
+    size_t cursor = 0;
+    assert(dictionary_next_entry(dict, &cursor, NULL) == NULL);
+    assert(simplet_dictionary_count(dict) == 0);
+}
+
+TEST_CASE(stunt_dict_clears_only_filled_arena_buckets, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary_with_arena(SIZE_TINY, true, NULL, 0);
+    assert(dict != NULL);
+    char key[32];
+
+    // A large fill grows the table; its buckets are recorded through every resize
+    for (int i = 0; i < 500; i++) {
+        snprintf(key, sizeof(key), "key-%d", i);
+        assert(simplet_dictionary_set(dict, key, "value") == SUCCESS);
+    }
+    assert(dict->filled.count <= 500 && dict->filled.count < dict->bucket_count);
+    clear_simplet_dictionary(dict);
+    assert_table_empty(dict);
+    assert(dict->filled.count == 0);
+
+    // A small fill of the large table records only its own buckets
+    size_t bucket_count = dict->bucket_count;
+    assert(simplet_dictionary_set(dict, "a", "1") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "b", "2") == SUCCESS);
+    assert(dict->bucket_count == bucket_count);
+    assert(dict->filled.count <= 2);
+    clear_simplet_dictionary(dict);
+    assert_table_empty(dict);
+    assert(simplet_dictionary_get(dict, "a") == NULL);
+
+    destroy_simplet_dictionary(dict);
+
+    // Refilling an emptied bucket more often than there are buckets falls back to a full clear
+    dict = create_simplet_dictionary_with_arena(SIZE_TINY, false, NULL, 0);
+    assert(dict != NULL);
+    for (size_t i = 0; i <= dict->bucket_count; i++) {
+        assert(simplet_dictionary_set(dict, "churn", "1") == SUCCESS);
+        assert(simplet_dictionary_remove(dict, "churn") == SUCCESS);
+    }
+    assert(dict->filled.count == SIZE_MAX);
+    assert(simplet_dictionary_set(dict, "kept", "1") == SUCCESS);
+    clear_simplet_dictionary(dict);
+    assert_table_empty(dict);
+
+    // Tracking resumes after the full clear
+    assert(simplet_dictionary_set(dict, "again", "1") == SUCCESS);
+    assert(dict->filled.count == 1);
+    assert(strcmp(simplet_dictionary_get(dict, "again"), "1") == 0);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_stores_borrowed_values_without_copying, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+
+    static const char firmware_version[] = "1.4.2";
+    static const char long_key[] = "a-static-key-longer-than-sixteen-bytes";
+
+    assert(simplet_dictionary_set_borrowed(dict, "version", firmware_version) == SUCCESS);
+    assert(simplet_dictionary_get(dict, "version") == firmware_version);
+    assert(simplet_dictionary_allocated_size(dict) == strlen("version") + 1);
+
+    assert(simplet_dictionary_set_static(dict, long_key, firmware_version) == SUCCESS);
+    assert(simplet_dictionary_get(dict, long_key) == firmware_version);
+    assert(simplet_dictionary_allocated_size(dict) == strlen("version") + 1);
+
+    // Stored lengths come back without rescanning
+    const simplet_value_t* value = simplet_dictionary_find_value(dict, "version", 7, hash_key("version"));
+    assert(value != NULL && value->length == strlen(firmware_version));
+
+    // Overwriting a borrowed value with a copied one and back
+    assert(simplet_dictionary_set(dict, "version", "2.0.0") == SUCCESS);
+    assert(simplet_dictionary_get(dict, "version") != firmware_version);
+    assert(strcmp("2.0.0", simplet_dictionary_get(dict, "version")) == 0);
+    assert(simplet_dictionary_set_borrowed(dict, "version", firmware_version) == SUCCESS);
+    assert(simplet_dictionary_allocated_size(dict) == strlen("version") + 1);
+
+    assert(simplet_dictionary_remove(dict, long_key) == SUCCESS);
+    assert(simplet_dictionary_remove(dict, "version") == SUCCESS);
+    assert(simplet_dictionary_allocated_size(dict) == 0);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_sets_values_with_known_lengths, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+
+    // Slices of larger buffers are copied and terminated
+    const char* line = "ssid=HomeNetwork;rssi=-61";
+    assert(simplet_dictionary_set_n(dict, line, 4, line + 5, 11) == SUCCESS);
+    assert(strcmp("HomeNetwork", simplet_dictionary_get(dict, "ssid")) == 0);
+
+    const char* borrowed = "-61";
+    assert(simplet_dictionary_set_borrowed_n(dict, "rssi", 4, borrowed, 3) == SUCCESS);
+    assert(simplet_dictionary_get(dict, "rssi") == borrowed);
+
+    assert(simplet_dictionary_set_n(dict, "k", SIZE_MAX, "v", 1) == ERROR_INVALID_SIZE);
+    assert(simplet_dictionary_set_n(dict, "k", MAX_KEY_SIZE, "v", 1) == ERROR_KEY_TOO_LONG);
+    assert(simplet_dictionary_set_n(dict, "k", 1, "v", MAX_VALUE_SIZE) == ERROR_INVALID_SIZE);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_gets_values_by_key_slice, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+
+    assert(simplet_dictionary_set(dict, "title", "Status") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "tit", "prefix") == SUCCESS);
+
+    const char* template_html = "<h1>{{ title }}</h1>";
+    const char* value = simplet_dictionary_get_n(dict, template_html + 7, 5);
+    assert(value != NULL && strcmp("Status", value) == 0);
+
+    value = simplet_dictionary_get_n(dict, template_html + 7, 3);
+    assert(value != NULL && strcmp("prefix", value) == 0);
+
+    value = simplet_dictionary_get_n_hashed(dict, template_html + 7, 5, hash_key("title"));
+    assert(value != NULL && strcmp("Status", value) == 0);
+    assert(hash_key_n(template_html + 7, 5) == hash_key("title"));
+
+    assert(simplet_dictionary_get_n(dict, template_html + 7, 4) == NULL);
+    assert(simplet_dictionary_get_n(NULL, "title", 5) == NULL);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_tracks_content_generation, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_t* other = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL && other != NULL);
+    assert(simplet_dictionary_generation(dict) != simplet_dictionary_generation(other));
+    assert(simplet_dictionary_generation(NULL) == 0);
+
+    uint32_t generation = simplet_dictionary_generation(dict);
+    assert(simplet_dictionary_set(dict, "mode", "auto") == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    // Same content, whether copied or borrowed, is not a change
+    generation = simplet_dictionary_generation(dict);
+    char same[] = "auto";
+    assert(simplet_dictionary_set(dict, "mode", same) == SUCCESS);
+    assert(simplet_dictionary_set_n(dict, "mode", 4, "auto", 4) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) == generation);
+
+    assert(simplet_dictionary_set_borrowed(dict, "mode", same) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) == generation);
+    assert(simplet_dictionary_get(dict, "mode") != same);   // Owned copy is kept
+
+    assert(simplet_dictionary_set(dict, "mode", "manual") == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    generation = simplet_dictionary_generation(dict);
+    assert(simplet_dictionary_remove(dict, "missing") == ERROR_KEY_NOT_FOUND);
+    assert(simplet_dictionary_generation(dict) == generation);
+    assert(simplet_dictionary_remove(dict, "mode") == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    generation = simplet_dictionary_generation(dict);
+    clear_simplet_dictionary(dict);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    destroy_simplet_dictionary(other);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_falls_back_to_parent, "[stunt_dict]") {
+    simplet_dictionary_t* global = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_t* site = create_simplet_dictionary(SIZE_TINY, false);
+    simplet_dictionary_t* request = create_simplet_dictionary_with_arena(SIZE_TINY, false, NULL, 0);
+    assert(global != NULL && site != NULL && request != NULL);
+
+    simplet_dictionary_set(global, "device", "esp32");
+    simplet_dictionary_set(global, "version", "1.0");
+    simplet_dictionary_set(site, "version", "1.1");
+    simplet_dictionary_set(request, "path", "/status");
+
+    assert(simplet_dictionary_set_parent(site, global) == SUCCESS);
+    assert(simplet_dictionary_set_parent(request, site) == SUCCESS);
+    assert(simplet_dictionary_parent(request) == site);
+
+    // The nearest layer that has a key wins
+    assert(strcmp(simplet_dictionary_get(request, "path"), "/status") == 0);
+    assert(strcmp(simplet_dictionary_get(request, "version"), "1.1") == 0);
+    assert(strcmp(simplet_dictionary_get(request, "device"), "esp32") == 0);
+    assert(simplet_dictionary_contains(request, "device"));
+    assert(simplet_dictionary_get(request, "missing") == NULL);
+    assert(simplet_dictionary_get(global, "path") == NULL);
+
+    // Writes, counts and removal stay in the layer itself
+    assert(simplet_dictionary_count(request) == 1);
+    assert(simplet_dictionary_remove(request, "device") == ERROR_KEY_NOT_FOUND);
+    simplet_dictionary_set(request, "device", "");
+    assert(strcmp(simplet_dictionary_get(request, "device"), "") == 0);
+    assert(strcmp(simplet_dictionary_get(site, "device"), "esp32") == 0);
+
+    // A change in any layer changes the generation of the layers above it
+    uint32_t generation = simplet_dictionary_generation(request);
+    simplet_dictionary_set(global, "device", "esp32s3");
+    assert(simplet_dictionary_generation(request) != generation);
+    generation = simplet_dictionary_generation(request);
+    simplet_dictionary_set(site, "extra", "x");
+    assert(simplet_dictionary_generation(request) != generation);
+
+    // Clearing keeps the parent, so a pooled request dictionary is reused as is
+    clear_simplet_dictionary(request);
+    assert(strcmp(simplet_dictionary_get(request, "device"), "esp32s3") == 0);
+
+    // Loops are refused
+    assert(simplet_dictionary_set_parent(global, request) == ERROR_INVALID_PARENT);
+    assert(simplet_dictionary_set_parent(global, global) == ERROR_INVALID_PARENT);
+    assert(simplet_dictionary_set_parent(NULL, global) == ERROR_NULL_PARAM);
+    assert(simplet_dictionary_parent(global) == NULL);
+
+    assert(simplet_dictionary_set_parent(request, NULL) == SUCCESS);
+    assert(simplet_dictionary_get(request, "device") == NULL);
+
+    destroy_simplet_dictionary(request);
+    destroy_simplet_dictionary(site);
+    destroy_simplet_dictionary(global);
+}
+
+static const simplet_value_t* find_value(const simplet_dictionary_t *dict, const char *key) {
+    return simplet_dictionary_find_value(dict, key, strlen(key), hash_key(key));
+}
+
+static void write_nothing(void *context, simplet_value_writer_t *writer) {
+    (void)context;
+    (void)writer;
+}
+
+TEST_CASE(stunt_dict_saves_and_loads_blobs, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_TINY, true);
+    simplet_dictionary_t* item = create_simplet_dictionary(SIZE_TINY, false);
+    assert(dict != NULL && item != NULL);
+
+    char key[16];
+    for (int i = 0; i < 200; i++) {
+        snprintf(key, sizeof(key), "config_%d", i);
+        assert(simplet_dictionary_set(dict, key, key + 7) == SUCCESS);
+    }
+    assert(simplet_dictionary_set(dict, "empty", "") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "markup", "<a href=\"x\">&amp;</a>") == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "offset", -1234567890123LL) == SUCCESS);
+    assert(simplet_dictionary_set_uint(dict, "serial", UINT64_MAX) == SUCCESS);
+    assert(simplet_dictionary_set_float(dict, "gain", -0.125) == SUCCESS);
+    assert(simplet_dictionary_set_bool(dict, "enabled", true) == SUCCESS);
+    assert(simplet_dictionary_set_bool(dict, "debug", false) == SUCCESS);
+
+    // Lists and providers are not saved
+    assert(simplet_dictionary_set_list(dict, "rows", &item, 1) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, "uptime", write_nothing, NULL) == SUCCESS);
+
+    size_t needed = 0;
+    assert(simplet_dictionary_save(dict, NULL, 0, &needed) == ERROR_BUFFER_TOO_SMALL);
+    assert(needed > SIMPLET_BLOB_HEADER_SIZE);
+    char *blob = malloc(needed);
+    assert(simplet_dictionary_save(dict, blob, needed - 1, NULL) == ERROR_BUFFER_TOO_SMALL);
+    assert(simplet_dictionary_save(dict, blob, needed, NULL) == SUCCESS);
+    assert(memcmp(blob, "SPLT\x01\0\0\0", 8) == 0);
+    assert(simplet_dictionary_save(NULL, blob, needed, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_dictionary_save(dict, NULL, needed, NULL) == ERROR_NULL_PARAM);
+
+    for (int borrow = 0; borrow <= 1; borrow++) {
+        simplet_dictionary_t* loaded = simplet_dictionary_load(blob, needed, borrow);
+        assert(loaded != NULL);
+        assert(simplet_dictionary_count(loaded) == simplet_dictionary_count(dict) - 2);
+
+        // Sized once from the count: loading never pushed the table past its load factor
+        assert(stunt_dict_load_factor(loaded) <= LOAD_FACTOR_MAX);
+
+        assert(strcmp(simplet_dictionary_get(loaded, "config_0"), "0") == 0);
+        assert(strcmp(simplet_dictionary_get(loaded, "config_199"), "199") == 0);
+        assert(strcmp(simplet_dictionary_get(loaded, "empty"), "") == 0);
+        assert(strcmp(simplet_dictionary_get(loaded, "markup"), "<a href=\"x\">&amp;</a>") == 0);
+        assert(find_value(loaded, "offset")->integer == -1234567890123LL);
+        assert(find_value(loaded, "serial")->unsigned_integer == UINT64_MAX);
+        assert(find_value(loaded, "gain")->number == -0.125);
+        assert(find_value(loaded, "enabled")->kind == SIMPLET_VALUE_BOOL);
+        assert(find_value(loaded, "enabled")->integer == 1);
+        assert(find_value(loaded, "debug")->integer == 0);
+        assert(!simplet_dictionary_contains(loaded, "rows"));
+        assert(!simplet_dictionary_contains(loaded, "uptime"));
+
+        // Borrowed strings point into the blob and allocate nothing
+        const char *value = simplet_dictionary_get(loaded, "markup");
+        bool inside = value >= blob && value < blob + needed;
+        assert(inside == (borrow == 1));
+        assert((simplet_dictionary_allocated_size(loaded) == 0) == (borrow == 1));
+
+        // A loaded dictionary saves to a blob of the same size and stays writable
+        size_t resaved = 0;
+        assert(simplet_dictionary_save(loaded, NULL, 0, &resaved) == ERROR_BUFFER_TOO_SMALL);
+        assert(resaved == needed);
+        assert(simplet_dictionary_set(loaded, "markup", "changed") == SUCCESS);
+        assert(strcmp(simplet_dictionary_get(loaded, "markup"), "changed") == 0);
+
+        destroy_simplet_dictionary(loaded);
+    }
+
+    // An empty dictionary is just a header
+    simplet_dictionary_t* empty = create_simplet_dictionary(SIZE_TINY, false);
+    char header[SIMPLET_BLOB_HEADER_SIZE];
+    assert(simplet_dictionary_save(empty, header, sizeof(header), &needed) == SUCCESS);
+    assert(needed == SIMPLET_BLOB_HEADER_SIZE);
+    destroy_simplet_dictionary(empty);
+    empty = simplet_dictionary_load(header, sizeof(header), false);
+    assert(empty != NULL && simplet_dictionary_is_empty(empty));
+    destroy_simplet_dictionary(empty);
+
+    free(blob);
+    destroy_simplet_dictionary(item);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(stunt_dict_rejects_malformed_blobs, "[stunt_dict]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_TINY, false);
+    assert(simplet_dictionary_set(dict, "name", "pump") == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "speed", 1500) == SUCCESS);
+    assert(simplet_dictionary_set_bool(dict, "on", true) == SUCCESS);
+
+    unsigned char blob[128];
+    size_t size = 0;
+    assert(simplet_dictionary_save(dict, blob, sizeof(blob), &size) == SUCCESS);
+    destroy_simplet_dictionary(dict);
+
+    dict = simplet_dictionary_load(blob, size, true);
+    assert(dict != NULL);
+    destroy_simplet_dictionary(dict);
+
+    // Every truncation and trailing bytes are refused
+    for (size_t length = 0; length < size; length++) {
+        assert(simplet_dictionary_load(blob, length, false) == NULL);
+    }
+    blob[size] = 0;
+    assert(simplet_dictionary_load(blob, size + 1, false) == NULL);
+    assert(simplet_dictionary_load(NULL, size, false) == NULL);
+
+    unsigned char bad[128];
+    memcpy(bad, blob, size);
+    bad[0] = 'X';
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    memcpy(bad, blob, size);
+    bad[4] = SIMPLET_BLOB_VERSION + 1;
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    // A count larger than the blob could hold
+    memcpy(bad, blob, size);
+    bad[11] = 0x7f;
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    // Unknown kinds, empty keys and missing terminators
+    memcpy(bad, blob, size);
+    bad[SIMPLET_BLOB_HEADER_SIZE] = SIMPLET_VALUE_LIST;
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    memcpy(bad, blob, size);
+    bad[SIMPLET_BLOB_HEADER_SIZE + 1] = 0;
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    memcpy(bad, blob, size);
+    size_t key_length = bad[SIMPLET_BLOB_HEADER_SIZE + 1];
+    bad[SIMPLET_BLOB_HEADER_SIZE + 2 + key_length] = 'x';
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+
+    // Booleans are 0 or 1
+    memcpy(bad, blob, size);
+    unsigned char *flag = memchr(bad, SIMPLET_VALUE_BOOL, size);
+    while (flag && !(flag[1] == 2 && memcmp(flag + 2, "on", 3) == 0)) {
+        flag = memchr(flag + 1, SIMPLET_VALUE_BOOL, size - (size_t)(flag + 1 - bad));
+    }
+    assert(flag != NULL);
+    flag[5] = 2;
+    assert(simplet_dictionary_load(bad, size, false) == NULL);
+}
@@ -7,6 +7,17 @@ void test_stunt_dict_handles_non_existent_keys(void);
 void test_stunt_dict_handles_duplicate_keys(void);
 void test_stunt_dict_handles_empty_values(void);
 void test_stunt_dict_handles_special_characters_in_values(void);
+void test_stunt_dict_survives_growth_and_removal(void);
+void test_stunt_dict_uses_caller_arena(void);
+void test_stunt_dict_reuses_growable_arena_chunks(void);
+void test_stunt_dict_clears_only_filled_arena_buckets(void);
+void test_stunt_dict_stores_borrowed_values_without_copying(void);
+void test_stunt_dict_sets_values_with_known_lengths(void);
+void test_stunt_dict_gets_values_by_key_slice(void);
+void test_stunt_dict_tracks_content_generation(void);
+void test_stunt_dict_falls_back_to_parent(void);
+void test_stunt_dict_saves_and_loads_blobs(void);
+void test_stunt_dict_rejects_malformed_blobs(void);
 
 int main(void) {
     printf("Running simplet_dictionary tests...\n");
@@ -29,6 +40,39 @@ int main(void) {
     test_stunt_dict_handles_special_characters_in_values();
     printf("✓ test_stunt_dict_handles_special_characters_in_values\n");
 
+    test_stunt_dict_survives_growth_and_removal();
+    printf("✓ test_stunt_dict_survives_growth_and_removal\n");
+
+    test_stunt_dict_uses_caller_arena();
+    printf("✓ test_stunt_dict_uses_caller_arena\n");
+
+    test_stunt_dict_reuses_growable_arena_chunks();
+    printf("✓ test_stunt_dict_reuses_growable_arena_chunks\n");
+
+    test_stunt_dict_clears_only_filled_arena_buckets();
+    printf("✓ test_stunt_dict_clears_only_filled_arena_buckets\n");
+
+    test_stunt_dict_stores_borrowed_values_without_copying();
+    printf("✓ test_stunt_dict_stores_borrowed_values_without_copying\n");
+
+    test_stunt_dict_sets_values_with_known_lengths();
+    printf("✓ test_stunt_dict_sets_values_with_known_lengths\n");
+
+    test_stunt_dict_gets_values_by_key_slice();
+    printf("✓ test_stunt_dict_gets_values_by_key_slice\n");
+
+    test_stunt_dict_tracks_content_generation();
+    printf("✓ test_stunt_dict_tracks_content_generation\n");
+
+    test_stunt_dict_falls_back_to_parent();
+    printf("✓ test_stunt_dict_falls_back_to_parent\n");
+
+    test_stunt_dict_saves_and_loads_blobs();
+    printf("✓ test_stunt_dict_saves_and_loads_blobs\n");
+
+    test_stunt_dict_rejects_malformed_blobs();
+    printf("✓ test_stunt_dict_rejects_malformed_blobs\n");
+
     printf("\nAll tests passed!\n");
     return 0;
 }
\ No newline at end of file
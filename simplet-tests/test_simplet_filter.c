@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_filter.h"
+#include "test_support.h"
+
+TEST_CASE(simplet_filter_escapes_values, "[simplet_filter]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "name", "<b>Tom & \"Jerry\"</b> 'x'");
+    simplet_dictionary_set(dict, "query", "a b/c?d=é&x~_.-");
+    simplet_dictionary_set(dict, "note", "say \"hi\"\\\n\t\x01");
+    simplet_dictionary_set(dict, "plain", "nothing to escape");
+
+    assert_renders_all_paths("{{ name | html }}", dict, "&lt;b&gt;Tom &amp; &quot;Jerry&quot;&lt;/b&gt; &#39;x&#39;");
+    assert_renders_all_paths("{{name|html}}", dict, "&lt;b&gt;Tom &amp; &quot;Jerry&quot;&lt;/b&gt; &#39;x&#39;");
+    assert_renders_all_paths("?q={{ query | url }}", dict, "?q=a%20b%2Fc%3Fd%3D%C3%A9%26x~_.-");
+    assert_renders_all_paths("\"{{ note | json }}\"", dict, "\"say \\\"hi\\\"\\\\\\n\\t\\u0001\"");
+    assert_renders_all_paths("{{ plain | html }}/{{ plain | url }}", dict, "nothing to escape/nothing%20to%20escape");
+
+    // Unfiltered placeholders are unchanged, missing values render nothing
+    assert_renders_all_paths("{{ name }}", dict, "<b>Tom & \"Jerry\"</b> 'x'");
+    assert_renders_all_paths("[{{ missing | html }}]", dict, "[]");
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_filter_keeps_unknown_names_as_keys, "[simplet_filter]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "a|upper", "whole key");
+    simplet_dictionary_set(dict, "a", "<a>");
+
+    // Only a known name makes a filter; anything else is the key it always was
+    assert_renders_all_paths("{{a|upper}}", dict, "whole key");
+    assert_renders_all_paths("{{ a | html | url }}", dict, "");
+    assert_renders_all_paths("{{ | html }}", dict, "");
+    assert_renders_all_paths("{{ a | HTML }}", dict, "");
+    assert_renders_all_paths("{{ a |html}}", dict, "&lt;a&gt;");
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_filter_matches_across_render_paths, "[simplet_filter]") {
+    static const char page[] = "<a href=\"/s?q={{ q | url }}\" title=\"{{ q | html }}\">{{q}}</a>"
+                               "<script>var q = \"{{ q | json }}\";</script>";
+    static const char *values[] = { "plain", "<&>", "", "\"quoted\" \\ \n line", "a b c d e f g h i j k l m n o p" };
+
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_template_t *compiled = compile_simplet_template(page);
+    simplet_incremental_t *incremental = create_simplet_incremental(compiled);
+    assert(dict != NULL && compiled != NULL && incremental != NULL);
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        simplet_dictionary_set(dict, "q", values[i]);
+        char *expected = simplet_render_html((char *)page, dict);
+
+        char *rendered = simplet_template_render(compiled, dict);
+        assert(strcmp(rendered, expected) == 0);
+        free(rendered);
+
+        assert(simplet_render_length(compiled, dict) == strlen(expected));
+
+        static char buffer[512];
+        size_t needed = 0;
+        assert(simplet_render_into(buffer, sizeof(buffer), compiled, dict, &needed) == SUCCESS);
+        assert(needed == strlen(expected) && strcmp(buffer, expected) == 0);
+
+        buffer[0] = '\0';
+        assert(simplet_render_to_sink(compiled, dict, append_sink, buffer) == SUCCESS);
+        assert(strcmp(buffer, expected) == 0);
+
+        // Stream fed one byte at a time
+        buffer[0] = '\0';
+        simplet_stream_t *stream = create_simplet_stream(dict, append_sink, buffer);
+        for (size_t b = 0; b < strlen(page); b++) simplet_stream_feed(stream, page + b, 1);
+        assert(simplet_stream_finish(stream) == SUCCESS);
+        destroy_simplet_stream(stream);
+        assert(strcmp(buffer, expected) == 0);
+
+        // Incremental pages compare and patch escaped text
+        assert(simplet_incremental_update(incremental, dict, NULL, 0, NULL) != ERROR_NO_MEMORY);
+        assert(strcmp(simplet_incremental_output(incremental, NULL), expected) == 0);
+
+        free(expected);
+    }
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
+
+/* Byte-at-a-time reference escaping */
+static size_t reference_escape(simplet_filter_t filter, const unsigned char *text, size_t length, char *out) {
+    size_t written = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = text[i];
+        if (filter == SIMPLET_FILTER_HTML) {
+            const char *named = c == '&' ? "&amp;" : c == '<' ? "&lt;" : c == '>' ? "&gt;" :
+                                c == '"' ? "&quot;" : c == '\'' ? "&#39;" : NULL;
+            if (named) {
+                written += (size_t)sprintf(out + written, "%s", named);
+                continue;
+            }
+        } else if (filter == SIMPLET_FILTER_JSON) {
+            if (c == '"' || c == '\\') {
+                written += (size_t)sprintf(out + written, "\\%c", c);
+                continue;
+            }
+            if (c < 0x20) {
+                const char *named = c == '\b' ? "\\b" : c == '\f' ? "\\f" : c == '\n' ? "\\n" :
+                                    c == '\r' ? "\\r" : c == '\t' ? "\\t" : NULL;
+                written += named ? (size_t)sprintf(out + written, "%s", named)
+                                 : (size_t)sprintf(out + written, "\\u%04X", c);
+                continue;
+            }
+        } else if (filter == SIMPLET_FILTER_URL) {
+            int unreserved = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                             c == '-' || c == '.' || c == '_' || c == '~';
+            if (!unreserved) {
+                written += (size_t)sprintf(out + written, "%%%02X", c);
+                continue;
+            }
+        }
+        out[written++] = (char)c;
+    }
+    return written;
+}
+
+TEST_CASE(simplet_filter_kernels_match_reference, "[simplet_filter]") {
+    static const unsigned char alphabet[] = "abcXYZ09 -_.~&<>\"'\\/\n\t\x01\x1f\x7f\x80\xc3\xa9\xff";
+    static const simplet_filter_t filters[] = {
+        SIMPLET_FILTER_NONE, SIMPLET_FILTER_HTML, SIMPLET_FILTER_URL, SIMPLET_FILTER_JSON
+    };
+    unsigned char text[97];
+    char expected[97 * SIMPLET_FILTER_MAX_EXPANSION];
+    char escaped[97 * SIMPLET_FILTER_MAX_EXPANSION];
+
+    srand(16);
+    for (int round = 0; round < 2000; round++) {
+        // Mostly plain text so the vector paths see long clean runs
+        size_t length = (size_t)(rand() % (int)sizeof(text));
+        for (size_t i = 0; i < length; i++) {
+            text[i] = rand() % 8 == 0 ? alphabet[rand() % (int)(sizeof(alphabet) - 1)] : (unsigned char)('a' + rand() % 26);
+        }
+
+        for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+            size_t reference = reference_escape(filters[f], text, length, expected);
+            assert(simplet_escaped_length(filters[f], (const char *)text, length) == reference);
+            assert(simplet_escape(filters[f], (const char *)text, length, escaped) == reference);
+            assert(memcmp(escaped, expected, reference) == 0);
+        }
+    }
+
+    // Special byte at every offset of a block
+    for (size_t at = 0; at < 40; at++) {
+        memset(text, 'a', 40);
+        text[at] = '<';
+        assert(simplet_escaped_length(SIMPLET_FILTER_HTML, (const char *)text, 40) == 43);
+        text[at] = '\x02';
+        assert(simplet_escaped_length(SIMPLET_FILTER_JSON, (const char *)text, 40) == 45);
+    }
+}
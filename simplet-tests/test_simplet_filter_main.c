@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_filter.c
+void test_simplet_filter_escapes_values(void);
+void test_simplet_filter_keeps_unknown_names_as_keys(void);
+void test_simplet_filter_matches_across_render_paths(void);
+void test_simplet_filter_kernels_match_reference(void);
+
+int main(void) {
+    printf("Running simplet_filter tests...\n");
+
+    test_simplet_filter_escapes_values();
+    printf("✓ test_simplet_filter_escapes_values\n");
+
+    test_simplet_filter_keeps_unknown_names_as_keys();
+    printf("✓ test_simplet_filter_keeps_unknown_names_as_keys\n");
+
+    test_simplet_filter_matches_across_render_paths();
+    printf("✓ test_simplet_filter_matches_across_render_paths\n");
+
+    test_simplet_filter_kernels_match_reference();
+    printf("✓ test_simplet_filter_kernels_match_reference\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_incremental.h"
+#include "simplet_dictionary.h"
+
+/* Checks the incremental page against a full render of the same template */
+static void assert_matches_full_render(const simplet_incremental_t* incremental, const simplet_template_t* compiled,
+                                       const simplet_dictionary_t* dict) {
+    char* expected = simplet_template_render(compiled, dict);
+    size_t length = 0;
+    const char* page = simplet_incremental_output(incremental, &length);
+    assert(page != NULL);
+    assert(strcmp(expected, page) == 0);
+    assert(length == strlen(expected));
+    free(expected);
+}
+
+TEST_CASE(simplet_incremental_rewrites_changed_values, "[simplet_incremental]") {
+    simplet_template_t* compiled = compile_simplet_template(
+        "<p>T={{temp}}C</p><p>H={{humidity}}%</p><p>{{temp}}</p><p>{{missing}}</p>");
+    simplet_incremental_t* incremental = create_simplet_incremental(compiled);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    assert(incremental != NULL);
+    assert(simplet_incremental_output(incremental, NULL) == NULL);
+
+    simplet_dictionary_set(dict, "temp", "21.5");
+    simplet_dictionary_set(dict, "humidity", "40");
+
+    simplet_change_t changes[8];
+    size_t count = 99;
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 0);
+    assert_matches_full_render(incremental, compiled, dict);
+
+    // Same length, rewritten in place
+    simplet_dictionary_set(dict, "humidity", "41");
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 1);
+    assert(changes[0].placeholder == 1);
+    assert(strcmp(changes[0].key, "humidity") == 0);
+    assert(changes[0].length == 2 && memcmp(changes[0].value, "41", 2) == 0);
+    assert_matches_full_render(incremental, compiled, dict);
+
+    // Longer, then shorter values move the rest of the page
+    simplet_dictionary_set(dict, "temp", "-104.25");
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 2);
+    assert(changes[0].placeholder == 0 && changes[1].placeholder == 2);
+    assert_matches_full_render(incremental, compiled, dict);
+    const char* page = simplet_incremental_output(incremental, NULL);
+    assert(memcmp(page + changes[1].offset, "-104.25", 7) == 0);
+
+    simplet_dictionary_set(dict, "temp", "7");
+    simplet_dictionary_set(dict, "humidity", "100");
+    simplet_dictionary_set(dict, "missing", "now here");
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 4);
+    assert_matches_full_render(incremental, compiled, dict);
+
+    simplet_dictionary_remove(dict, "missing");
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 1);
+    assert(changes[0].placeholder == 3 && changes[0].length == 0);
+    assert_matches_full_render(incremental, compiled, dict);
+
+    // Nothing changed
+    simplet_dictionary_set(dict, "temp", "7");
+    assert(simplet_incremental_update(incremental, dict, changes, 8, &count) == SUCCESS);
+    assert(count == 0);
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_incremental_reports_overflowing_changes, "[simplet_incremental]") {
+    simplet_template_t* compiled = compile_simplet_template("{{a}}-{{b}}-{{c}}");
+    simplet_incremental_t* incremental = create_simplet_incremental(compiled);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+
+    assert(simplet_incremental_render(incremental, dict) == SUCCESS);
+    assert(strcmp(simplet_incremental_output(incremental, NULL), "--") == 0);
+
+    simplet_dictionary_set(dict, "a", "1");
+    simplet_dictionary_set(dict, "b", "22");
+    simplet_dictionary_set(dict, "c", "333");
+
+    simplet_change_t changes[2];
+    size_t count = 0;
+    assert(simplet_incremental_update(incremental, dict, changes, 2, &count) == ERROR_BUFFER_TOO_SMALL);
+    assert(count == 3);
+    assert(changes[0].placeholder == 0 && changes[1].placeholder == 1);
+    assert(strcmp(simplet_incremental_output(incremental, NULL), "1-22-333") == 0);
+
+    // Count only, and switching dictionaries
+    simplet_dictionary_t* other = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(other, "a", "1");
+    assert(simplet_incremental_update(incremental, other, NULL, 0, &count) == ERROR_BUFFER_TOO_SMALL);
+    assert(count == 2);
+    assert_matches_full_render(incremental, compiled, other);
+
+    assert(simplet_incremental_update(incremental, NULL, NULL, 0, &count) == ERROR_BUFFER_TOO_SMALL);
+    assert(count == 1);
+    assert(strcmp(simplet_incremental_output(incremental, NULL), "--") == 0);
+
+    assert(create_simplet_incremental(NULL) == NULL);
+    assert(simplet_incremental_update(NULL, dict, NULL, 0, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_incremental_update(incremental, dict, NULL, 1, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_incremental_render(NULL, dict) == ERROR_NULL_PARAM);
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_dictionary(other);
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_incremental_matches_full_render_under_random_updates, "[simplet_incremental]") {
+    static const char* keys[] = { "a", "b", "c", "d" };
+    simplet_template_t* compiled = compile_simplet_template("<{{a}}|{{b}}|{{a}}{{c}}|x{{d}}y{{b}}>");
+    simplet_incremental_t* incremental = create_simplet_incremental(compiled);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_change_t changes[6];
+
+    srand(1234);
+    for (int round = 0; round < 500; round++) {
+        const char* key = keys[rand() % 4];
+        int action = rand() % 4;
+        if (action == 0) {
+            simplet_dictionary_remove(dict, key);
+        } else {
+            char value[32];
+            size_t length = (size_t)(rand() % 12);
+            for (size_t i = 0; i < length; i++) value[i] = (char)('a' + rand() % 3);
+            value[length] = '\0';
+            simplet_dictionary_set(dict, key, value);
+        }
+
+        assert(simplet_incremental_update(incremental, dict, changes, 6, NULL) == SUCCESS);
+        assert_matches_full_render(incremental, compiled, dict);
+    }
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+// Writes as many bytes as the size_t behind context, in pieces
+static void write_repeated(void* context, simplet_value_writer_t* writer) {
+    size_t remaining = *(const size_t*)context;
+    char piece[100];
+    memset(piece, '<', sizeof(piece));
+    while (remaining > 0) {
+        size_t take = remaining < sizeof(piece) ? remaining : sizeof(piece);
+        simplet_value_write(writer, piece, take);
+        remaining -= take;
+    }
+}
+
+TEST_CASE(simplet_incremental_keeps_long_provider_output, "[simplet_incremental]") {
+    simplet_template_t* compiled = compile_simplet_template("[{{long}}|{{ long | html }}|{{n}}]");
+    simplet_incremental_t* incremental = create_simplet_incremental(compiled);
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_change_t changes[3];
+
+    // Outputs past a stored value's limit are placed whole, growing and shrinking
+    static const size_t sizes[] = { 0, 10, MAX_VALUE_SIZE + 500, 3 * MAX_VALUE_SIZE, 7 };
+    size_t size = 0;
+    simplet_dictionary_set_provider(dict, "long", write_repeated, &size);
+    simplet_dictionary_set_int(dict, "n", 42);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size = sizes[i];
+        simplet_dictionary_touch(dict);
+        assert(simplet_incremental_update(incremental, dict, changes, 3, NULL) == SUCCESS);
+        assert_matches_full_render(incremental, compiled, dict);
+    }
+
+    assert(simplet_incremental_render(incremental, dict) == SUCCESS);
+    assert_matches_full_render(incremental, compiled, dict);
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
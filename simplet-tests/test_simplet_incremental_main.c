@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_incremental.c
+void test_simplet_incremental_rewrites_changed_values(void);
+void test_simplet_incremental_reports_overflowing_changes(void);
+void test_simplet_incremental_matches_full_render_under_random_updates(void);
+void test_simplet_incremental_keeps_long_provider_output(void);
+
+int main(void) {
+    printf("Running simplet_incremental tests...\n");
+
+    test_simplet_incremental_rewrites_changed_values();
+    printf("✓ test_simplet_incremental_rewrites_changed_values\n");
+
+    test_simplet_incremental_reports_overflowing_changes();
+    printf("✓ test_simplet_incremental_reports_overflowing_changes\n");
+
+    test_simplet_incremental_matches_full_render_under_random_updates();
+    printf("✓ test_simplet_incremental_matches_full_render_under_random_updates\n");
+
+    test_simplet_incremental_keeps_long_provider_output();
+    printf("✓ test_simplet_incremental_keeps_long_provider_output\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_instrument.h"
+#include "simplet_dictionary.h"
+#include "simplet_cache.h"
+
+static size_t hook_mallocs = 0;
+static size_t hook_reallocs = 0;
+static size_t hook_frees = 0;
+
+static void* counting_malloc(size_t size) {
+    hook_mallocs++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* memory, size_t size) {
+    hook_reallocs++;
+    return realloc(memory, size);
+}
+
+static void counting_free(void* memory) {
+    hook_frees++;
+    free(memory);
+}
+
+// Allocations left to fail before failing_malloc passes them through
+static size_t failures_pending = 0;
+
+static void* failing_malloc(size_t size) {
+    if (failures_pending > 0) {
+        failures_pending--;
+        return NULL;
+    }
+    return malloc(size);
+}
+
+typedef struct {
+    int begins;
+    int ends;
+    size_t last_length;
+} observer_log_t;
+
+static void record_render(void* context, simplet_render_event_t event, size_t length) {
+    observer_log_t* log = context;
+    if (event == SIMPLET_RENDER_BEGIN) {
+        assert(log->begins == log->ends);
+        assert(length == 0);
+        log->begins++;
+    } else {
+        assert(log->begins == log->ends + 1);
+        log->ends++;
+        log->last_length = length;
+    }
+}
+
+TEST_CASE(simplet_instrument_routes_allocations_through_hooks, "[simplet_instrument]") {
+    simplet_allocator_t allocator = { counting_malloc, counting_realloc, counting_free };
+    simplet_set_allocator(&allocator);
+    simplet_reset_stats();
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_TINY, true);
+    for (int i = 0; i < 40; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(simplet_dictionary_set(dict, key, "value") == SUCCESS);
+    }
+
+    char* page = simplet_render_html("<b>{{key1}}</b>", dict);
+    assert(strcmp(page, "<b>value</b>") == 0);
+    simplet_free(page);
+
+    simplet_template_t* compiled = compile_simplet_template("{{key2}}{{key3}}");
+    page = simplet_template_render(compiled, dict);
+    assert(strcmp(page, "valuevalue") == 0);
+    simplet_free(page);
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+
+    assert(hook_mallocs > 40);   // At least one per stored value
+    assert(hook_mallocs + hook_reallocs >= hook_frees);
+    assert(hook_frees == hook_mallocs);   // Everything allocated was released
+
+    simplet_stats_t stats;
+    simplet_get_stats(&stats);
+    assert(stats.allocations == hook_mallocs);
+    assert(stats.reallocations == hook_reallocs);
+    assert(stats.frees == hook_frees);
+    assert(stats.bytes_requested > 0);
+    assert(stats.dictionary_resizes >= 1);
+
+    simplet_set_allocator(NULL);
+    hook_mallocs = 0;
+    page = simplet_render_html("plain", NULL);
+    simplet_free(page);
+    assert(hook_mallocs == 0);
+}
+
+TEST_CASE(simplet_instrument_counts_renders_and_placeholders, "[simplet_instrument]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_set(dict, "name", "World");
+    simplet_dictionary_set(dict, "empty", "");
+
+    observer_log_t log = { 0 };
+    simplet_set_render_observer(record_render, &log);
+    simplet_reset_stats();
+
+    char* page = simplet_render_html("Hello {{name}}{{missing}}{{empty}}!", dict);
+    assert(strcmp(page, "Hello World!") == 0);
+    simplet_free(page);
+
+    simplet_stats_t stats;
+    simplet_get_stats(&stats);
+    assert(stats.renders == 1);
+    assert(stats.bytes_emitted == 12);
+    assert(stats.placeholders_resolved == 1);
+    assert(stats.placeholders_missed == 2);
+    assert(stats.dictionary_lookups >= 3);
+    assert(stats.dictionary_probes >= 1);
+    assert(stats.dictionary_max_probe >= 1);
+    assert(log.begins == 1 && log.ends == 1);
+    assert(log.last_length == 12);
+
+    // Other entry points report too; measuring does not count placeholders
+    simplet_template_t* compiled = compile_simplet_template("{{name}}");
+    char buffer[16];
+    size_t needed = 0;
+    assert(simplet_render_into(buffer, sizeof(buffer), compiled, dict, &needed) == SUCCESS);
+    assert(simplet_render_into(NULL, 0, compiled, dict, &needed) == ERROR_BUFFER_TOO_SMALL);
+    page = simplet_template_render(compiled, dict);
+    simplet_free(page);
+
+    simplet_get_stats(&stats);
+    assert(stats.renders == 4);
+    assert(stats.bytes_emitted == 12 + 3 * 5);
+    assert(stats.placeholders_resolved == 3);
+    assert(log.ends == 4);
+
+    simplet_set_render_observer(NULL, NULL);
+    page = simplet_render_html("{{name}}", dict);
+    simplet_free(page);
+    assert(log.ends == 4);
+
+    simplet_reset_stats();
+    simplet_get_stats(&stats);
+    assert(stats.renders == 0 && stats.dictionary_lookups == 0 && stats.dictionary_max_probe == 0);
+
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_instrument_cache_skips_failed_renders, "[simplet_instrument]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_set(dict, "name", "World");
+    simplet_template_t* compiled = compile_simplet_template("Hello {{name}}!");
+    simplet_render_cache_t* cache = create_simplet_render_cache(4096);
+    simplet_render_cache_stats_t stats;
+
+    simplet_allocator_t allocator = { failing_malloc, counting_realloc, counting_free };
+    simplet_set_allocator(&allocator);
+
+    // The render's buffer cannot be allocated: nothing is served or cached
+    const char* html = "Hello {{name}}!";
+    failures_pending = 1;
+    assert(simplet_render_cache_html(cache, html, dict, NULL) == NULL);
+    failures_pending = 1;
+    assert(simplet_render_cache_template(cache, compiled, dict, NULL) == NULL);
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.entry_count == 0);
+    assert(stats.misses == 2);
+
+    // Once memory is back, both render again instead of hitting an empty page
+    size_t length = 0;
+    const char* page = simplet_render_cache_html(cache, html, dict, &length);
+    assert(page && strcmp(page, "Hello World!") == 0 && length == 12);
+    page = simplet_render_cache_template(cache, compiled, dict, NULL);
+    assert(page && strcmp(page, "Hello World!") == 0);
+    simplet_render_cache_stats(cache, &stats);
+    assert(stats.entry_count == 2);
+    assert(stats.misses == 4 && stats.hits == 0);
+
+    // The public renders still hand out an empty string
+    failures_pending = 1;
+    char* empty = simplet_template_render(compiled, dict);
+    assert(empty && empty[0] == '\0');
+    simplet_free(empty);
+
+    simplet_set_allocator(NULL);
+    destroy_simplet_render_cache(cache);
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_instrument.c
+void test_simplet_instrument_routes_allocations_through_hooks(void);
+void test_simplet_instrument_counts_renders_and_placeholders(void);
+void test_simplet_instrument_cache_skips_failed_renders(void);
+
+int main(void) {
+    printf("Running simplet_instrument tests...\n");
+
+    test_simplet_instrument_routes_allocations_through_hooks();
+    printf("✓ test_simplet_instrument_routes_allocations_through_hooks\n");
+
+    test_simplet_instrument_counts_renders_and_placeholders();
+    printf("✓ test_simplet_instrument_counts_renders_and_placeholders\n");
+
+    test_simplet_instrument_cache_skips_failed_renders();
+    printf("✓ test_simplet_instrument_cache_skips_failed_renders\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
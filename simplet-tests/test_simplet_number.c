@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "test_support.h"
+
+TEST_CASE(simplet_number_default_formats, "[simplet_number]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+
+    assert(simplet_dictionary_set_int(dict, "zero", 0) == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "negative", -42) == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "min", INT64_MIN) == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "max", INT64_MAX) == SUCCESS);
+    assert(simplet_dictionary_set_uint(dict, "umax", UINT64_MAX) == SUCCESS);
+    assert(simplet_dictionary_set_float(dict, "temp", 21.5) == SUCCESS);
+    assert(simplet_dictionary_set_bool(dict, "on", true) == SUCCESS);
+    assert(simplet_dictionary_set_bool(dict, "off", false) == SUCCESS);
+    assert(simplet_dictionary_set_int(NULL, "x", 1) == ERROR_NULL_PARAM);
+    assert(simplet_dictionary_set_float(dict, NULL, 1.0) == ERROR_NULL_PARAM);
+
+    // Numbers are not strings, and nothing is allocated for them
+    assert(simplet_dictionary_get(dict, "zero") == NULL);
+    assert(simplet_dictionary_contains(dict, "zero"));
+    size_t allocated = simplet_dictionary_allocated_size(dict);
+    assert(simplet_dictionary_set_int(dict, "zero", 123456789) == SUCCESS);
+    assert(simplet_dictionary_set_int(dict, "zero", 0) == SUCCESS);
+    assert(simplet_dictionary_allocated_size(dict) == allocated);
+
+    assert_renders_all_paths("{{zero}} {{negative}} {{min}} {{max}}", dict,
+                   "0 -42 -9223372036854775808 9223372036854775807");
+    assert_renders_all_paths("{{umax}}|{{temp}}|{{on}}|{{off}}", dict, "18446744073709551615|21.5|true|false");
+
+    // Only a false boolean is unset (streams drop block tags, so only whole-template renders)
+    char *result = simplet_render_html("{{?on}}yes{{/on}}{{?off}}no{{/off}}{{^off}}!{{/off}}{{?zero}}0{{/zero}}", dict);
+    assert(strcmp(result, "yes!0") == 0);
+    free(result);
+
+    // Escaping filters apply to the formatted text
+    assert(simplet_dictionary_set_float(dict, "big", 1e20) == SUCCESS);
+    assert_renders_all_paths("{{ big }}|{{ big | url }}", dict, "1e+20|1e%2B20");
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_number_format_hints, "[simplet_number]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    simplet_dictionary_set_int(dict, "n", 42);
+    simplet_dictionary_set_int(dict, "neg", -7);
+    simplet_dictionary_set_uint(dict, "u", 255);
+    simplet_dictionary_set_float(dict, "t", 21.456);
+    simplet_dictionary_set_bool(dict, "b", true);
+    simplet_dictionary_set(dict, "s", "text");
+
+    assert_renders_all_paths("{{ n | %05d }} {{n|%+d}} {{ n | %i }} {{ neg | %4d }}", dict, "00042 +42 42   -7");
+    assert_renders_all_paths("{{ u | %x }} {{ u | %X }} {{ u | %04x }} {{ u | %u }}", dict, "ff FF 00ff 255");
+    assert_renders_all_paths("{{ t | %.1f }} {{ t | %8.3f }} {{ t | %.2e }} {{ t | %g }}", dict, "21.5   21.456 2.15e+01 21.456");
+    assert_renders_all_paths("{{ n | %.2f }} {{ t | %d }} {{ b | %d }}", dict, "42.00 21 1");
+
+    // Strings ignore hints
+    assert_renders_all_paths("{{ s | %05d }}", dict, "text");
+
+    // Values a conversion cannot hold use the default format
+    simplet_dictionary_set_float(dict, "negative", -1.5);
+    simplet_dictionary_set_uint(dict, "huge", UINT64_MAX);
+    assert_renders_all_paths("{{ negative | %u }} {{ huge | %d }}", dict, "-1.5 18446744073709551615");
+
+    // Anything else after "|" is part of the key, as with unknown filter names
+    simplet_dictionary_set(dict, "n | %s", "literal key");
+    assert_renders_all_paths("[{{ n | %s }}][{{ n | %n }}][{{ n | %.16f }}][{{ n | %32d }}][{{ n | % }}]", dict,
+                   "[literal key][][][][]");
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_number_generation_and_kinds, "[simplet_number]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+
+    assert(simplet_dictionary_set_int(dict, "heap", 1000) == SUCCESS);
+    uint32_t generation = simplet_dictionary_generation(dict);
+    size_t allocated = simplet_dictionary_allocated_size(dict);
+
+    // The same reading again is not a change
+    assert(simplet_dictionary_set_int(dict, "heap", 1000) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) == generation);
+    assert(simplet_dictionary_set_uint(dict, "heap", 1000) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    // Switching between strings and numbers frees the string
+    assert(simplet_dictionary_set(dict, "heap", "unknown") == SUCCESS);
+    assert(strcmp(simplet_dictionary_get(dict, "heap"), "unknown") == 0);
+    assert(simplet_dictionary_set_float(dict, "heap", 0.25) == SUCCESS);
+    assert(simplet_dictionary_get(dict, "heap") == NULL);
+    assert(simplet_dictionary_allocated_size(dict) == allocated);
+
+    // Incremental updates rewrite only the numbers that changed
+    simplet_dictionary_set_int(dict, "rssi", -70);
+    simplet_template_t *compiled = compile_simplet_template("heap={{heap}} rssi={{ rssi | %4d }}");
+    simplet_incremental_t *page = create_simplet_incremental(compiled);
+    assert(simplet_incremental_render(page, dict) == SUCCESS);
+    assert(strcmp(simplet_incremental_output(page, NULL), "heap=0.25 rssi= -70") == 0);
+
+    simplet_change_t changes[2];
+    size_t change_count = 0;
+    simplet_dictionary_set_int(dict, "rssi", -101);
+    assert(simplet_incremental_update(page, dict, changes, 2, &change_count) == SUCCESS);
+    assert(change_count == 1 && changes[0].placeholder == 1);
+    assert(strcmp(simplet_incremental_output(page, NULL), "heap=0.25 rssi=-101") == 0);
+
+    destroy_simplet_incremental(page);
+    destroy_simplet_template(compiled);
+
+    // Copies carry numbers over
+    simplet_dictionary_t *copy = copy_simplet_dictionary(dict);
+    char *result = simplet_render_html("{{heap}}/{{rssi}}", copy);
+    assert(strcmp(result, "0.25/-101") == 0);
+    free(result);
+    destroy_simplet_dictionary(copy);
+
+    destroy_simplet_dictionary(dict);
+}
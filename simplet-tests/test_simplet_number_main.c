@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_number.c
+void test_simplet_number_default_formats(void);
+void test_simplet_number_format_hints(void);
+void test_simplet_number_generation_and_kinds(void);
+
+int main(void) {
+    printf("Running simplet_number tests...\n");
+
+    test_simplet_number_default_formats();
+    printf("✓ test_simplet_number_default_formats\n");
+
+    test_simplet_number_format_hints();
+    printf("✓ test_simplet_number_format_hints\n");
+
+    test_simplet_number_generation_and_kinds();
+    printf("✓ test_simplet_number_generation_and_kinds\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
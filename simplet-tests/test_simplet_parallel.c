@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+
+#define SECTIONS 30
+
+// A page of repeated sections with values, filters, lists and conditionals
+static char* build_page(void) {
+    static const char *section =
+        "<section id=\"s%d\"><h2>{{title}} %d</h2><p>{{ body | html }}</p>"
+        "<ul>{{#rows}}<li>{{name}}</li>{{/rows}}</ul>{{?alert}}<b>{{alert}}</b>{{/alert}}"
+        "<span>{{ load | %%.2f }}</span></section>\n";
+    size_t capacity = SECTIONS * 256;
+    char *page = malloc(capacity);
+    size_t length = 0;
+    for (int i = 0; i < SECTIONS; i++) {
+        length += (size_t)snprintf(page + length, capacity - length, section, i, i);
+    }
+    assert(length < 8192);
+    return page;
+}
+
+static simplet_dictionary_t *items[3];
+
+static simplet_dictionary_t* build_dictionary(void) {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    const char *names[3] = {"pump", "fan", "<lamp>"};
+    for (int i = 0; i < 3; i++) {
+        items[i] = create_simplet_dictionary(SIZE_TINY, true);
+        simplet_dictionary_set(items[i], "name", names[i]);
+    }
+    simplet_dictionary_set(dict, "title", "Zone");
+    simplet_dictionary_set(dict, "body", "Temperature <ok> & stable");
+    simplet_dictionary_set(dict, "alert", "check filter");
+    simplet_dictionary_set_float(dict, "load", 0.75);
+    simplet_dictionary_set_list(dict, "rows", items, 3);
+    return dict;
+}
+
+static void destroy_dictionary(simplet_dictionary_t *dict) {
+    destroy_simplet_dictionary(dict);
+    for (int i = 0; i < 3; i++) destroy_simplet_dictionary(items[i]);
+}
+
+// Runs tasks last to first on the calling thread and counts the runs
+typedef struct {
+    size_t runs;
+    size_t tasks;
+} counting_executor_t;
+
+static void run_backwards(void *context, simplet_task_fn task, void *argument, size_t count) {
+    counting_executor_t *counting = context;
+    counting->runs++;
+    counting->tasks += count;
+    for (size_t i = count; i > 0; i--) task(argument, i - 1);
+}
+
+TEST_CASE(simplet_parallel_matches_serial, "[simplet_parallel]") {
+    char *page = build_page();
+    simplet_dictionary_t *dict = build_dictionary();
+    simplet_template_t *compiled = compile_simplet_template(page);
+
+    char *expected = simplet_render_html(page, dict);
+    assert(strstr(expected, "<section id=\"s29\"><h2>Zone 29</h2><p>Temperature &lt;ok&gt; &amp; stable</p>"
+                            "<ul><li>pump</li><li>fan</li><li><lamp></li></ul><b>check filter</b>"
+                            "<span>0.75</span></section>\n") != NULL);
+
+    size_t workers[] = {2, 3, 4, SIMPLET_MAX_WORKERS, 1000};
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        simplet_set_parallel_render(workers[i], 1024);
+
+        char *result = simplet_render_html(page, dict);
+        assert(strcmp(result, expected) == 0);
+        free(result);
+
+        result = simplet_render_html_n(page, strlen(page), dict);
+        assert(strcmp(result, expected) == 0);
+        free(result);
+
+        result = simplet_template_render(compiled, dict);
+        assert(strcmp(result, expected) == 0);
+        free(result);
+    }
+
+    // Without values and without a dictionary
+    simplet_set_parallel_render(4, 1024);
+    char *result = simplet_render_html(page, NULL);
+    simplet_set_parallel_render(0, 0);
+    char *serial = simplet_render_html(page, NULL);
+    assert(strcmp(result, serial) == 0);
+    free(result);
+    free(serial);
+
+    free(expected);
+    destroy_simplet_template(compiled);
+    destroy_dictionary(dict);
+    free(page);
+}
+
+TEST_CASE(simplet_parallel_custom_executor, "[simplet_parallel]") {
+    char *page = build_page();
+    simplet_dictionary_t *dict = build_dictionary();
+    char *expected = simplet_render_html(page, dict);
+
+    simplet_template_t *compiled = compile_simplet_template(page);
+    simplet_template_t *small = compile_simplet_template("<p>{{title}}</p>");
+
+    counting_executor_t counting = {0, 0};
+    simplet_executor_t executor = { run_backwards, &counting };
+    simplet_set_executor(&executor);
+    simplet_set_parallel_render(4, 1024);
+
+    // Segments are rendered and joined: one run of four tasks
+    char *result = simplet_template_render(compiled, dict);
+    assert(strcmp(result, expected) == 0);
+    assert(counting.runs == 1 && counting.tasks == 4);
+    free(result);
+
+    // Templates below the threshold and uncompiled templates stay on the calling thread
+    result = simplet_template_render(small, dict);
+    assert(strcmp(result, "<p>Zone</p>") == 0);
+    free(result);
+    result = simplet_render_html(page, dict);
+    assert(strcmp(result, expected) == 0);
+    free(result);
+    assert(counting.runs == 1);
+
+    // Batches run on the same executor
+    simplet_template_t *row = compile_simplet_template("[{{title}}]");
+    const simplet_dictionary_t *rows[3] = {dict, NULL, dict};
+    size_t length = 0;
+    assert(simplet_render_batch(row, rows, 3, 3, &result, &length) == SUCCESS);
+    assert(strcmp(result, "[Zone][][Zone]") == 0 && length == 14);
+    assert(counting.runs == 2 && counting.tasks == 7);
+    free(result);
+    destroy_simplet_template(row);
+
+    // NULL restores the built-in executor; 0 workers disables splitting
+    simplet_set_executor(NULL);
+    result = simplet_template_render(compiled, dict);
+    assert(strcmp(result, expected) == 0);
+    assert(counting.runs == 2);
+    free(result);
+    simplet_set_parallel_render(0, 0);
+
+    destroy_simplet_template(small);
+    destroy_simplet_template(compiled);
+    free(expected);
+    destroy_dictionary(dict);
+    free(page);
+}
+
+static atomic_int calls[100];
+
+static void count_call(void *argument, size_t index) {
+    assert(argument == calls);
+    atomic_fetch_add(&calls[index], 1);
+}
+
+TEST_CASE(simplet_parallel_thread_executor, "[simplet_parallel]") {
+    const simplet_executor_t *executor = simplet_thread_executor();
+    assert(executor && executor->run);
+
+    // Without a pool, then with pools of several sizes, then after stopping it:
+    // every task runs exactly once, also with more tasks than workers
+    size_t pools[] = {0, 4, 2, SIMPLET_MAX_WORKERS, 0};
+    size_t counts[] = {0, 1, 5, 100};
+    for (size_t p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+        simplet_set_parallel_render(pools[p], 0);
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            for (int i = 0; i < 100; i++) atomic_store(&calls[i], 0);
+            executor->run(executor->context, count_call, calls, counts[c]);
+            for (size_t i = 0; i < 100; i++) assert(atomic_load(&calls[i]) == (i < counts[c] ? 1 : 0));
+        }
+    }
+}
+
+// Renders a compiled page repeatedly from its own thread
+typedef struct {
+    const simplet_template_t *compiled;
+    const simplet_dictionary_t *dictionary;
+    const char *expected;
+} render_thread_t;
+
+static void* render_main(void *argument) {
+    render_thread_t *thread = argument;
+    for (int i = 0; i < 20; i++) {
+        char *result = simplet_template_render(thread->compiled, thread->dictionary);
+        assert(strcmp(result, thread->expected) == 0);
+        free(result);
+    }
+    return NULL;
+}
+
+TEST_CASE(simplet_parallel_concurrent_renders, "[simplet_parallel]") {
+    char *page = build_page();
+    simplet_dictionary_t *dict = build_dictionary();
+    simplet_template_t *compiled = compile_simplet_template(page);
+    char *expected = simplet_template_render(compiled, dict);
+
+    // Renders that find the pool busy run their segments on their own thread
+    simplet_set_parallel_render(4, 1024);
+    render_thread_t thread = { compiled, dict, expected };
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) assert(pthread_create(&threads[i], NULL, render_main, &thread) == 0);
+    for (int i = 0; i < 4; i++) pthread_join(threads[i], NULL);
+    simplet_set_parallel_render(0, 0);
+
+    free(expected);
+    destroy_simplet_template(compiled);
+    destroy_dictionary(dict);
+    free(page);
+}
+
+// Writes one more character on every call
+static atomic_int provider_calls;
+
+static void write_growing(void *context, simplet_value_writer_t *writer) {
+    (void)context;
+    int count = atomic_fetch_add(&provider_calls, 1) + 1;
+    for (int i = 0; i < count; i++) simplet_value_puts(writer, "x");
+}
+
+TEST_CASE(simplet_parallel_runs_providers_once, "[simplet_parallel]") {
+    char *page = build_page();
+    simplet_dictionary_t *dict = build_dictionary();
+    simplet_dictionary_set_provider(dict, "title", write_growing, NULL);
+    simplet_template_t *compiled = compile_simplet_template(page);
+    simplet_set_parallel_render(4, 1024);
+
+    // Each placeholder is rendered once, so values that change between calls are all kept
+    atomic_store(&provider_calls, 0);
+    char *result = simplet_template_render(compiled, dict);
+    assert(atomic_load(&provider_calls) == SECTIONS);
+    assert(strncmp(result, "<section id=\"s0\"><h2>x", 22) == 0);
+    assert(strstr(result, "<span>0.75</span></section>\n<section id=\"s29\">") != NULL);
+    assert(strcmp(result + strlen(result) - 11, "</section>\n") == 0);
+
+    size_t xs = 0;
+    for (const char *c = result; *c; c++) xs += *c == 'x';
+    assert(xs == SECTIONS * (SECTIONS + 1) / 2);
+    free(result);
+
+    simplet_set_parallel_render(0, 0);
+    destroy_simplet_template(compiled);
+    destroy_dictionary(dict);
+    free(page);
+}
@@ -0,0 +1,30 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_parallel.c
+void test_simplet_parallel_matches_serial(void);
+void test_simplet_parallel_custom_executor(void);
+void test_simplet_parallel_thread_executor(void);
+void test_simplet_parallel_concurrent_renders(void);
+void test_simplet_parallel_runs_providers_once(void);
+
+int main(void) {
+    printf("Running simplet_parallel tests...\n");
+
+    test_simplet_parallel_matches_serial();
+    printf("✓ test_simplet_parallel_matches_serial\n");
+
+    test_simplet_parallel_custom_executor();
+    printf("✓ test_simplet_parallel_custom_executor\n");
+
+    test_simplet_parallel_thread_executor();
+    printf("✓ test_simplet_parallel_thread_executor\n");
+
+    test_simplet_parallel_concurrent_renders();
+    printf("✓ test_simplet_parallel_concurrent_renders\n");
+
+    test_simplet_parallel_runs_providers_once();
+    printf("✓ test_simplet_parallel_runs_providers_once\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
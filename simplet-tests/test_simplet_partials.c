@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_partials.h"
+#include "test_support.h"
+
+TEST_CASE(simplet_partials_render_in_place, "[simplet_partials]") {
+    simplet_partials_t *partials = create_simplet_partials();
+    assert(partials != NULL);
+
+    static const char nav[] = "<nav>{{#links}}<a>{{label}}</a>{{/links}}</nav>";
+    assert(simplet_partials_add(partials, "header", "<header>{{title|html}}</header>{{> nav}}") == SUCCESS);
+    assert(simplet_partials_add_borrowed(partials, "nav", nav, sizeof(nav) - 1) == SUCCESS);
+    assert(simplet_partials_add(partials, "footer", "<footer>{{year}}</footer>") == SUCCESS);
+    assert(partials->count == 3);
+
+    simplet_template_t *page = compile_simplet_template("{{>header}}<main>{{body}}</main>{{ > footer }}");
+    assert(page != NULL && page->partial_count == 2);
+    assert(simplet_partials_link(partials, page) == SUCCESS);
+
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_t *links[2] = { create_simplet_dictionary(4, true), create_simplet_dictionary(4, true) };
+    simplet_dictionary_set(links[0], "label", "Home");
+    simplet_dictionary_set(links[1], "label", "About");
+    simplet_dictionary_set_list(dict, "links", links, 2);
+    simplet_dictionary_set(dict, "title", "A & B");
+    simplet_dictionary_set(dict, "body", "text");
+    simplet_dictionary_set(dict, "year", "2024");
+
+    // Partials see the same dictionary, including loops inside them
+    assert_template_renders(page, dict,
+                            "<header>A &amp; B</header><nav><a>Home</a><a>About</a></nav>"
+                            "<main>text</main><footer>2024</footer>");
+
+    // A partial used inside a loop sees the item first
+    simplet_template_t *list = compile_simplet_template("{{#links}}[{{>footer}}]{{/links}}");
+    simplet_dictionary_set(links[1], "year", "1999");
+    assert(simplet_partials_link(partials, list) == SUCCESS);
+    assert_template_renders(list, dict, "[<footer>2024</footer>][<footer>1999</footer>]");
+
+    // Without a registry partial tags render nothing
+    char *result = simplet_render_html("a{{>header}}b{{> }}", dict);
+    assert(strcmp(result, "ab") == 0);
+    free(result);
+
+    // Templates that include partials are not incremental
+    assert(create_simplet_incremental(page) == NULL);
+
+    destroy_simplet_template(list);
+    destroy_simplet_template(page);
+    destroy_simplet_dictionary(links[0]);
+    destroy_simplet_dictionary(links[1]);
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_partials(partials);
+}
+
+TEST_CASE(simplet_partials_link_and_replace, "[simplet_partials]") {
+    simplet_partials_t *partials = create_simplet_partials();
+    simplet_template_t *page = compile_simplet_template("<{{>missing}}|{{>late}}>");
+
+    // Unknown names render nothing and are reported
+    assert(simplet_partials_link(partials, page) == ERROR_KEY_NOT_FOUND);
+    assert_template_renders(page, NULL, "<|>");
+
+    // A template registered later resolves tags in templates already registered
+    assert(simplet_partials_add(partials, "outer", "({{>late}})") == SUCCESS);
+    assert(simplet_partials_add(partials, "late", "L") == SUCCESS);
+    assert(simplet_partials_link(partials, page) == ERROR_KEY_NOT_FOUND);
+    assert_template_renders(page, NULL, "<|L>");
+    assert_template_renders(simplet_partials_get(partials, "outer"), NULL, "(L)");
+
+    // A replaced template outlives the replacement until the page is linked again
+    assert(simplet_partials_add(partials, "late", "L2") == SUCCESS);
+    assert(partials->count == 2);
+    assert_template_renders(simplet_partials_get(partials, "outer"), NULL, "(L2)");
+    assert_template_renders(page, NULL, "<|L>");
+
+    // Replacing a name relinks the registry; outside templates are linked again
+    simplet_template_t *shared = compile_simplet_template("S");
+    assert(simplet_partials_add_compiled(partials, "late", shared) == SUCCESS);
+    assert(partials->count == 2);
+    assert(simplet_partials_get(partials, "late") == shared);
+    assert_template_renders(simplet_partials_get(partials, "outer"), NULL, "(S)");
+    simplet_partials_link(partials, page);
+    assert_template_renders(page, NULL, "<|S>");
+
+    assert(simplet_partials_get(partials, "nope") == NULL);
+    assert(simplet_partials_get(NULL, "late") == NULL);
+    assert(simplet_partials_add(NULL, "a", "b") == ERROR_NULL_PARAM);
+    assert(simplet_partials_add(partials, "a", NULL) == ERROR_NULL_PARAM);
+    assert(simplet_partials_add_compiled(partials, "a", NULL) == ERROR_NULL_PARAM);
+    assert(simplet_partials_link(partials, NULL) == ERROR_NULL_PARAM);
+
+    char long_name[MAX_KEY_SIZE + 1];
+    memset(long_name, 'n', MAX_KEY_SIZE);
+    long_name[MAX_KEY_SIZE] = '\0';
+    assert(simplet_partials_add(partials, long_name, "x") == ERROR_KEY_TOO_LONG);
+    assert(partials->count == 2);
+
+    destroy_simplet_partials(partials);
+    destroy_simplet_template(shared);
+    destroy_simplet_template(page);
+}
+
+TEST_CASE(simplet_partials_recursion_is_bounded, "[simplet_partials]") {
+    simplet_partials_t *partials = create_simplet_partials();
+    assert(simplet_partials_add(partials, "self", "x{{>self}}") == SUCCESS);
+    assert(simplet_partials_add(partials, "ping", "i{{>pong}}") == SUCCESS);
+    assert(simplet_partials_add(partials, "pong", "o{{>ping}}") == SUCCESS);
+
+    // Each level renders once until SIMPLET_MAX_PARTIAL_DEPTH partials are open
+    char expected[SIMPLET_MAX_PARTIAL_DEPTH + 2];
+    memset(expected, 'x', SIMPLET_MAX_PARTIAL_DEPTH);
+    expected[SIMPLET_MAX_PARTIAL_DEPTH] = '\0';
+
+    simplet_template_t *page = compile_simplet_template("{{>self}}");
+    assert(simplet_partials_link(partials, page) == SUCCESS);
+    assert_template_renders(page, NULL, expected);
+
+    // The template rendered first does not count towards the depth
+    strcat(expected, "x");
+    assert_template_renders(simplet_partials_get(partials, "self"), NULL, expected);
+
+    simplet_template_t *mutual = compile_simplet_template("{{>ping}}");
+    simplet_partials_link(partials, mutual);
+    char *result = simplet_template_render(mutual, NULL);
+    assert(strlen(result) == SIMPLET_MAX_PARTIAL_DEPTH && strncmp(result, "ioio", 4) == 0);
+    free(result);
+
+    destroy_simplet_template(mutual);
+    destroy_simplet_template(page);
+    destroy_simplet_partials(partials);
+}
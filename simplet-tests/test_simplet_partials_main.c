@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_partials.c
+void test_simplet_partials_render_in_place(void);
+void test_simplet_partials_link_and_replace(void);
+void test_simplet_partials_recursion_is_bounded(void);
+
+int main(void) {
+    printf("Running simplet_partials tests...\n");
+
+    test_simplet_partials_render_in_place();
+    printf("✓ test_simplet_partials_render_in_place\n");
+
+    test_simplet_partials_link_and_replace();
+    printf("✓ test_simplet_partials_link_and_replace\n");
+
+    test_simplet_partials_recursion_is_bounded();
+    printf("✓ test_simplet_partials_recursion_is_bounded\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
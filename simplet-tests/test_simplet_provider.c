@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_provider.h"
+#include "test_support.h"
+
+// Provider writing a counter, counting its calls
+typedef struct {
+    int calls;
+    int value;
+} counter_t;
+
+static void write_counter(void *context, simplet_value_writer_t *writer) {
+    counter_t *counter = context;
+    counter->calls++;
+    simplet_value_printf(writer, "%d", counter->value);
+}
+
+static void write_markup(void *context, simplet_value_writer_t *writer) {
+    (void)context;
+    simplet_value_puts(writer, "<b>");
+    simplet_value_write(writer, "&", 1);
+    simplet_value_puts(writer, "</b>");
+}
+
+static void write_nothing(void *context, simplet_value_writer_t *writer) {
+    (void)context;
+    (void)writer;
+}
+
+// Writes one more byte on every call, like a clock ticking between two passes
+static void write_growing(void *context, simplet_value_writer_t *writer) {
+    int *calls = context;
+    (*calls)++;
+    for (int i = 0; i < *calls; i++) {
+        simplet_value_write(writer, "x", 1);
+    }
+}
+
+TEST_CASE(simplet_provider_runs_only_when_rendered, "[simplet_provider]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    counter_t used = { 0, 42 };
+    counter_t unused = { 0, 7 };
+
+    assert(simplet_dictionary_set_provider(dict, "uptime", write_counter, &used) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, "heap", write_counter, &unused) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, "markup", write_markup, NULL) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, NULL, write_markup, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_dictionary_set_provider(dict, "bad", NULL, NULL) == ERROR_NULL_PARAM);
+
+    // Providers are not strings
+    assert(simplet_dictionary_contains(dict, "uptime"));
+    assert(simplet_dictionary_get(dict, "uptime") == NULL);
+
+    char *result = simplet_render_html("up {{uptime}}s {{markup}} {{ markup | html }}", dict);
+    assert(strcmp(result, "up 42s <b>&</b> &lt;b&gt;&amp;&lt;/b&gt;") == 0);
+    free(result);
+    assert(used.calls > 0);
+    assert(unused.calls == 0);
+
+    simplet_template_t *compiled = compile_simplet_template("[{{uptime}}|{{ uptime | url }}]");
+    result = simplet_template_render(compiled, dict);
+    assert(strcmp(result, "[42|42]") == 0);
+    free(result);
+    assert(simplet_render_length(compiled, dict) == strlen("[42|42]"));
+
+    // Sinks and streams run each provider once per placeholder
+    used.calls = 0;
+    char sunk[128] = "";
+    assert(simplet_render_to_sink(compiled, dict, append_sink, sunk) == SUCCESS);
+    assert(strcmp(sunk, "[42|42]") == 0);
+    assert(used.calls == 2);
+
+    sunk[0] = '\0';
+    simplet_stream_t *stream = create_simplet_stream(dict, append_sink, sunk);
+    assert(simplet_stream_feed(stream, "a{{upt", 6) == SUCCESS);
+    assert(simplet_stream_feed(stream, "ime}}b", 6) == SUCCESS);
+    assert(simplet_stream_finish(stream) == SUCCESS);
+    destroy_simplet_stream(stream);
+    assert(strcmp(sunk, "a42b") == 0);
+
+    char small[4];
+    size_t needed = 0;
+    assert(simplet_render_into(small, sizeof(small), compiled, dict, &needed) == ERROR_BUFFER_TOO_SMALL);
+    assert(needed == strlen("[42|42]"));
+    assert(strcmp(small, "[42") == 0);
+
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_provider_formats_long_values, "[simplet_provider]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    char expected[256];
+    memset(expected, 'z', 200);
+    expected[200] = '\0';
+
+    counter_t counter = { 0, 0 };
+    assert(simplet_dictionary_set_provider(dict, "n", write_counter, &counter) == SUCCESS);
+    assert(simplet_dictionary_set_static(dict, "long", expected) == SUCCESS);
+
+    // Formatted output longer than the stack buffer goes through the heap
+    char *result = simplet_render_html("{{n}}", dict);
+    assert(strcmp(result, "0") == 0);
+    free(result);
+
+    counter.value = -123456789;
+    result = simplet_render_html("{{n}}{{long}}", dict);
+    assert(strncmp(result, "-123456789zzz", 13) == 0);
+    assert(strlen(result) == 10 + 200);
+    free(result);
+
+    // Copies keep the provider, and a plain value replaces it
+    simplet_dictionary_t *copy = copy_simplet_dictionary(dict);
+    result = simplet_render_html("{{n}}", copy);
+    assert(strcmp(result, "-123456789") == 0);
+    free(result);
+    assert(simplet_dictionary_set(copy, "n", "plain") == SUCCESS);
+    assert(strcmp(simplet_dictionary_get(copy, "n"), "plain") == 0);
+    assert(simplet_dictionary_remove(dict, "n") == SUCCESS);
+    destroy_simplet_dictionary(copy);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_provider_runs_once_per_placeholder, "[simplet_provider]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    counter_t counter = { 0, 7 };
+    int ticks = 0;
+    assert(simplet_dictionary_set_provider(dict, "p", write_counter, &counter) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, "tick", write_growing, &ticks) == SUCCESS);
+
+    // Pages are rendered in one pass, so a value that changes between runs is written as first produced
+    char *result = simplet_render_html("<{{tick}}>", dict);
+    assert(ticks == 1);
+    assert(strcmp(result, "<x>") == 0);
+    free(result);
+
+    result = simplet_render_html("{{p}}", dict);
+    assert(strcmp(result, "7") == 0);
+    assert(counter.calls == 1);
+    free(result);
+
+    // Blocks test the key without running the provider
+    counter.calls = 0;
+    result = simplet_render_html("{{?p}}[{{p}}]{{/p}}", dict);
+    assert(strcmp(result, "[7]") == 0);
+    assert(counter.calls == 1);
+    free(result);
+
+    counter.calls = 0;
+    simplet_template_t *compiled = compile_simplet_template("{{?p}}[{{p}}]{{/p}}");
+    result = simplet_template_render(compiled, dict);
+    assert(strcmp(result, "[7]") == 0);
+    assert(counter.calls == 1);
+    free(result);
+
+    // A flat template that meets a provider carries on without starting over
+    counter.calls = 0;
+    simplet_template_t *flat = compile_simplet_template("a{{p}}b{{p}}c");
+    result = simplet_template_render(flat, dict);
+    assert(strcmp(result, "a7b7c") == 0);
+    assert(counter.calls == 2);
+    free(result);
+    destroy_simplet_template(flat);
+
+    // Batch rows run it once per row, on one worker or several
+    const simplet_dictionary_t *rows[3] = { dict, dict, dict };
+    for (size_t workers = 1; workers <= 3; workers += 2) {
+        counter.calls = 0;
+        assert(simplet_render_batch(compiled, rows, 3, workers, &result, NULL) == SUCCESS);
+        assert(strcmp(result, "[7][7][7]") == 0);
+        assert(counter.calls == 3);
+        free(result);
+    }
+
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_provider_in_blocks_and_incremental, "[simplet_provider]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(SIZE_SMALL, true);
+    counter_t counter = { 0, 5 };
+    assert(simplet_dictionary_set_provider(dict, "rssi", write_counter, &counter) == SUCCESS);
+    assert(simplet_dictionary_set_provider(dict, "empty", write_nothing, NULL) == SUCCESS);
+
+    // A provider is set even if it writes nothing, as blocks do not run it
+    char *result = simplet_render_html("{{?rssi}}rssi {{rssi}}{{/rssi}}{{?empty}}E{{/empty}}{{^empty}}none{{/empty}}", dict);
+    assert(strcmp(result, "rssi 5E") == 0);
+    free(result);
+
+    simplet_template_t *compiled = compile_simplet_template("RSSI: {{rssi}} dBm");
+    simplet_incremental_t *incremental = create_simplet_incremental(compiled);
+    simplet_change_t changes[2];
+    size_t change_count = 0;
+
+    assert(simplet_incremental_render(incremental, dict) == SUCCESS);
+    assert(strcmp(simplet_incremental_output(incremental, NULL), "RSSI: 5 dBm") == 0);
+
+    // Provider results are not tracked until the dictionary is touched
+    counter.value = -71;
+    assert(simplet_incremental_update(incremental, dict, changes, 2, &change_count) == SUCCESS);
+    assert(change_count == 0);
+
+    simplet_dictionary_touch(dict);
+    assert(simplet_incremental_update(incremental, dict, changes, 2, &change_count) == SUCCESS);
+    assert(change_count == 1);
+    assert(changes[0].length == 3 && strncmp(changes[0].value, "-71", 3) == 0);
+    assert(strcmp(simplet_incremental_output(incremental, NULL), "RSSI: -71 dBm") == 0);
+
+    destroy_simplet_incremental(incremental);
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+}
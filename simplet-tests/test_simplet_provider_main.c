@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_provider.c
+void test_simplet_provider_runs_only_when_rendered(void);
+void test_simplet_provider_formats_long_values(void);
+void test_simplet_provider_runs_once_per_placeholder(void);
+void test_simplet_provider_in_blocks_and_incremental(void);
+
+int main(void) {
+    printf("Running simplet_provider tests...\n");
+
+    test_simplet_provider_runs_only_when_rendered();
+    printf("✓ test_simplet_provider_runs_only_when_rendered\n");
+
+    test_simplet_provider_formats_long_values();
+    printf("✓ test_simplet_provider_formats_long_values\n");
+
+    test_simplet_provider_runs_once_per_placeholder();
+    printf("✓ test_simplet_provider_runs_once_per_placeholder\n");
+
+    test_simplet_provider_in_blocks_and_incremental();
+    printf("✓ test_simplet_provider_in_blocks_and_incremental\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "test_support.h"
+
+static simplet_dictionary_t* make_row(const char *name, const char *state) {
+    simplet_dictionary_t *row = create_simplet_dictionary(4, true);
+    assert(row != NULL);
+    simplet_dictionary_set(row, "name", name);
+    if (state) simplet_dictionary_set(row, "state", state);
+    return row;
+}
+
+TEST_CASE(simplet_sections_repeat_per_list_item, "[simplet_sections]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_t *rows[3] = {
+        make_row("pump", "on"), make_row("fan", NULL), make_row("<lamp>", "off"),
+    };
+    simplet_dictionary_set(dict, "state", "unknown");
+    simplet_dictionary_set(dict, "site", "lab");
+    assert(simplet_dictionary_set_list(dict, "rows", rows, 3) == SUCCESS);
+
+    // Item keys first, then the enclosing dictionary
+    assert_renders_all_paths("<ul>{{#rows}}<li>{{name|html}}={{state}}@{{site}}</li>{{/rows}}</ul>", dict,
+                   "<ul><li>pump=on@lab</li><li>fan=unknown@lab</li><li>&lt;lamp&gt;=off@lab</li></ul>");
+    assert_renders_all_paths("{{ # rows }}[{{name}}]{{ / rows }}", dict, "[pump][fan][<lamp>]");
+
+    // Nested lists walk each item's own list
+    simplet_dictionary_t *ports[2] = { make_row("a", NULL), make_row("b", NULL) };
+    assert(simplet_dictionary_set_list(rows[0], "ports", ports, 2) == SUCCESS);
+    assert(simplet_dictionary_set_list(dict, "rows", rows, 3) == SUCCESS);
+    assert_renders_all_paths("{{#rows}}{{name}}({{#ports}}{{name}}{{/ports}}){{/rows}}", dict, "pump(ab)fan()<lamp>()");
+
+    // An empty list renders nothing for a section and the body for an unless
+    assert(simplet_dictionary_set_list(dict, "rows", NULL, 0) == SUCCESS);
+    assert_renders_all_paths("a{{#rows}}x{{/rows}}b{{^rows}}none{{/rows}}", dict, "abnone");
+
+    for (int i = 0; i < 3; i++) destroy_simplet_dictionary(rows[i]);
+    for (int i = 0; i < 2; i++) destroy_simplet_dictionary(ports[i]);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_sections_conditionals, "[simplet_sections]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_t *row = make_row("only", NULL);
+    simplet_dictionary_set(dict, "user", "ann");
+    simplet_dictionary_set(dict, "empty", "");
+    simplet_dictionary_set_list(dict, "one", &row, 1);
+
+    assert_renders_all_paths("{{?user}}hi {{user}}{{/user}}{{^user}}sign in{{/user}}", dict, "hi ann");
+    assert_renders_all_paths("{{?nobody}}hi{{/nobody}}{{^nobody}}sign in{{/nobody}}", dict, "sign in");
+    assert_renders_all_paths("{{?empty}}x{{/empty}}{{^empty}}blank{{/empty}}", dict, "blank");
+
+    // A text section renders once; a non-empty list is true for a conditional
+    assert_renders_all_paths("{{#user}}<{{user}}>{{/user}}", dict, "<ann>");
+    assert_renders_all_paths("{{?one}}has rows{{/one}}{{^one}}no rows{{/one}}", dict, "has rows");
+
+    // List values never render as text
+    assert_renders_all_paths("[{{one}}]", dict, "[]");
+
+    // NULL dictionary: every key is missing
+    assert_renders_all_paths("{{?a}}A{{/a}}{{^a}}no a{{/a}}{{#a}}B{{/a}}", NULL, "no a");
+
+    destroy_simplet_dictionary(row);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_sections_unbalanced_tags, "[simplet_sections]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "a", "1");
+    simplet_dictionary_set(dict, "v", "V");
+
+    // Stray closing tags render nothing, unclosed blocks run to the end
+    assert_renders_all_paths("x{{/a}}y", dict, "xy");
+    assert_renders_all_paths("{{^a}}hidden {{v}}", dict, "");
+    assert_renders_all_paths("{{?a}}shown {{v}}", dict, "shown V");
+
+    // Closing an outer block also closes the blocks inside it
+    assert_renders_all_paths("{{?a}}[{{^b}}no]{{/a}}after", dict, "[no]after");
+    assert_renders_all_paths("{{?a}}[{{^a}}no{{/a}}]{{/b}}after", dict, "[]after");
+    assert_renders_all_paths("{{?a}}{{?b}}B{{/a}}out", dict, "out");
+
+    // A sigil without a name is an ordinary key; bare delimiters stay text
+    simplet_dictionary_set(dict, "#", "hash");
+    assert_renders_all_paths("{{#}}{{ # }}{{}}", dict, "hashhash{{}}");
+
+    // Text before the first block keeps its placeholders
+    assert_renders_all_paths("{{v}}-{{?a}}{{v}}{{/a}}-{{v}}", dict, "V-V-V");
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_sections_nesting_past_the_limit, "[simplet_sections]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "b", "1");
+
+    // Closing tags of blocks opened past the limit must not end the outer blocks early
+    for (int levels = SIMPLET_MAX_BLOCK_DEPTH - 1; levels <= SIMPLET_MAX_BLOCK_DEPTH + 4; levels++) {
+        char html[512] = "";
+        for (int i = 0; i < levels; i++) strcat(html, "{{?a}}");
+        for (int i = 0; i < levels - 2; i++) strcat(html, "{{/a}}");
+        strcat(html, "TAIL{{/a}}{{/a}}END");
+        assert_renders_all_paths(html, dict, "END");
+
+        // Tags past the limit are ignored, so the innermost body renders whenever the tracked blocks do
+        html[0] = '\0';
+        for (int i = 0; i < levels; i++) strcat(html, "{{?b}}");
+        strcat(html, "IN");
+        for (int i = 0; i < levels; i++) strcat(html, "{{/b}}");
+        strcat(html, "END");
+        assert_renders_all_paths(html, dict, "INEND");
+    }
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_sections_list_values, "[simplet_sections]") {
+    simplet_dictionary_t *dict = create_simplet_dictionary(16, false);
+    simplet_dictionary_t *item = make_row("x", NULL);
+    simplet_dictionary_t *items[2] = { item, item };
+
+    size_t before = simplet_dictionary_allocated_size(dict);
+    uint32_t generation = simplet_dictionary_generation(dict);
+    assert(simplet_dictionary_set_list(dict, "items", items, 2) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+    assert(simplet_dictionary_allocated_size(dict) > before);
+
+    // The pointer array is copied, the items are borrowed
+    items[1] = NULL;
+    assert_renders_all_paths("{{#items}}{{name}}{{/items}}", dict, "xx");
+
+    // A list is present but has no text
+    assert(simplet_dictionary_contains(dict, "items"));
+    assert(simplet_dictionary_get(dict, "items") == NULL);
+
+    // Setting the list again always counts as a change
+    generation = simplet_dictionary_generation(dict);
+    items[1] = item;
+    assert(simplet_dictionary_set_list(dict, "items", items, 2) == SUCCESS);
+    assert(simplet_dictionary_generation(dict) != generation);
+
+    // Text replaces a list and a list replaces text
+    assert(simplet_dictionary_set(dict, "items", "plain") == SUCCESS);
+    assert(strcmp(simplet_dictionary_get(dict, "items"), "plain") == 0);
+    assert(simplet_dictionary_set_list(dict, "items", items, 1) == SUCCESS);
+    assert(simplet_dictionary_get(dict, "items") == NULL);
+
+    assert(simplet_dictionary_remove(dict, "items") == SUCCESS);
+    assert(simplet_dictionary_allocated_size(dict) == before);
+
+    assert(simplet_dictionary_set_list(NULL, "items", items, 1) == ERROR_NULL_PARAM);
+    assert(simplet_dictionary_set_list(dict, "items", NULL, 1) == ERROR_NULL_PARAM);
+
+    // Incremental renders do not evaluate blocks
+    simplet_template_t *compiled = compile_simplet_template("{{#items}}x{{/items}}");
+    assert(compiled != NULL && compiled->block_count == 1);
+    assert(create_simplet_incremental(compiled) == NULL);
+    destroy_simplet_template(compiled);
+
+    destroy_simplet_dictionary(item);
+    destroy_simplet_dictionary(dict);
+}
@@ -0,0 +1,30 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_sections.c
+void test_simplet_sections_repeat_per_list_item(void);
+void test_simplet_sections_conditionals(void);
+void test_simplet_sections_unbalanced_tags(void);
+void test_simplet_sections_nesting_past_the_limit(void);
+void test_simplet_sections_list_values(void);
+
+int main(void) {
+    printf("Running simplet_sections tests...\n");
+
+    test_simplet_sections_repeat_per_list_item();
+    printf("✓ test_simplet_sections_repeat_per_list_item\n");
+
+    test_simplet_sections_conditionals();
+    printf("✓ test_simplet_sections_conditionals\n");
+
+    test_simplet_sections_unbalanced_tags();
+    printf("✓ test_simplet_sections_unbalanced_tags\n");
+
+    test_simplet_sections_nesting_past_the_limit();
+    printf("✓ test_simplet_sections_nesting_past_the_limit\n");
+
+    test_simplet_sections_list_values();
+    printf("✓ test_simplet_sections_list_values\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
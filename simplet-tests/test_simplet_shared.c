@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_shared.h"
+
+TEST_CASE(simplet_shared_snapshots_are_stable, "[simplet_shared]") {
+    simplet_dictionary_t *initial = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(initial, "name", "first");
+    simplet_dictionary_set(initial, "keep", "kept");
+    simplet_shared_dictionary_t *shared = create_simplet_shared_dictionary(initial);
+    assert(shared != NULL);
+
+    const simplet_snapshot_t *before = simplet_shared_dictionary_acquire(shared);
+    assert(strcmp(simplet_dictionary_get(simplet_snapshot_dictionary(before), "name"), "first") == 0);
+
+    // An update is invisible to snapshots already taken
+    assert(simplet_shared_dictionary_set(shared, "name", "second") == SUCCESS);
+    assert(strcmp(simplet_dictionary_get(simplet_snapshot_dictionary(before), "name"), "first") == 0);
+
+    const simplet_snapshot_t *after = simplet_shared_dictionary_acquire(shared);
+    char *page = simplet_render_html("{{name}}/{{keep}}", (simplet_dictionary_t *)simplet_snapshot_dictionary(after));
+    assert(strcmp(page, "second/kept") == 0);
+    free(page);
+    assert(simplet_dictionary_generation(simplet_snapshot_dictionary(after)) !=
+           simplet_dictionary_generation(simplet_snapshot_dictionary(before)));
+    simplet_snapshot_release(before);
+
+    // Several changes are published together; an aborted update publishes nothing
+    simplet_dictionary_t *edited = simplet_shared_dictionary_begin(shared);
+    assert(edited != NULL);
+    simplet_dictionary_set(edited, "a", "1");
+    simplet_dictionary_set(edited, "b", "2");
+    assert(simplet_shared_dictionary_commit(shared, edited) == SUCCESS);
+
+    edited = simplet_shared_dictionary_begin(shared);
+    simplet_dictionary_set(edited, "a", "discarded");
+    simplet_shared_dictionary_abort(shared, edited);
+
+    const simplet_snapshot_t *latest = simplet_shared_dictionary_acquire(shared);
+    const simplet_dictionary_t *dict = simplet_snapshot_dictionary(latest);
+    assert(simplet_dictionary_count(dict) == 4);
+    assert(strcmp(simplet_dictionary_get(dict, "a"), "1") == 0);
+    simplet_snapshot_release(latest);
+
+    assert(simplet_shared_dictionary_remove(shared, "a") == SUCCESS);
+    assert(simplet_shared_dictionary_remove(shared, "a") == ERROR_KEY_NOT_FOUND);
+    assert(simplet_shared_dictionary_set(shared, "x", NULL) == ERROR_NULL_PARAM);
+    assert(simplet_shared_dictionary_commit(shared, NULL) == ERROR_NULL_PARAM);
+    assert(simplet_shared_dictionary_acquire(NULL) == NULL);
+
+    // Snapshots outlive the shared dictionary
+    destroy_simplet_shared_dictionary(shared);
+    assert(strcmp(simplet_dictionary_get(simplet_snapshot_dictionary(after), "name"), "second") == 0);
+    simplet_snapshot_release(after);
+
+    shared = create_simplet_shared_dictionary(NULL);
+    assert(shared != NULL);
+    destroy_simplet_shared_dictionary(shared);
+}
+
+TEST_CASE(simplet_shared_copy_keeps_entries, "[simplet_shared]") {
+    static const char borrowed[] = "flash";
+    simplet_dictionary_t *item = create_simplet_dictionary(4, true);
+    simplet_dictionary_t *source = create_simplet_dictionary(4, true);
+    simplet_dictionary_set(item, "v", "item");
+    simplet_dictionary_set(source, "owned", "heap");
+    simplet_dictionary_set_borrowed(source, "borrowed", borrowed);
+    simplet_dictionary_set_list(source, "list", &item, 1);
+    for (int i = 0; i < 40; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        simplet_dictionary_set(source, key, key);
+    }
+
+    simplet_dictionary_t *copy = copy_simplet_dictionary(source);
+    assert(copy != NULL && copy != source);
+    assert(simplet_dictionary_count(copy) == simplet_dictionary_count(source));
+    assert(simplet_dictionary_allocated_size(copy) == simplet_dictionary_allocated_size(source));
+    assert(simplet_dictionary_get(copy, "owned") != simplet_dictionary_get(source, "owned"));
+    assert(simplet_dictionary_get(copy, "borrowed") == borrowed);
+    assert(strcmp(simplet_dictionary_get(copy, "key39"), "key39") == 0);
+
+    char *page = simplet_render_html("{{owned}} {{#list}}{{v}}{{/list}}", copy);
+    assert(strcmp(page, "heap item") == 0);
+    free(page);
+
+    // The copy is independent of its source
+    destroy_simplet_dictionary(source);
+    assert(strcmp(simplet_dictionary_get(copy, "owned"), "heap") == 0);
+    assert(copy_simplet_dictionary(NULL) == NULL);
+
+    destroy_simplet_dictionary(copy);
+    destroy_simplet_dictionary(item);
+}
+
+#define READER_COUNT 4
+#define UPDATE_COUNT 2000
+
+typedef struct {
+    simplet_shared_dictionary_t *shared;
+    atomic_bool *done;
+    size_t renders;
+} reader_t;
+
+// Renders continuously; both values are always written in the same update, so they must match
+static void* reader_main(void *argument) {
+    reader_t *reader = argument;
+    simplet_template_t *compiled = compile_simplet_template("{{left}}={{right}}");
+
+    while (!atomic_load(reader->done) || reader->renders == 0) {
+        const simplet_snapshot_t *snapshot = simplet_shared_dictionary_acquire(reader->shared);
+        char *page = simplet_template_render(compiled, simplet_snapshot_dictionary(snapshot));
+        simplet_snapshot_release(snapshot);
+
+        char *equals = strchr(page, '=');
+        assert(equals != NULL);
+        *equals = '\0';
+        assert(strcmp(page, equals + 1) == 0);
+        free(page);
+        reader->renders++;
+    }
+
+    destroy_simplet_template(compiled);
+    return NULL;
+}
+
+TEST_CASE(simplet_shared_concurrent_readers_and_writer, "[simplet_shared]") {
+    simplet_shared_dictionary_t *shared = create_simplet_shared_dictionary(NULL);
+    atomic_bool done = false;
+    pthread_t threads[READER_COUNT];
+    reader_t readers[READER_COUNT];
+
+    for (int i = 0; i < READER_COUNT; i++) {
+        readers[i] = (reader_t){ shared, &done, 0 };
+        assert(pthread_create(&threads[i], NULL, reader_main, &readers[i]) == 0);
+    }
+
+    // Growing values force resizes and frees of old snapshots during renders
+    for (int update = 0; update < UPDATE_COUNT; update++) {
+        char value[32];
+        snprintf(value, sizeof(value), "v%d", update);
+        simplet_dictionary_t *edited = simplet_shared_dictionary_begin(shared);
+        assert(edited != NULL);
+        simplet_dictionary_set(edited, "left", value);
+        simplet_dictionary_set(edited, "right", value);
+        simplet_dictionary_set(edited, value, value);
+        if (update % 64 == 63) clear_simplet_dictionary(edited);
+        assert(simplet_shared_dictionary_commit(shared, edited) == SUCCESS);
+    }
+
+    atomic_store(&done, true);
+    size_t renders = 0;
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        renders += readers[i].renders;
+    }
+    assert(renders >= READER_COUNT);
+
+    const simplet_snapshot_t *last = simplet_shared_dictionary_acquire(shared);
+    assert(strcmp(simplet_dictionary_get(simplet_snapshot_dictionary(last), "left"), "v1999") == 0);
+    simplet_snapshot_release(last);
+
+    destroy_simplet_shared_dictionary(shared);
+}
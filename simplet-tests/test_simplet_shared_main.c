@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_shared.c
+void test_simplet_shared_snapshots_are_stable(void);
+void test_simplet_shared_copy_keeps_entries(void);
+void test_simplet_shared_concurrent_readers_and_writer(void);
+
+int main(void) {
+    printf("Running simplet_shared tests...\n");
+
+    test_simplet_shared_snapshots_are_stable();
+    printf("✓ test_simplet_shared_snapshots_are_stable\n");
+
+    test_simplet_shared_copy_keeps_entries();
+    printf("✓ test_simplet_shared_copy_keeps_entries\n");
+
+    test_simplet_shared_concurrent_readers_and_writer();
+    printf("✓ test_simplet_shared_concurrent_readers_and_writer\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+
+#include "simplet.h"
+#include "simplet_stream.h"
+#include "simplet_dictionary.h"
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    size_t fail_after;
+    size_t calls;
+} growing_sink_t;
+
+static int growing_sink(void* context, const char* data, size_t length) {
+    growing_sink_t* sink = context;
+    assert(length > 0);
+    if (sink->fail_after && sink->calls == sink->fail_after) return -1;
+    sink->calls++;
+    if (sink->length + length + 1 > sink->capacity) {
+        sink->capacity = (sink->length + length + 1) * 2;
+        sink->data = realloc(sink->data, sink->capacity);
+        assert(sink->data != NULL);
+    }
+    memcpy(sink->data + sink->length, data, length);
+    sink->length += length;
+    sink->data[sink->length] = '\0';
+    return 0;
+}
+
+/* Streams text in fixed-size chunks and returns the output (caller frees) */
+static char* stream_in_chunks(const char* text, size_t chunk_size, const simplet_dictionary_t* dict) {
+    growing_sink_t sink = { 0 };
+    simplet_stream_t* stream = create_simplet_stream(dict, growing_sink, &sink);
+    assert(stream != NULL);
+
+    size_t length = strlen(text);
+    for (size_t position = 0; position < length; position += chunk_size) {
+        size_t take = length - position < chunk_size ? length - position : chunk_size;
+        assert(simplet_stream_feed(stream, text + position, take) == SUCCESS);
+    }
+    assert(simplet_stream_finish(stream) == SUCCESS);
+    destroy_simplet_stream(stream);
+
+    if (!sink.data) {
+        sink.data = calloc(1, 1);
+    }
+    return sink.data;
+}
+
+TEST_CASE(simplet_stream_matches_render_html_at_every_chunk_size, "[simplet_stream]") {
+    static const char* templates[] = {
+        "Hello {{name}}!",
+        "{{ name }} and {{\tmissing\t}} and {{empty}}",
+        "{{}} {{ }} {{{name}}} {{{{name}}}} }}{{",
+        "unclosed {{ name",
+        "trailing {",
+        "{{name}}{{name}}{{name}}",
+        "a{b{{c}d}}e}}f{{",
+        "{{ {{name}} }}",
+    };
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "name", "World");
+    simplet_dictionary_set(dict, "{name", "brace");
+    simplet_dictionary_set(dict, "c}d", "odd");
+    simplet_dictionary_set(dict, "empty", "");
+
+    for (size_t t = 0; t < sizeof(templates) / sizeof(templates[0]); t++) {
+        char* expected = simplet_render_html(templates[t], dict);
+        for (size_t chunk = 1; chunk <= strlen(templates[t]) + 1; chunk++) {
+            char* output = stream_in_chunks(templates[t], chunk, dict);
+            if (strcmp(expected, output) != 0) {
+                printf("template %zu chunk %zu: expected '%s' got '%s'\n", t, chunk, expected, output);
+            }
+            assert(strcmp(expected, output) == 0);
+            free(output);
+        }
+        free(expected);
+    }
+
+    // Random templates over a small alphabet hit every delimiter split
+    static const char alphabet[] = "{} kx\t";
+    char text[128];
+    srand(77);
+    for (int round = 0; round < 2000; round++) {
+        size_t length = (size_t)(rand() % 60);
+        for (size_t i = 0; i < length; i++) text[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+        text[length] = '\0';
+
+        simplet_dictionary_set(dict, "k", "V");
+        simplet_dictionary_set(dict, "kx", "W");
+        char* expected = simplet_render_html(text, dict);
+        size_t chunk = (size_t)(rand() % 7) + 1;
+        char* output = stream_in_chunks(text, chunk, dict);
+        if (strcmp(expected, output) != 0) {
+            printf("'%s' chunk %zu: expected '%s' got '%s'\n", text, chunk, expected, output);
+        }
+        assert(strcmp(expected, output) == 0);
+        free(output);
+        free(expected);
+    }
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_stream_renders_templates_beyond_8kb, "[simplet_stream]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "row", "<tr><td>ok</td></tr>");
+
+    // About 200 KB of template, written to a file and read back in chunks
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    size_t rows = 10000;
+    for (size_t i = 0; i < rows; i++) {
+        fputs("<!-- filler -->{{ row }}\n", file);
+    }
+    rewind(file);
+
+    growing_sink_t sink = { 0 };
+    assert(simplet_render_file(file, dict, growing_sink, &sink) == SUCCESS);
+    fclose(file);
+
+    size_t line_length = strlen("<!-- filler --><tr><td>ok</td></tr>\n");
+    assert(sink.length == rows * line_length);
+    assert(strncmp(sink.data, "<!-- filler --><tr><td>ok</td></tr>\n<!--", line_length + 4) == 0);
+    assert(sink.calls < rows);   // Output was coalesced
+    free(sink.data);
+
+    assert(simplet_render_file(NULL, dict, growing_sink, &sink) == ERROR_NULL_PARAM);
+
+    destroy_simplet_dictionary(dict);
+}
+
+static int failing_source(void* context, char* buffer, size_t capacity) {
+    int* calls = context;
+    (*calls)++;
+    if (*calls > 1) return -1;
+    memcpy(buffer, "{{name}} ", capacity < 9 ? capacity : 9);
+    return 9;
+}
+
+TEST_CASE(simplet_stream_reports_errors_and_long_tags, "[simplet_stream]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "name", "World");
+
+    int calls = 0;
+    growing_sink_t sink = { 0 };
+    assert(simplet_render_source(failing_source, &calls, dict, growing_sink, &sink) == ERROR_READ_FAILED);
+    assert(strcmp(sink.data, "World ") == 0);
+    free(sink.data);
+
+    // Sink failure is reported by feed and finish
+    memset(&sink, 0, sizeof(sink));
+    sink.fail_after = 1;
+    simplet_stream_t* stream = create_simplet_stream(dict, growing_sink, &sink);
+    char big[SIMPLET_SINK_SCRATCH_SIZE * 3];
+    memset(big, 'x', sizeof(big));
+    assert(simplet_stream_feed(stream, big, sizeof(big)) == SUCCESS);
+    assert(simplet_stream_feed(stream, big, sizeof(big)) == ERROR_WRITE_FAILED);
+    assert(simplet_stream_finish(stream) == ERROR_WRITE_FAILED);
+
+    destroy_simplet_stream(stream);
+    free(sink.data);
+
+    // The stream is reusable after finish
+    memset(&sink, 0, sizeof(sink));
+    stream = create_simplet_stream(dict, growing_sink, &sink);
+    assert(simplet_stream_feed(stream, "A{{name}}", 9) == SUCCESS);
+    assert(simplet_stream_finish(stream) == SUCCESS);
+    assert(simplet_stream_feed(stream, "B{{ name", 8) == SUCCESS);
+    assert(simplet_stream_feed(stream, " }}", 3) == SUCCESS);
+    assert(simplet_stream_finish(stream) == SUCCESS);
+    assert(strcmp(sink.data, "AWorldBWorld") == 0);
+    free(sink.data);
+    destroy_simplet_stream(stream);
+
+    // A placeholder body longer than the tag buffer is passed through as text
+    memset(&sink, 0, sizeof(sink));
+    char* text = malloc(SIMPLET_STREAM_TAG_SIZE + 64);
+    strcpy(text, "{{");
+    memset(text + 2, 'k', SIMPLET_STREAM_TAG_SIZE + 8);
+    strcpy(text + 2 + SIMPLET_STREAM_TAG_SIZE + 8, "}} {{name}}");
+    char* output = stream_in_chunks(text, 5, dict);
+    assert(strncmp(output, text, 2 + SIMPLET_STREAM_TAG_SIZE + 8 + 3) == 0);
+    assert(strcmp(output + 2 + SIMPLET_STREAM_TAG_SIZE + 8 + 3, "World") == 0);
+    free(output);
+    free(text);
+
+    assert(create_simplet_stream(dict, NULL, NULL) == NULL);
+    assert(simplet_stream_feed(NULL, "x", 1) == ERROR_NULL_PARAM);
+    assert(simplet_stream_finish(NULL) == ERROR_NULL_PARAM);
+    assert(simplet_render_source(NULL, NULL, dict, growing_sink, &sink) == ERROR_NULL_PARAM);
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_stream_substitutes_bodies_up_to_the_tag_size, "[simplet_stream]") {
+    simplet_dictionary_t* dict = create_simplet_dictionary(16, true);
+    simplet_dictionary_set(dict, "name", "World");
+
+    // "{{name" padded with spaces to a body of size bytes, then "}}"
+    char text[SIMPLET_STREAM_TAG_SIZE + 16];
+    for (size_t size = SIMPLET_STREAM_TAG_SIZE - 2; size <= SIMPLET_STREAM_TAG_SIZE + 1; size++) {
+        memcpy(text, "<{{name", 7);
+        memset(text + 7, ' ', size - 4);
+        strcpy(text + 3 + size, "}}>");
+
+        // Longer bodies are passed through as text, where simplet_render_html still substitutes
+        char* rendered = simplet_render_html(text, dict);
+        assert(strcmp(rendered, "<World>") == 0);
+        const char* expected = size <= SIMPLET_STREAM_TAG_SIZE ? rendered : text;
+
+        static const size_t chunk_sizes[] = { 1, 2, 3, 7, SIMPLET_STREAM_TAG_SIZE, sizeof(text) };
+        for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+            char* output = stream_in_chunks(text, chunk_sizes[i], dict);
+            if (strcmp(output, expected) != 0) {
+                printf("body %zu, chunk %zu: expected \"%s\", got \"%s\"\n", size, chunk_sizes[i], expected, output);
+                assert(0);
+            }
+            free(output);
+        }
+        free(rendered);
+    }
+
+    destroy_simplet_dictionary(dict);
+}
@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_stream.c
+void test_simplet_stream_matches_render_html_at_every_chunk_size(void);
+void test_simplet_stream_renders_templates_beyond_8kb(void);
+void test_simplet_stream_reports_errors_and_long_tags(void);
+void test_simplet_stream_substitutes_bodies_up_to_the_tag_size(void);
+
+int main(void) {
+    printf("Running simplet_stream tests...\n");
+
+    test_simplet_stream_matches_render_html_at_every_chunk_size();
+    printf("✓ test_simplet_stream_matches_render_html_at_every_chunk_size\n");
+
+    test_simplet_stream_renders_templates_beyond_8kb();
+    printf("✓ test_simplet_stream_renders_templates_beyond_8kb\n");
+
+    test_simplet_stream_reports_errors_and_long_tags();
+    printf("✓ test_simplet_stream_reports_errors_and_long_tags\n");
+
+    test_simplet_stream_substitutes_bodies_up_to_the_tag_size();
+    printf("✓ test_simplet_stream_substitutes_bodies_up_to_the_tag_size\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
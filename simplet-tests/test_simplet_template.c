@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_CASE(name, tags) void test_##name(void)
+#define ASSERT_NULL_TERMINATED(str) assert((str)[strlen(str)] == '\0')
+
+#include "simplet.h"
+#include "simplet_template.h"
+#include "simplet_dictionary.h"
+
+#ifdef __unix__
+#include <sys/mman.h>
+#endif
+
+typedef struct {
+    char data[4096];
+    size_t length;
+    size_t calls;
+    size_t fail_after;
+} collect_sink_t;
+
+static int collect_sink(void* context, const char* data, size_t length) {
+    collect_sink_t* sink = context;
+    assert(length > 0);
+    if (sink->fail_after && sink->calls == sink->fail_after) return -1;
+    assert(sink->length + length < sizeof(sink->data));
+    memcpy(sink->data + sink->length, data, length);
+    sink->length += length;
+    sink->data[sink->length] = '\0';
+    sink->calls++;
+    return 0;
+}
+
+TEST_CASE(simplet_template_compiles_literals_and_placeholders, "[simplet_template]") {
+    simplet_template_t* compiled = compile_simplet_template("<h1>{{ title }}</h1>");
+    assert(compiled != NULL);
+
+    assert(compiled->op_count == 3);
+    assert(compiled->placeholder_count == 1);
+    assert(compiled->literal_length == strlen("<h1></h1>"));
+
+    assert(compiled->ops[1].kind == SIMPLET_OP_PLACEHOLDER);
+    assert(strcmp("title", compiled->ops[1].text) == 0);
+    assert(compiled->ops[1].hash == hash_key("title"));
+
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_template_renders_many_times, "[simplet_template]") {
+    simplet_template_t* compiled = compile_simplet_template("<p>{{ count }}</p>");
+    assert(compiled != NULL);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+
+    char value[16];
+    char expected[32];
+    for (int i = 0; i < 100; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        snprintf(expected, sizeof(expected), "<p>%d</p>", i);
+        assert(simplet_dictionary_set(dict, "count", value) == SUCCESS);
+
+        char* rendered_html = simplet_template_render(compiled, dict);
+        assert(rendered_html != NULL);
+        ASSERT_NULL_TERMINATED(rendered_html);
+        assert(strcmp(expected, rendered_html) == 0);
+        free(rendered_html);
+    }
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_template_matches_simplet_render_html, "[simplet_template]") {
+    const char* templates[] = {
+        "",
+        "no placeholders at all",
+        "{{a}}{{a}}{{a}}",
+        "<{{ a }}|{{\tb\t}}|{{ missing }}|{{ empty }}>",
+        "{{}} {{ }} {{ a",
+        "{{{ a }}}",
+        "x{{a}}}}y{{b",
+    };
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "a", "alpha") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "b", "a much longer value than the template itself") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "empty", "") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "{ a", "brace") == SUCCESS);
+
+    for (size_t i = 0; i < sizeof(templates) / sizeof(templates[0]); i++) {
+        simplet_template_t* compiled = compile_simplet_template(templates[i]);
+        assert(compiled != NULL);
+
+        char* expected = simplet_render_html(templates[i], dict);
+        char* rendered_html = simplet_template_render(compiled, dict);
+        assert(expected != NULL && rendered_html != NULL);
+        assert(strcmp(expected, rendered_html) == 0);
+
+        free(expected);
+        free(rendered_html);
+        destroy_simplet_template(compiled);
+    }
+
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_template_handles_NULL_inputs, "[simplet_template]") {
+    assert(compile_simplet_template(NULL) == NULL);
+
+    char* rendered_html = simplet_template_render(NULL, NULL);
+    assert(rendered_html != NULL);
+    assert(strcmp("", rendered_html) == 0);
+    free(rendered_html);
+
+    simplet_template_t* compiled = compile_simplet_template("<div>{{ key }}</div>");
+    assert(compiled != NULL);
+
+    rendered_html = simplet_template_render(compiled, NULL);
+    assert(rendered_html != NULL);
+    assert(strcmp("<div></div>", rendered_html) == 0);
+    free(rendered_html);
+
+    destroy_simplet_template(compiled);
+    destroy_simplet_template(NULL);
+}
+
+TEST_CASE(simplet_template_renders_to_sink, "[simplet_template]") {
+    simplet_template_t* compiled = compile_simplet_template("<h1>{{ title }}</h1><p>{{ content }}</p>{{ missing }}");
+    assert(compiled != NULL);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "title", "Test Title") == SUCCESS);
+    assert(simplet_dictionary_set(dict, "content", "Test Content") == SUCCESS);
+
+    collect_sink_t sink = {0};
+    assert(simplet_render_to_sink(compiled, dict, collect_sink, &sink) == SUCCESS);
+    assert(strcmp("<h1>Test Title</h1><p>Test Content</p>", sink.data) == 0);
+
+    // Small pieces are coalesced into a single write
+    assert(sink.calls == 1);
+
+    assert(simplet_render_to_sink(NULL, dict, collect_sink, &sink) == ERROR_NULL_PARAM);
+    assert(simplet_render_to_sink(compiled, dict, NULL, &sink) == ERROR_NULL_PARAM);
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_template_streams_large_pages_in_chunks, "[simplet_template]") {
+    char template_html[3000];
+    size_t length = 0;
+    for (int i = 0; i < 100; i++) {
+        length += (size_t)snprintf(template_html + length, sizeof(template_html) - length, "<li>{{ item }}</li>\n");
+    }
+
+    simplet_template_t* compiled = compile_simplet_template(template_html);
+    assert(compiled != NULL);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "item", "entry") == SUCCESS);
+
+    collect_sink_t sink = {0};
+    assert(simplet_render_to_sink(compiled, dict, collect_sink, &sink) == SUCCESS);
+
+    char* expected = simplet_template_render(compiled, dict);
+    assert(strcmp(expected, sink.data) == 0);
+    assert(sink.calls >= sink.length / SIMPLET_SINK_SCRATCH_SIZE);
+    free(expected);
+
+    // A failing sink stops the render
+    collect_sink_t failing = {0};
+    failing.fail_after = 2;
+    assert(simplet_render_to_sink(compiled, dict, collect_sink, &failing) == ERROR_WRITE_FAILED);
+    assert(failing.calls == 2);
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_template_renders_into_caller_buffer, "[simplet_template]") {
+    simplet_template_t* compiled = compile_simplet_template("<b>{{ name }}</b>{{ name }}");
+    assert(compiled != NULL);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    assert(dict != NULL);
+    assert(simplet_dictionary_set(dict, "name", "simplet") == SUCCESS);
+
+    const char* expected = "<b>simplet</b>simplet";
+    assert(simplet_render_length(compiled, dict) == strlen(expected));
+
+    char buffer[64];
+    size_t needed = 0;
+    assert(simplet_render_into(buffer, sizeof(buffer), compiled, dict, &needed) == SUCCESS);
+    assert(needed == strlen(expected));
+    assert(strcmp(expected, buffer) == 0);
+
+    // Exact fit needs room for the terminator
+    assert(simplet_render_into(buffer, needed + 1, compiled, dict, NULL) == SUCCESS);
+    assert(strcmp(expected, buffer) == 0);
+
+    // Truncated output is still terminated and reports the full size
+    needed = 0;
+    assert(simplet_render_into(buffer, 8, compiled, dict, &needed) == ERROR_BUFFER_TOO_SMALL);
+    assert(needed == strlen(expected));
+    assert(strcmp("<b>simp", buffer) == 0);
+
+    // Measuring only
+    needed = 0;
+    assert(simplet_render_into(NULL, 0, compiled, dict, &needed) == ERROR_BUFFER_TOO_SMALL);
+    assert(needed == strlen(expected));
+
+    assert(simplet_render_into(NULL, 8, compiled, dict, &needed) == ERROR_NULL_PARAM);
+
+    destroy_simplet_dictionary(dict);
+    destroy_simplet_template(compiled);
+}
+
+TEST_CASE(simplet_template_borrows_read_only_text, "[simplet_template]") {
+    static const char page[] = "<title>{{ title }}</title><body>{{body}}</body>";
+    size_t length = sizeof(page) - 1;
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_set(dict, "title", "Status");
+    simplet_dictionary_set(dict, "body", "All good");
+
+    simplet_template_t* copied = compile_simplet_template_n(page, length);
+    simplet_template_t* borrowed = compile_simplet_template_borrowed(page, length);
+    assert(copied != NULL && borrowed != NULL);
+    assert(borrowed->op_count == copied->op_count);
+
+    // Literals point into the source instead of a copy
+    assert(borrowed->ops[0].text == page);
+    assert(copied->ops[0].text != page);
+
+    char* expected = simplet_render_html((char*)page, dict);
+    char* from_copy = simplet_template_render(copied, dict);
+    char* from_borrowed = simplet_template_render(borrowed, dict);
+    assert(strcmp(expected, from_copy) == 0);
+    assert(strcmp(expected, from_borrowed) == 0);
+    free(expected);
+    free(from_copy);
+    free(from_borrowed);
+
+    // Length bounds the template even without a terminator
+    simplet_template_t* prefix = compile_simplet_template_borrowed(page, 7);
+    char* rendered = simplet_template_render(prefix, dict);
+    assert(strcmp("<title>", rendered) == 0);
+    free(rendered);
+
+    simplet_template_t* empty = compile_simplet_template_borrowed(NULL, 0);
+    assert(empty != NULL && empty->op_count == 0);
+    assert(compile_simplet_template_n(NULL, 4) == NULL);
+
+    destroy_simplet_template(empty);
+    destroy_simplet_template(prefix);
+    destroy_simplet_template(borrowed);
+    destroy_simplet_template(copied);
+    destroy_simplet_dictionary(dict);
+}
+
+TEST_CASE(simplet_template_renders_mapped_files, "[simplet_template]") {
+#ifdef __unix__
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    for (int i = 0; i < 2000; i++) {
+        fputs("<li>{{item}}</li>\n", file);
+    }
+    fflush(file);
+    long length = ftell(file);
+
+    const char* mapped = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    assert(mapped != MAP_FAILED);
+
+    simplet_dictionary_t* dict = create_simplet_dictionary(SIZE_SMALL, false);
+    simplet_dictionary_set(dict, "item", "x");
+
+    simplet_template_t* compiled = compile_simplet_template_borrowed(mapped, (size_t)length);
+    assert(compiled->placeholder_count == 2000);
+    char* from_template = simplet_template_render(compiled, dict);
+    char* from_text = simplet_render_html_n(mapped, (size_t)length, dict);
+    assert(strlen(from_template) == 2000 * strlen("<li>x</li>\n"));
+    assert(strcmp(from_template, from_text) == 0);
+
+    free(from_template);
+    free(from_text);
+    destroy_simplet_template(compiled);
+    destroy_simplet_dictionary(dict);
+    munmap((void*)mapped, (size_t)length);
+    fclose(file);
+#endif
+}
@@ -0,0 +1,46 @@
+#include <stdio.h>
+
+// Forward declare the test functions that are defined in test_simplet_template.c
+void test_simplet_template_compiles_literals_and_placeholders(void);
+void test_simplet_template_renders_many_times(void);
+void test_simplet_template_matches_simplet_render_html(void);
+void test_simplet_template_handles_NULL_inputs(void);
+void test_simplet_template_renders_to_sink(void);
+void test_simplet_template_streams_large_pages_in_chunks(void);
+void test_simplet_template_renders_into_caller_buffer(void);
+void test_simplet_template_borrows_read_only_text(void);
+void test_simplet_template_renders_mapped_files(void);
+
+int main(void) {
+    printf("Running simplet_template tests...\n");
+
+    test_simplet_template_compiles_literals_and_placeholders();
+    printf("✓ test_simplet_template_compiles_literals_and_placeholders\n");
+
+    test_simplet_template_renders_many_times();
+    printf("✓ test_simplet_template_renders_many_times\n");
+
+    test_simplet_template_matches_simplet_render_html();
+    printf("✓ test_simplet_template_matches_simplet_render_html\n");
+
+    test_simplet_template_handles_NULL_inputs();
+    printf("✓ test_simplet_template_handles_NULL_inputs\n");
+
+    test_simplet_template_renders_to_sink();
+    printf("✓ test_simplet_template_renders_to_sink\n");
+
+    test_simplet_template_streams_large_pages_in_chunks();
+    printf("✓ test_simplet_template_streams_large_pages_in_chunks\n");
+
+    test_simplet_template_renders_into_caller_buffer();
+    printf("✓ test_simplet_template_renders_into_caller_buffer\n");
+
+    test_simplet_template_borrows_read_only_text();
+    printf("✓ test_simplet_template_borrows_read_only_text\n");
+
+    test_simplet_template_renders_mapped_files();
+    printf("✓ test_simplet_template_renders_mapped_files\n");
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
\ No newline at end of file
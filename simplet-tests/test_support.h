@@ -0,0 +1,87 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "simplet.h"
+
+// Largest output the render path assertions collect through sinks and buffers
+#define TEST_OUTPUT_SIZE 1024
+
+// Sink appending to a NUL-terminated char buffer, which must be large enough
+static inline int append_sink(void *context, const char *data, size_t length) {
+    char *out = context;
+    strncat(out, data, length);
+    return 0;
+}
+
+// Fails with both strings printed, so a mismatch shows what was rendered
+static inline void assert_same_output(const char *result, const char *expected) {
+    assert(result != NULL);
+    if (strcmp(result, expected) != 0) {
+        printf("expected \"%s\", got \"%s\"\n", expected, result);
+        assert(0);
+    }
+}
+
+// Every compiled render path must produce the expected page
+static inline void assert_template_renders(const simplet_template_t *compiled, const simplet_dictionary_t *dict,
+                                           const char *expected) {
+    assert(strlen(expected) < TEST_OUTPUT_SIZE);
+
+    char *result = simplet_template_render(compiled, dict);
+    assert_same_output(result, expected);
+    free(result);
+    assert(simplet_render_length(compiled, dict) == strlen(expected));
+
+    char sunk[TEST_OUTPUT_SIZE] = "";
+    assert(simplet_render_to_sink(compiled, dict, append_sink, sunk) == SUCCESS);
+    assert_same_output(sunk, expected);
+
+    size_t needed = 0;
+    assert(simplet_render_into(sunk, sizeof(sunk), compiled, dict, &needed) == SUCCESS);
+    assert(needed == strlen(expected));
+    assert_same_output(sunk, expected);
+
+    // Truncated like snprintf
+    char small[8];
+    simplet_dictionary_error_t error = simplet_render_into(small, sizeof(small), compiled, dict, &needed);
+    assert(needed == strlen(expected));
+    assert(error == (needed < sizeof(small) ? SUCCESS : ERROR_BUFFER_TOO_SMALL));
+    assert(strncmp(small, expected, sizeof(small) - 1) == 0);
+}
+
+/* Every render path must produce the expected page: the template string
+ * rendered whole and to a sink, and compiled through assert_template_renders.
+ * Streams only substitute placeholders, so they are checked on templates
+ * without blocks or partials.
+ */
+static inline void assert_renders_all_paths(const char *html, const simplet_dictionary_t *dict, const char *expected) {
+    char *result = simplet_render_html_n(html, strlen(html), dict);
+    assert_same_output(result, expected);
+    free(result);
+
+    char sunk[TEST_OUTPUT_SIZE] = "";
+    assert(simplet_render_html_n_to_sink(html, strlen(html), dict, append_sink, sunk) == SUCCESS);
+    assert_same_output(sunk, expected);
+
+    simplet_template_t *compiled = compile_simplet_template_n(html, strlen(html));
+    assert(compiled != NULL);
+    assert_template_renders(compiled, dict, expected);
+
+    if (compiled->block_count == 0 && compiled->partial_count == 0) {
+        sunk[0] = '\0';
+        simplet_stream_t *stream = create_simplet_stream(dict, append_sink, sunk);
+        assert(simplet_stream_feed(stream, html, strlen(html)) == SUCCESS);
+        assert(simplet_stream_finish(stream) == SUCCESS);
+        destroy_simplet_stream(stream);
+        assert_same_output(sunk, expected);
+    }
+
+    destroy_simplet_template(compiled);
+}
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,81 @@
+# Build-time template compilation
+#
+#   simplet_add_template(<target> <template> [NAME <name>])
+#
+# Compiles <template> into C source added to <target>, and puts the
+# generated <name>_template.h on its include path. The header declares
+# simplet_render_<name>(), simplet_render_<name>_length() and
+# simplet_template_<name> (see src/tools/simplet_compile.c). <name>
+# defaults to the template file name without extension.
+#
+# Native builds use the simplet_compile target; cross builds (ESP-IDF)
+# build the compiler once at configure time with the host toolchain.
+
+set(SIMPLET_TOOLS_DIR "${CMAKE_CURRENT_LIST_DIR}/../tools" CACHE INTERNAL "simplet template compiler sources")
+
+# Sets <command> to the compiler to run and <depends> to what the build must wait for
+function(simplet_template_compiler command depends)
+    if(TARGET simplet_compile AND NOT CMAKE_CROSSCOMPILING)
+        set(${command} $<TARGET_FILE:simplet_compile> PARENT_SCOPE)
+        set(${depends} simplet_compile PARENT_SCOPE)
+        return()
+    endif()
+
+    set(host_dir "${CMAKE_BINARY_DIR}/simplet_compile_host")
+    set(host_compiler "${host_dir}/bin/simplet_compile${CMAKE_HOST_EXECUTABLE_SUFFIX}")
+
+    get_property(built GLOBAL PROPERTY SIMPLET_COMPILE_HOST_BUILT)
+    if(NOT built)
+        # A clean environment so the target toolchain does not leak into the host build
+        execute_process(
+            COMMAND ${CMAKE_COMMAND} -E env --unset=CC --unset=CFLAGS
+                    ${CMAKE_COMMAND} -S "${SIMPLET_TOOLS_DIR}" -B "${host_dir}" -DCMAKE_BUILD_TYPE=Release
+            RESULT_VARIABLE result
+            OUTPUT_QUIET
+        )
+        if(result EQUAL 0)
+            execute_process(
+                COMMAND ${CMAKE_COMMAND} --build "${host_dir}"
+                RESULT_VARIABLE result
+                OUTPUT_QUIET
+            )
+        endif()
+        if(NOT result EQUAL 0 OR NOT EXISTS "${host_compiler}")
+            message(FATAL_ERROR "simplet: could not build the template compiler with the host toolchain")
+        endif()
+        set_property(GLOBAL PROPERTY SIMPLET_COMPILE_HOST_BUILT TRUE)
+    endif()
+
+    set(${command} "${host_compiler}" PARENT_SCOPE)
+    set(${depends} "${host_compiler}" PARENT_SCOPE)
+endfunction()
+
+function(simplet_add_template target template)
+    cmake_parse_arguments(ARG "" "NAME" "" ${ARGN})
+
+    get_filename_component(input "${template}" ABSOLUTE)
+    if(ARG_NAME)
+        set(name "${ARG_NAME}")
+    else()
+        get_filename_component(name "${template}" NAME_WE)
+    endif()
+    string(MAKE_C_IDENTIFIER "${name}" name)
+
+    set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/simplet_generated")
+    set(output_c "${output_dir}/${name}_template.c")
+    set(output_h "${output_dir}/${name}_template.h")
+
+    simplet_template_compiler(compiler compiler_depends)
+
+    add_custom_command(
+        OUTPUT "${output_c}" "${output_h}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${output_dir}"
+        COMMAND ${compiler} "${input}" "${output_c}" "${output_h}" ${name}
+        DEPENDS "${input}" ${compiler_depends}
+        COMMENT "Compiling simplet template ${template}"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE "${output_c}" "${output_h}")
+    target_include_directories(${target} PRIVATE "${output_dir}")
+endfunction()
@@ -3,7 +3,55 @@
 #define SIMPLET_H
 
 #include "simplet_dictionary.h"
+#include "simplet_template.h"
+#include "simplet_filter.h"
+#include "simplet_cache.h"
+#include "simplet_incremental.h"
+#include "simplet_instrument.h"
+#include "simplet_stream.h"
+#include "simplet_partials.h"
+#include "simplet_shared.h"
+#include "simplet_provider.h"
+#include "simplet_parallel.h"
+#include "simplet_batch.h"
 
 char* simplet_render_html(const char *html_template, simplet_dictionary_t *dictionary);
 
+/**
+ * Render a template given by pointer and length
+ * For read-only or memory-mapped templates (EMBED_TXTFILES, mmap): the
+ * length is trusted, so there is no NUL scan and no MAX_TEMPLATE_SIZE limit.
+ * @param html_template Template text (need not be NUL-terminated)
+ * @param length Bytes of template text
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @return Newly allocated string with substitutions, never returns NULL
+ */
+char* simplet_render_html_n(const char *html_template, size_t length, const simplet_dictionary_t *dictionary);
+
+/**
+ * Render a template string straight into a sink without an output buffer
+ * Uses a fixed SIMPLET_SINK_SCRATCH_SIZE stack buffer and no heap allocations,
+ * except one compiled template when the template has blocks.
+ * @param html_template Template string (same syntax and limits as simplet_render_html)
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_INVALID_SIZE, ERROR_NO_MEMORY (blocks only) or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_html_to_sink(const char *html_template, const simplet_dictionary_t *dictionary,
+                                                       simplet_sink_fn write_fn, void *context);
+
+/**
+ * Render a template given by pointer and length straight into a sink
+ * @param html_template Template text (need not be NUL-terminated)
+ * @param length Bytes of template text
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY (blocks only) or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_html_n_to_sink(const char *html_template, size_t length,
+                                                         const simplet_dictionary_t *dictionary,
+                                                         simplet_sink_fn write_fn, void *context);
+
 #endif
@@ -0,0 +1,129 @@
+#ifndef SIMPLET_ARENA_H
+#define SIMPLET_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "simplet_instrument.h"
+
+// Default size of each heap chunk of a growable arena
+#ifndef SIMPLET_ARENA_CHUNK_SIZE
+#define SIMPLET_ARENA_CHUNK_SIZE 1024
+#endif
+
+// Forward declarations
+typedef struct simplet_arena_chunk simplet_arena_chunk_t;
+typedef struct simplet_arena simplet_arena_t;
+
+// Contiguous block that allocations are bumped out of
+struct simplet_arena_chunk {
+    simplet_arena_chunk_t *next;    // Next chunk (growable arenas only)
+    char *data;                     // Chunk memory
+    size_t capacity;                // Bytes in data
+    size_t used;                    // Bytes handed out from data
+};
+
+// Bump allocator; individual allocations are never freed, only reset together
+struct simplet_arena {
+    simplet_arena_chunk_t first;    // Caller buffer, or empty head of the heap chunk list
+    simplet_arena_chunk_t *current; // Chunk currently bumped from
+    size_t chunk_size;              // Heap chunk size, 0 if the arena cannot grow
+};
+
+/**
+ * Initialize an arena over a caller buffer, or as growable heap chunks
+ * @param arena Arena to initialize
+ * @param buffer Caller-owned memory, or NULL for a growable arena
+ * @param buffer_size Size of buffer in bytes (ignored when buffer is NULL)
+ */
+static inline void simplet_arena_init(simplet_arena_t *arena, void *buffer, size_t buffer_size) {
+    arena->first.next = NULL;
+    arena->first.data = buffer;
+    arena->first.capacity = buffer ? buffer_size : 0;
+    arena->first.used = 0;
+    arena->current = &arena->first;
+    arena->chunk_size = buffer ? 0 : SIMPLET_ARENA_CHUNK_SIZE;
+}
+
+/**
+ * Carve an allocation out of a chunk if it fits
+ * @param chunk Chunk to allocate from
+ * @param size Bytes requested
+ * @param align Required alignment (power of two)
+ * @return Memory or NULL if the chunk is too full
+ */
+static inline void* simplet_arena_chunk_alloc(simplet_arena_chunk_t *chunk, size_t size, size_t align) {
+    if (!chunk->data) return NULL;
+
+    uintptr_t start = ((uintptr_t)(chunk->data + chunk->used) + (align - 1)) & ~(uintptr_t)(align - 1);
+    size_t offset = (size_t)(start - (uintptr_t)chunk->data);
+    if (offset > chunk->capacity || size > chunk->capacity - offset) return NULL;
+
+    chunk->used = offset + size;
+    return (void *)start;
+}
+
+/**
+ * Allocate memory from the arena
+ * Chunks retained from before the last reset are reused before new ones are allocated.
+ * @param arena Arena to allocate from
+ * @param size Bytes requested
+ * @param align Required alignment (power of two)
+ * @return Memory or NULL if the arena is exhausted or out of heap
+ */
+static inline void* simplet_arena_alloc(simplet_arena_t *arena, size_t size, size_t align) {
+    void *memory = simplet_arena_chunk_alloc(arena->current, size, align);
+    if (memory) return memory;
+
+    // Move on to chunks kept from before the last reset
+    while (arena->current->next) {
+        arena->current = arena->current->next;
+        arena->current->used = 0;
+        memory = simplet_arena_chunk_alloc(arena->current, size, align);
+        if (memory) return memory;
+    }
+
+    if (arena->chunk_size == 0) return NULL;
+
+    size_t capacity = arena->chunk_size;
+    if (capacity < size + align) capacity = size + align;
+
+    simplet_arena_chunk_t *chunk = simplet_malloc(sizeof(simplet_arena_chunk_t) + capacity);
+    if (!chunk) return NULL;
+
+    chunk->next = NULL;
+    chunk->data = (char *)(chunk + 1);
+    chunk->capacity = capacity;
+    chunk->used = 0;
+
+    arena->current->next = chunk;
+    arena->current = chunk;
+    return simplet_arena_chunk_alloc(chunk, size, align);
+}
+
+/**
+ * Release every allocation at once, keeping chunks for reuse
+ * @param arena Arena to reset
+ */
+static inline void simplet_arena_reset(simplet_arena_t *arena) {
+    arena->first.used = 0;
+    arena->current = &arena->first;
+}
+
+/**
+ * Free the heap chunks of an arena (the caller buffer is left alone)
+ * @param arena Arena to destroy
+ */
+static inline void simplet_arena_destroy(simplet_arena_t *arena) {
+    simplet_arena_chunk_t *chunk = arena->first.next;
+    while (chunk) {
+        simplet_arena_chunk_t *next = chunk->next;
+        simplet_free(chunk);
+        chunk = next;
+    }
+    arena->first.next = NULL;
+    simplet_arena_reset(arena);
+}
+
+#endif // SIMPLET_ARENA_H
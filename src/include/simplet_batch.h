@@ -0,0 +1,61 @@
+#ifndef SIMPLET_BATCH_H
+#define SIMPLET_BATCH_H
+
+#include <stddef.h>
+#include "simplet_dictionary.h"
+#include "simplet_template.h"
+#include "simplet_parallel.h"
+
+/*
+ * Batch rendering
+ * Renders one compiled template once per dictionary, in order, into one
+ * output: an email per recipient, a row per record, a file per device. The
+ * template is parsed once and every row is written in place at the end of
+ * one growing buffer, so a row costs its lookups and copies and nothing else.
+ * Rows are concatenated as they are; put any separator in the template.
+ *
+ * Rows may be split across workers, which run on the executor set with
+ * simplet_set_executor. Each worker renders a contiguous run of rows into
+ * its own buffer and the runs are joined in order, so the output is the
+ * same for any number of workers. The built-in executor runs them on the pool
+ * started by simplet_set_parallel_render, or all on the calling thread
+ * without one. Workers only read the template and the dictionaries:
+ * nothing may modify them during the batch, and value providers must be
+ * safe to call from several threads at once.
+ */
+
+// Most runs one batch is split into
+#ifndef SIMPLET_BATCH_MAX_WORKERS
+#define SIMPLET_BATCH_MAX_WORKERS SIMPLET_MAX_WORKERS
+#endif
+
+/**
+ * Render a compiled template once per dictionary into one string
+ * @param compiled Template rendered for every row
+ * @param dictionaries One dictionary per row (NULL entries render the template without values)
+ * @param count Number of rows
+ * @param workers Runs the rows are split into (0 or 1 renders on the calling thread)
+ * @param output Receives the newly allocated, NUL-terminated output
+ * @param length If not NULL, receives the output length
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_NO_MEMORY (output is then NULL)
+ */
+simplet_dictionary_error_t simplet_render_batch(const simplet_template_t *compiled,
+                                                const simplet_dictionary_t *const *dictionaries, size_t count,
+                                                size_t workers, char **output, size_t *length);
+
+/**
+ * Render a compiled template once per dictionary straight into a sink
+ * Rows share one SIMPLET_SINK_SCRATCH_SIZE stack buffer, so small rows are
+ * coalesced into few sink calls. Rendering stops at the first failed write.
+ * @param compiled Template rendered for every row
+ * @param dictionaries One dictionary per row (NULL entries render the template without values)
+ * @param count Number of rows
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED if the sink failed
+ */
+simplet_dictionary_error_t simplet_render_batch_to_sink(const simplet_template_t *compiled,
+                                                        const simplet_dictionary_t *const *dictionaries, size_t count,
+                                                        simplet_sink_fn write_fn, void *context);
+
+#endif // SIMPLET_BATCH_H
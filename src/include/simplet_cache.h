@@ -0,0 +1,95 @@
+#ifndef SIMPLET_CACHE_H
+#define SIMPLET_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "simplet_dictionary.h"
+#include "simplet_template.h"
+
+// Forward declarations
+typedef struct simplet_cache_entry simplet_cache_entry_t;
+typedef struct simplet_render_cache simplet_render_cache_t;
+
+// Rendered page, keyed by template identity and dictionary generation
+struct simplet_cache_entry {
+    simplet_cache_entry_t *prev;            // More recently used entry
+    simplet_cache_entry_t *next;            // Less recently used entry
+    const void *template_id;                // Template string or compiled template pointer
+    const simplet_dictionary_t *dictionary; // Dictionary the page was rendered from
+    uint32_t generation;                    // simplet_dictionary_generation at render time
+    char *text;                             // Rendered page (NUL-terminated)
+    size_t length;                          // Page length excluding terminator
+};
+
+// Cache counters
+typedef struct {
+    size_t hits;            // Lookups served from cache
+    size_t misses;          // Lookups that rendered
+    size_t evictions;       // Pages dropped to stay within the budget
+    size_t bytes_used;      // Bytes held by cached pages and their entries
+    size_t entry_count;     // Pages currently cached
+} simplet_render_cache_stats_t;
+
+// Least recently used cache of rendered pages with a byte budget
+struct simplet_render_cache {
+    simplet_cache_entry_t *head;            // Most recently used
+    simplet_cache_entry_t *tail;            // Least recently used, evicted first
+    simplet_cache_entry_t *oversize;        // Last page too large to cache, freed on the next call
+    size_t byte_budget;                     // Maximum bytes_used
+    simplet_render_cache_stats_t stats;
+};
+
+/**
+ * Create a render cache
+ * @param byte_budget Maximum bytes of pages (plus bookkeeping) to keep
+ * @return New cache or NULL on allocation failure
+ */
+simplet_render_cache_t* create_simplet_render_cache(size_t byte_budget);
+
+/**
+ * Render a template string, or return the cached page for it
+ * Templates are identified by pointer, so they must not be modified while
+ * cached (string literals and flash constants are the intended use). A
+ * page is reused while the dictionary generation is unchanged, including
+ * what providers wrote into it (see simplet_dictionary_touch).
+ * @param cache Cache to use
+ * @param html_template Template string (same syntax and limits as simplet_render_html)
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param length If not NULL, receives the page length
+ * @return Page owned by the cache and valid until its next call, NULL on error
+ */
+const char* simplet_render_cache_html(simplet_render_cache_t *cache, const char *html_template,
+                                      simplet_dictionary_t *dictionary, size_t *length);
+
+/**
+ * Render a compiled template, or return the cached page for it
+ * @param cache Cache to use
+ * @param compiled Compiled template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param length If not NULL, receives the page length
+ * @return Page owned by the cache and valid until its next call, NULL on error
+ */
+const char* simplet_render_cache_template(simplet_render_cache_t *cache, const simplet_template_t *compiled,
+                                          const simplet_dictionary_t *dictionary, size_t *length);
+
+/**
+ * Get the cache counters
+ * @param cache Cache to query
+ * @param stats Receives the counters
+ */
+void simplet_render_cache_stats(const simplet_render_cache_t *cache, simplet_render_cache_stats_t *stats);
+
+/**
+ * Drop every cached page (counters other than bytes_used and entry_count are kept)
+ * Needed before a cached template is freed or changed in place.
+ * @param cache Cache to clear
+ */
+void clear_simplet_render_cache(simplet_render_cache_t *cache);
+
+/**
+ * Destroy a render cache and every cached page
+ * @param cache Cache to destroy
+ */
+void destroy_simplet_render_cache(simplet_render_cache_t *cache);
+
+#endif // SIMPLET_CACHE_H
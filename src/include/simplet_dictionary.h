@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include "simplet_arena.h"
 
 // C version feature detection
 #if __STDC_VERSION__ >= 201112L
@@ -54,10 +55,14 @@ typedef enum {
     ERROR_KEY_NOT_FOUND = -4,
     ERROR_INVALID_SIZE = -5,
     ERROR_RESIZE_FAILED = -6,
-    ERROR_KEY_TOO_LONG = -7
+    ERROR_KEY_TOO_LONG = -7,
+    ERROR_WRITE_FAILED = -8,
+    ERROR_BUFFER_TOO_SMALL = -9,
+    ERROR_READ_FAILED = -10,
+    ERROR_INVALID_PARENT = -11
 } simplet_dictionary_error_t;
 
-// Predefined dictionary sizes (must be prime numbers for better hash distribution)
+// Predefined dictionary sizes (prime numbers for better hash distribution with chaining)
 typedef enum {
     SIZE_TINY = 17,      // Small embedded applications
     SIZE_SMALL = 127,    // Typical small dictionaries
@@ -77,28 +82,63 @@ typedef enum {
 typedef struct entry entry_t;
 typedef struct simplet_dictionary simplet_dictionary_t;
 
-// Optimized entry structure with better cache alignment
-struct entry {
-    char *key;           // Owned by the dictionary (duplicated)
-    char *value;         // Owned by the dictionary (duplicated)
-    entry_t *next;       // Next entry in chain
-    uint32_t hash;       // Cached hash value for faster comparisons
-};
-
-// Main dictionary structure
-struct simplet_dictionary {
-    entry_t **buckets;          // Array of bucket pointers
-    size_t bucket_count;        // Number of buckets
-    size_t entry_count;         // Number of entries
-    size_t resize_threshold;    // Threshold for automatic resize
-    size_t total_allocated;     // Total bytes allocated for keys and values
-    bool auto_resize;           // Enable automatic resizing
-};
-
-// Compile-time validation of structure sizes
-#if HAS_C11
-    _Static_assert(sizeof(entry_t) <= 64, "entry_t should fit in a cache line");
-#endif
+/**
+ * Get a fresh generation number (process-wide, never repeats until it wraps)
+ * Dictionaries take one on creation and on every change, so a
+ * (dictionary, generation) pair identifies the contents exactly.
+ * @return Generation number
+ */
+uint32_t simplet_dictionary_next_generation(void);
+
+// Entry ownership flags (borrowed memory must outlive its use by the dictionary)
+#define ENTRY_OWNS_KEY   0x01   // Key was copied into dictionary memory
+#define ENTRY_OWNS_VALUE 0x02   // Value was copied into dictionary memory
+
+// Kinds of stored value
+typedef enum {
+    SIMPLET_VALUE_TEXT = 0,     // String in text
+    SIMPLET_VALUE_LIST = 1,     // Dictionaries in items, for {{#key}} sections
+    SIMPLET_VALUE_PROVIDER = 2, // Callback in provider, run each time a placeholder writes the value
+    SIMPLET_VALUE_INT = 3,      // Signed number in integer, formatted as it is written
+    SIMPLET_VALUE_UINT = 4,     // Unsigned number in unsigned_integer
+    SIMPLET_VALUE_FLOAT = 5,    // Floating point number in number
+    SIMPLET_VALUE_BOOL = 6      // 0 or 1 in integer, written as "false" or "true"
+} simplet_value_kind_t;
+
+// Kinds stored as a raw number rather than a string
+#define SIMPLET_VALUE_IS_NUMBER(kind) ((kind) >= SIMPLET_VALUE_INT)
+
+// Destination a provider writes its value to (see simplet_provider.h)
+typedef struct simplet_value_writer simplet_value_writer_t;
+
+/**
+ * Computes a value while it is rendered
+ * Called only when a placeholder using the key is written, never for keys
+ * the template does not reference.
+ * @param context Context given to simplet_dictionary_set_provider
+ * @param writer Destination for the value, valid only during the call
+ */
+typedef void (*simplet_provider_fn)(void *context, simplet_value_writer_t *writer);
+
+// Callback and context of a SIMPLET_VALUE_PROVIDER value
+typedef struct {
+    simplet_provider_fn fn;
+    void *context;
+} simplet_provider_t;
+
+// Stored value with its length, so readers never rescan it
+typedef struct {
+    union {
+        const char *text;                           // NUL-terminated at length; owned or borrowed per entry flags
+        const simplet_dictionary_t *const *items;   // List items (array owned per entry flags, items always borrowed)
+        const simplet_provider_t *provider;         // Callback (owned per entry flags, context always borrowed)
+        int64_t integer;                            // SIMPLET_VALUE_INT and SIMPLET_VALUE_BOOL, stored in place
+        uint64_t unsigned_integer;                  // SIMPLET_VALUE_UINT
+        double number;                              // SIMPLET_VALUE_FLOAT
+    };
+    uint32_t length;     // Length excluding terminator, or number of list items (0 for providers and numbers)
+    uint32_t kind;       // simplet_value_kind_t
+} simplet_value_t;
 
 /**
  * FNV-1a hash function - better distribution than DJB2
@@ -117,30 +157,151 @@ static inline uint32_t hash_key(const char *key) {
 }
 
 /**
- * Find next prime number (for bucket sizing)
- * @param n Starting number
- * @return Next prime >= n
+ * FNV-1a hash of a key given by pointer and length (same result as hash_key)
+ * @param key Key bytes
+ * @param key_len Number of bytes to hash
+ * @return 32-bit hash value
  */
-static inline size_t next_prime(size_t n) {
-    if (n <= 2) return 2;
-    if (n % 2 == 0) n++;
+static inline uint32_t hash_key_n(const char *key, size_t key_len) {
+    uint32_t hash = 2166136261U;  // FNV offset basis
 
-    while (1) {
-        bool is_prime = true;
-        for (size_t i = 3; i * i <= n; i += 2) {
-            if (n % i == 0) {
-                is_prime = false;
-                break;
-            }
-        }
-        if (is_prime) return n;
-        n += 2;
+    for (size_t i = 0; i < key_len; i++) {
+        hash ^= (uint32_t)(unsigned char)key[i];
+        hash *= 16777619U;  // FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * Allocate dictionary-owned memory from the arena, or the heap without one
+ * @param arena Dictionary arena or NULL
+ * @param size Bytes requested
+ * @param align Required alignment (power of two, arena only)
+ * @return Memory or NULL on failure
+ */
+static inline void* dictionary_alloc(simplet_arena_t *arena, size_t size, size_t align) {
+    return arena ? simplet_arena_alloc(arena, size, align) : simplet_malloc(size);
+}
+
+/**
+ * Release dictionary-owned memory (arena memory is reclaimed on clear)
+ * @param arena Dictionary arena or NULL
+ * @param memory Memory from dictionary_alloc
+ */
+static inline void dictionary_release(simplet_arena_t *arena, void *memory) {
+    if (!arena) simplet_free(memory);
+}
+
+/**
+ * Copy a string into dictionary-owned memory
+ * @param arena Dictionary arena or NULL
+ * @param str String to copy
+ * @param length Bytes of str to copy (a terminator is added)
+ * @return NUL-terminated copy or NULL on failure
+ */
+static inline char* dictionary_strndup(simplet_arena_t *arena, const char *str, size_t length) {
+    char *copy = dictionary_alloc(arena, length + 1, 1);
+    if (copy) {
+        memcpy(copy, str, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+/**
+ * Bytes of dictionary memory an owned value occupies
+ * @param value Stored value
+ * @return Size of the string with terminator, the item array or the provider
+ */
+static inline size_t value_allocated_size(const simplet_value_t *value) {
+    if (value->kind == SIMPLET_VALUE_LIST) return value->length * sizeof(value->items[0]);
+    if (value->kind == SIMPLET_VALUE_PROVIDER) return sizeof(simplet_provider_t);
+    return value->length + 1;
+}
+
+/**
+ * Copy a value's string, item array or provider into dictionary-owned memory
+ * @param arena Dictionary arena or NULL
+ * @param value Value to copy
+ * @return Copy (NUL-terminated for strings) or NULL on failure
+ */
+static inline const void* dictionary_copy_value(simplet_arena_t *arena, const simplet_value_t *value) {
+    if (value->kind == SIMPLET_VALUE_TEXT) return dictionary_strndup(arena, value->text, value->length);
+
+    // Item arrays and providers both hold pointers
+    size_t size = value_allocated_size(value);
+    void *copy = dictionary_alloc(arena, size ? size : 1, _Alignof(simplet_provider_t));
+    if (copy && size) memcpy(copy, value->items, size);
+    return copy;
+}
+
+// Buckets (or slots) filled since the last clear, so an arena dictionary clears only those
+typedef struct {
+    uint32_t *indices;      // Filled indices in fill order, NULL when not tracked
+    size_t count;           // Indices recorded, SIZE_MAX once more fills than buckets were seen
+} dictionary_filled_t;
+
+/**
+ * Size the filled list for a bucket array, forgetting what it recorded
+ * Only arena dictionaries track fills; the list is never longer than the array.
+ * @param filled Filled list of the dictionary
+ * @param arena Dictionary arena or NULL
+ * @param bucket_count Buckets (or slots) in the new array
+ * @return false on allocation failure (list untouched)
+ */
+static inline bool dictionary_filled_reserve(dictionary_filled_t *filled, const simplet_arena_t *arena,
+                                             size_t bucket_count) {
+    if (!arena || bucket_count > UINT32_MAX) return true;
+
+    uint32_t *indices = simplet_realloc(filled->indices, bucket_count * sizeof(uint32_t));
+    if (!indices) return false;
+
+    filled->indices = indices;
+    filled->count = 0;
+    return true;
+}
+
+/**
+ * Record a bucket (or slot) that went from empty to used
+ * A bucket emptied by a removal and filled again is recorded twice; past
+ * bucket_count records the list gives up until the next clear.
+ * @param filled Filled list of the dictionary
+ * @param bucket_count Buckets (or slots) in the array
+ * @param index Index of the bucket
+ */
+static inline void dictionary_filled_add(dictionary_filled_t *filled, size_t bucket_count, size_t index) {
+    if (!filled->indices || filled->count == SIZE_MAX) return;
+    if (filled->count == bucket_count) {
+        filled->count = SIZE_MAX;
+        return;
     }
+    filled->indices[filled->count++] = (uint32_t)index;
+}
+
+/**
+ * Tell whether the filled list names every used bucket (or slot)
+ * @param filled Filled list of the dictionary
+ * @return true if only the recorded indices need clearing
+ */
+static inline bool dictionary_filled_complete(const dictionary_filled_t *filled) {
+    return filled->indices && filled->count != SIZE_MAX;
 }
 
+// Storage backend: separate chaining (default) or open addressing
+#ifndef SIMPLET_DICTIONARY_OPEN_ADDRESSING
+    #define SIMPLET_DICTIONARY_OPEN_ADDRESSING 0
+#endif
+
+#if SIMPLET_DICTIONARY_OPEN_ADDRESSING
+    #include "simplet_dictionary_open.h"
+#else
+    #include "simplet_dictionary_chained.h"
+#endif
+
 /**
  * Create a new dictionary with specified initial capacity
- * @param initial_size Initial number of buckets (will be rounded to next prime)
+ * @param initial_size Initial number of buckets (rounded to next prime, or power of two for open addressing)
  * @param auto_resize Enable automatic resizing when load factor exceeds threshold
  * @return Pointer to new dictionary or NULL on failure
  */
@@ -149,178 +310,457 @@ static inline simplet_dictionary_t* create_simplet_dictionary(size_t initial_siz
         initial_size = SIZE_TINY;
     }
 
-    // Ensure prime number of buckets for better distribution
-    initial_size = next_prime(initial_size);
-
-    simplet_dictionary_t *dict = calloc(1, sizeof(simplet_dictionary_t));
+    simplet_dictionary_t *dict = simplet_calloc(1, sizeof(simplet_dictionary_t));
     if (!dict) return NULL;
 
-    dict->buckets = calloc(initial_size, sizeof(entry_t*));
-    if (!dict->buckets) {
-        free(dict);
+    if (!dictionary_storage_create(dict, initial_size)) {
+        simplet_free(dict);
         return NULL;
     }
 
-    dict->bucket_count = initial_size;
     dict->entry_count = 0;
     dict->total_allocated = 0;
+    dict->generation = simplet_dictionary_next_generation();
     dict->auto_resize = auto_resize;
-    dict->resize_threshold = (size_t)(initial_size * LOAD_FACTOR_MAX);
 
     return dict;
 }
 
 /**
- * Resize dictionary to new bucket count
- * @param dict Dictionary to resize
- * @param new_bucket_count New number of buckets
- * @return Error code
+ * Create a dictionary whose entries, keys and values come from a bump arena
+ * Nothing is freed individually; clear_simplet_dictionary resets the arena
+ * in one step, keeps its memory and empties only the buckets in use, so a
+ * warmed-up dictionary can be refilled request after request without
+ * touching the heap. The table tracks its filled buckets in four extra bytes
+ * per bucket. Memory of removed or overwritten values is reclaimed only on clear.
+ * @param initial_size Initial number of buckets (see create_simplet_dictionary)
+ * @param auto_resize Enable automatic resizing when load factor exceeds threshold
+ * @param buffer Caller-owned arena memory (must outlive the dictionary), or NULL
+ *               to grow in SIMPLET_ARENA_CHUNK_SIZE heap chunks
+ * @param buffer_size Size of buffer in bytes; a full buffer makes set fail with ERROR_NO_MEMORY
+ * @return Pointer to new dictionary or NULL on failure
  */
-static simplet_dictionary_error_t resize_simplet_dictionary(simplet_dictionary_t *dict, size_t new_bucket_count) {
-    if (!dict) return ERROR_NULL_PARAM;
-
-    new_bucket_count = next_prime(new_bucket_count);
-    if (new_bucket_count == dict->bucket_count) return SUCCESS;
-
-    // Allocate new bucket array
-    entry_t **new_buckets = calloc(new_bucket_count, sizeof(entry_t*));
-    if (!new_buckets) return ERROR_NO_MEMORY;
-
-    // Rehash all entries
-    for (size_t i = 0; i < dict->bucket_count; i++) {
-        entry_t *entry = dict->buckets[i];
-        while (entry) {
-            entry_t *next = entry->next;
-            size_t new_index = entry->hash % new_bucket_count;
-            entry->next = new_buckets[new_index];
-            new_buckets[new_index] = entry;
-            entry = next;
-        }
+static inline simplet_dictionary_t* create_simplet_dictionary_with_arena(size_t initial_size, bool auto_resize,
+                                                                         void *buffer, size_t buffer_size) {
+    if (initial_size == 0) {
+        initial_size = SIZE_TINY;
     }
 
-    // Replace old buckets
-    free(dict->buckets);
-    dict->buckets = new_buckets;
-    dict->bucket_count = new_bucket_count;
-    dict->resize_threshold = (size_t)(new_bucket_count * LOAD_FACTOR_MAX);
+    // Dictionary and arena state share one allocation
+    simplet_dictionary_t *dict = simplet_calloc(1, sizeof(simplet_dictionary_t) + sizeof(simplet_arena_t));
+    if (!dict) return NULL;
 
-    return SUCCESS;
+    // The arena is known before the table is made, so the table records its fills
+    dict->arena = (simplet_arena_t *)(dict + 1);
+    simplet_arena_init(dict->arena, buffer, buffer_size);
+
+    if (!dictionary_storage_create(dict, initial_size)) {
+        simplet_free(dict);
+        return NULL;
+    }
+
+    dict->generation = simplet_dictionary_next_generation();
+    dict->auto_resize = auto_resize;
+
+    return dict;
 }
 
 /**
- * Add or update a key-value pair in the dictionary
+ * Add or update an entry, copying key and/or value as requested
+ * Setting a string to the content it already has is not a change; setting
+ * a list always is, since its items may have changed in place.
  * @param dict Dictionary to modify
- * @param key Key string (will be duplicated internally)
- * @param value Value string (will be duplicated internally)
+ * @param key Key bytes (key_len already validated)
+ * @param key_len Length of key
+ * @param hash Hash of key
+ * @param value String (NUL-terminated at its length, already validated) or list
+ * @param copy ENTRY_OWNS_KEY and/or ENTRY_OWNS_VALUE for the parts to duplicate
  * @return Error code
  */
-static inline simplet_dictionary_error_t simplet_dictionary_set(simplet_dictionary_t *dict, const char *key, const char *value) {
-    if (!dict || !key || !value) return ERROR_NULL_PARAM;
-
-    // Check key length with bounds checking
-    size_t key_len = safe_strlen(key, MAX_KEY_SIZE);
-    if (key_len == SIZE_MAX || key_len >= MAX_KEY_SIZE) return ERROR_KEY_TOO_LONG;
-
-    uint32_t hash = hash_key(key);
-    size_t index = hash % dict->bucket_count;
+static inline simplet_dictionary_error_t dictionary_set_entry(simplet_dictionary_t *dict, const char *key, size_t key_len, uint32_t hash,
+                                                              const simplet_value_t *value, uint8_t copy) {
+    simplet_value_t stored = *value;
 
     // Check if key already exists
-    entry_t *entry = dict->buckets[index];
-    while (entry) {
-        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
-            // Update existing entry - validate value length first
-            size_t value_len = safe_strlen(value, MAX_VALUE_SIZE);
-            if (value_len == SIZE_MAX || value_len >= MAX_VALUE_SIZE) return ERROR_INVALID_SIZE;
-
-            char *new_value = strdup(value);
-            if (!new_value) return ERROR_NO_MEMORY;
-
-            // Update allocated size tracking
-            size_t old_value_len = safe_strlen(entry->value, MAX_VALUE_SIZE);
-            if (old_value_len == SIZE_MAX) old_value_len = 0;  // Defensive fallback
-            old_value_len += 1;
-            size_t new_value_len = value_len + 1;
-            dict->total_allocated = dict->total_allocated - old_value_len + new_value_len;
-
-            free(entry->value);
-            entry->value = new_value;
+    entry_t *entry = dictionary_find(dict, key, key_len, hash);
+    if (entry) {
+        // Numbers are compared by their bits, so an unchanged reading is not a change
+        if (SIMPLET_VALUE_IS_NUMBER(value->kind) && entry->value.kind == value->kind &&
+            entry->value.unsigned_integer == value->unsigned_integer) {
             return SUCCESS;
         }
-        entry = entry->next;
+
+        bool unchanged = value->kind == SIMPLET_VALUE_TEXT && entry->value.kind == SIMPLET_VALUE_TEXT &&
+                         entry->value.length == value->length &&
+                         memcmp(entry->value.text, value->text, value->length) == 0;
+
+        // Keep an identical owned copy (or the very same borrowed pointer) as is
+        if (unchanged && ((entry->flags & ENTRY_OWNS_VALUE) || entry->value.text == value->text)) return SUCCESS;
+
+        if (copy & ENTRY_OWNS_VALUE) {
+            stored.text = dictionary_copy_value(dict->arena, value);
+            if (!stored.text) return ERROR_NO_MEMORY;
+            dict->total_allocated += value_allocated_size(value);
+        }
+
+        // Update allocated size tracking
+        if (entry->flags & ENTRY_OWNS_VALUE) {
+            dict->total_allocated -= value_allocated_size(&entry->value);
+            dictionary_release(dict->arena, (char *)entry->value.text);
+        }
+
+        entry->value = stored;
+        entry->flags = (uint8_t)((entry->flags & ~ENTRY_OWNS_VALUE) | (copy & ENTRY_OWNS_VALUE));
+        if (!unchanged) dict->generation = simplet_dictionary_next_generation();
+        return SUCCESS;
     }
 
     // Check if resize is needed
-    if (dict->auto_resize && dict->entry_count >= dict->resize_threshold) {
+    if (dictionary_should_grow(dict)) {
         simplet_dictionary_error_t err = resize_simplet_dictionary(dict, dict->bucket_count * 2);
         if (err != SUCCESS) return err;
-        // Recalculate index after resize
-        index = hash % dict->bucket_count;
     }
 
-    // Validate value length before creating entry
-    size_t value_len = safe_strlen(value, MAX_VALUE_SIZE);
-    if (value_len == SIZE_MAX || value_len >= MAX_VALUE_SIZE) return ERROR_INVALID_SIZE;
-
     // Create new entry
-    entry_t *new_entry = malloc(sizeof(entry_t));
-    if (!new_entry) return ERROR_NO_MEMORY;
+    entry_t new_entry;
+    memset(&new_entry, 0, sizeof(new_entry));
+    new_entry.hash = hash;
+    new_entry.flags = copy;
 
-    new_entry->key = strdup(key);
-    if (!new_entry->key) {
-        free(new_entry);
-        return ERROR_NO_MEMORY;
+    if (entry_init_key(dict, &new_entry, key, key_len) != SUCCESS) return ERROR_NO_MEMORY;
+
+    if (copy & ENTRY_OWNS_VALUE) {
+        stored.text = dictionary_copy_value(dict->arena, value);
     }
+    new_entry.value = stored;
 
-    new_entry->value = strdup(value);
-    if (!new_entry->value) {
-        free(new_entry->key);
-        free(new_entry);
+    if (((copy & ENTRY_OWNS_VALUE) && !stored.text) || dictionary_insert(dict, &new_entry) != SUCCESS) {
+        if (copy & ENTRY_OWNS_VALUE) dictionary_release(dict->arena, (char *)stored.text);
+        entry_free_key(dict, &new_entry);
         return ERROR_NO_MEMORY;
     }
 
-    new_entry->hash = hash;
-    new_entry->next = dict->buckets[index];
-    dict->buckets[index] = new_entry;
     dict->entry_count++;
+    dict->generation = simplet_dictionary_next_generation();
 
-    // Track allocated memory (key + value strings including null terminators)
-    // key_len already validated above, value_len just validated
-    dict->total_allocated += key_len + 1 + value_len + 1;
+    // Track allocated memory (owned key and value, strings including null terminators)
+    if (copy & ENTRY_OWNS_KEY) dict->total_allocated += key_len + 1;
+    if (copy & ENTRY_OWNS_VALUE) dict->total_allocated += value_allocated_size(value);
 
     return SUCCESS;
 }
 
+/**
+ * Validate lengths and store an entry
+ * @param dict Dictionary to modify
+ * @param key Key bytes
+ * @param key_len Length of key, or SIZE_MAX to measure a NUL-terminated key
+ * @param value Value string
+ * @param value_len Length of value, or SIZE_MAX to measure a NUL-terminated value
+ * @param copy ENTRY_OWNS_KEY and/or ENTRY_OWNS_VALUE for the parts to duplicate
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t dictionary_set_checked(simplet_dictionary_t *dict, const char *key, size_t key_len,
+                                                                const char *value, size_t value_len, uint8_t copy) {
+    if (!dict || !key || !value) return ERROR_NULL_PARAM;
+
+    // Check key length with bounds checking
+    if (key_len == SIZE_MAX) key_len = safe_strlen(key, MAX_KEY_SIZE);
+    if (key_len == SIZE_MAX || key_len >= MAX_KEY_SIZE) return ERROR_KEY_TOO_LONG;
+
+    if (value_len == SIZE_MAX) value_len = safe_strlen(value, MAX_VALUE_SIZE);
+    if (value_len == SIZE_MAX || value_len >= MAX_VALUE_SIZE) return ERROR_INVALID_SIZE;
+
+    simplet_value_t stored = { .text = value, .length = (uint32_t)value_len, .kind = SIMPLET_VALUE_TEXT };
+    return dictionary_set_entry(dict, key, key_len, hash_key_n(key, key_len), &stored, copy);
+}
+
+/**
+ * Add or update a key-value pair in the dictionary
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Value string (will be duplicated internally)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set(simplet_dictionary_t *dict, const char *key, const char *value) {
+    return dictionary_set_checked(dict, key, SIZE_MAX, value, SIZE_MAX, ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE);
+}
+
+/**
+ * Add or update a key-value pair with known lengths (both are copied, nothing is rescanned)
+ * @param dict Dictionary to modify
+ * @param key Key bytes (need not be NUL-terminated)
+ * @param key_len Length of key
+ * @param value Value bytes (need not be NUL-terminated)
+ * @param value_len Length of value
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_n(simplet_dictionary_t *dict, const char *key, size_t key_len,
+                                                                  const char *value, size_t value_len) {
+    if (key_len == SIZE_MAX || value_len == SIZE_MAX) return ERROR_INVALID_SIZE;
+    return dictionary_set_checked(dict, key, key_len, value, value_len, ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE);
+}
+
+/**
+ * Add or update a key whose value is borrowed rather than copied
+ * The value must stay valid and unchanged while the dictionary can return it.
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Value string (pointer is stored)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_borrowed(simplet_dictionary_t *dict, const char *key, const char *value) {
+    return dictionary_set_checked(dict, key, SIZE_MAX, value, SIZE_MAX, ENTRY_OWNS_KEY);
+}
+
+/**
+ * Add or update a key with a borrowed value of known length
+ * @param dict Dictionary to modify
+ * @param key Key bytes (will be duplicated internally)
+ * @param key_len Length of key
+ * @param value Value string (pointer is stored), value[value_len] must be '\0'
+ * @param value_len Length of value
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_borrowed_n(simplet_dictionary_t *dict, const char *key, size_t key_len,
+                                                                           const char *value, size_t value_len) {
+    if (key_len == SIZE_MAX || value_len == SIZE_MAX) return ERROR_INVALID_SIZE;
+    return dictionary_set_checked(dict, key, key_len, value, value_len, ENTRY_OWNS_KEY);
+}
+
+/**
+ * Add or update an entry whose key and value are both borrowed (string literals, flash)
+ * @param dict Dictionary to modify
+ * @param key Key string (pointer is stored unless short enough to store inline)
+ * @param value Value string (pointer is stored)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_static(simplet_dictionary_t *dict, const char *key, const char *value) {
+    return dictionary_set_checked(dict, key, SIZE_MAX, value, SIZE_MAX, 0);
+}
+
+/**
+ * Add or update a list of dictionaries, iterated by {{#key}}...{{/key}}
+ * The array of pointers is copied; the dictionaries are borrowed and must
+ * outlive their use. A change inside an item does not change this
+ * dictionary's generation: set the list again after editing items so
+ * caches and incremental renders notice.
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param items Item dictionaries, rendered in order (may be NULL when count is 0)
+ * @param count Number of items
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_list(simplet_dictionary_t *dict, const char *key,
+                                                                     simplet_dictionary_t *const *items, size_t count) {
+    if (!dict || !key || (!items && count > 0)) return ERROR_NULL_PARAM;
+    if (count > UINT32_MAX / sizeof(items[0])) return ERROR_INVALID_SIZE;
+
+    size_t key_len = safe_strlen(key, MAX_KEY_SIZE);
+    if (key_len == SIZE_MAX || key_len >= MAX_KEY_SIZE) return ERROR_KEY_TOO_LONG;
+
+    simplet_value_t list = { .items = (const simplet_dictionary_t *const *)items, .length = (uint32_t)count,
+                             .kind = SIMPLET_VALUE_LIST };
+    return dictionary_set_entry(dict, key, key_len, hash_key_n(key, key_len), &list, ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE);
+}
+
+/**
+ * Store a number in place (nothing is allocated for the value)
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Number with its kind
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t dictionary_set_number(simplet_dictionary_t *dict, const char *key,
+                                                               const simplet_value_t *value) {
+    if (!dict || !key) return ERROR_NULL_PARAM;
+
+    size_t key_len = safe_strlen(key, MAX_KEY_SIZE);
+    if (key_len == SIZE_MAX || key_len >= MAX_KEY_SIZE) return ERROR_KEY_TOO_LONG;
+
+    return dictionary_set_entry(dict, key, key_len, hash_key_n(key, key_len), value, ENTRY_OWNS_KEY);
+}
+
+/**
+ * Add or update a signed integer, formatted only when it is rendered
+ * No string is formatted or allocated here; the renderer writes the digits
+ * straight into the output, or follows a format hint such as "{{ n | %05d }}".
+ * Setting the number a key already holds does not change the generation.
+ * get and get_n return NULL for numeric keys.
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Number
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_int(simplet_dictionary_t *dict, const char *key,
+                                                                    int64_t value) {
+    simplet_value_t stored = { .integer = value, .length = 0, .kind = SIMPLET_VALUE_INT };
+    return dictionary_set_number(dict, key, &stored);
+}
+
+/**
+ * Add or update an unsigned integer, formatted only when it is rendered
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Number
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_uint(simplet_dictionary_t *dict, const char *key,
+                                                                     uint64_t value) {
+    simplet_value_t stored = { .unsigned_integer = value, .length = 0, .kind = SIMPLET_VALUE_UINT };
+    return dictionary_set_number(dict, key, &stored);
+}
+
+/**
+ * Add or update a floating point number, formatted only when it is rendered
+ * Written like "%g" unless the placeholder has a hint such as "{{ t | %.1f }}".
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Number
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_float(simplet_dictionary_t *dict, const char *key,
+                                                                      double value) {
+    simplet_value_t stored = { .number = value, .length = 0, .kind = SIMPLET_VALUE_FLOAT };
+    return dictionary_set_number(dict, key, &stored);
+}
+
+/**
+ * Add or update a boolean, written as "true" or "false"
+ * {{?key}} renders its body only for true.
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param value Flag
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_bool(simplet_dictionary_t *dict, const char *key,
+                                                                     bool value) {
+    simplet_value_t stored = { .integer = value ? 1 : 0, .length = 0, .kind = SIMPLET_VALUE_BOOL };
+    return dictionary_set_number(dict, key, &stored);
+}
+
+/**
+ * Add or update a value computed by a callback when it is rendered
+ * Nothing is formatted or stored up front: the provider runs each time a
+ * placeholder using the key is written and writes straight into the output
+ * (see simplet_provider.h). Results are not tracked by the generation, so
+ * render caches and incremental updates only see new results after
+ * simplet_dictionary_touch. get and get_n return NULL for the key.
+ * @param dict Dictionary to modify
+ * @param key Key string (will be duplicated internally)
+ * @param fn Provider callback
+ * @param context Passed to fn (borrowed, must outlive its use by the dictionary)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_provider(simplet_dictionary_t *dict, const char *key,
+                                                                         simplet_provider_fn fn, void *context) {
+    if (!dict || !key || !fn) return ERROR_NULL_PARAM;
+
+    size_t key_len = safe_strlen(key, MAX_KEY_SIZE);
+    if (key_len == SIZE_MAX || key_len >= MAX_KEY_SIZE) return ERROR_KEY_TOO_LONG;
+
+    simplet_provider_t provider = { fn, context };
+    simplet_value_t value = { .provider = &provider, .length = 0, .kind = SIMPLET_VALUE_PROVIDER };
+    return dictionary_set_entry(dict, key, key_len, hash_key_n(key, key_len), &value, ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE);
+}
+
+/**
+ * Find the stored value for a key
+ * A key missing from the dictionary is looked up in its parent, and so on
+ * up the chain (see simplet_dictionary_set_parent).
+ * @param dictionary Dictionary to search
+ * @param key Key bytes (need not be NUL-terminated)
+ * @param key_len Length of key
+ * @param hash Hash of key (hash_key_n(key, key_len))
+ * @return Value with its length, or NULL if not found
+ */
+static inline const simplet_value_t* simplet_dictionary_find_value(const simplet_dictionary_t *dictionary, const char *key,
+                                                                   size_t key_len, uint32_t hash) {
+    if (!key) return NULL;
+
+    for (; dictionary; dictionary = dictionary->parent) {
+        const entry_t *entry = dictionary_find(dictionary, key, key_len, hash);
+        if (entry) return &entry->value;
+    }
+    return NULL;
+}
+
+/**
+ * Find the stored string for a key, ignoring lists, providers and numbers
+ * @param dictionary Dictionary to search
+ * @param key Key bytes (need not be NUL-terminated)
+ * @param key_len Length of key
+ * @param hash Hash of key (hash_key_n(key, key_len))
+ * @return String value with its length, or NULL if not found or not a string
+ */
+static inline const simplet_value_t* simplet_dictionary_find_text(const simplet_dictionary_t *dictionary, const char *key,
+                                                                  size_t key_len, uint32_t hash) {
+    const simplet_value_t *value = simplet_dictionary_find_value(dictionary, key, key_len, hash);
+    return value && value->kind == SIMPLET_VALUE_TEXT ? value : NULL;
+}
+
+/**
+ * Get value associated with a key whose hash is already known
+ * @param dictionary Dictionary to search
+ * @param key Key to look up
+ * @param hash hash_key(key), typically computed once ahead of time
+ * @return Value string, or NULL if not found or not a string
+ */
+static inline const char* simplet_dictionary_get_hashed(const simplet_dictionary_t *dictionary, const char *key, uint32_t hash) {
+    if (!dictionary || !key) return NULL;
+
+    const simplet_value_t *value = simplet_dictionary_find_text(dictionary, key, strlen(key), hash);
+    return value ? value->text : NULL;
+}
+
 /**
  * Get value associated with a key
  * @param dictionary Dictionary to search
  * @param key Key to look up
- * @return Value string or NULL if not found
+ * @return Value string, or NULL if not found or not a string
  */
 static inline const char* simplet_dictionary_get(const simplet_dictionary_t *dictionary, const char *key) {
     if (!dictionary || !key) return NULL;
+    return simplet_dictionary_get_hashed(dictionary, key, hash_key(key));
+}
 
-    uint32_t hash = hash_key(key);
-    size_t index = hash % dictionary->bucket_count;
+/**
+ * Get value for a key given by pointer and length (no NUL-terminated copy needed)
+ * @param dictionary Dictionary to search
+ * @param key Key bytes, e.g. a slice of a template
+ * @param key_len Length of key
+ * @return Value string, or NULL if not found or not a string
+ */
+static inline const char* simplet_dictionary_get_n(const simplet_dictionary_t *dictionary, const char *key, size_t key_len) {
+    if (!dictionary || !key) return NULL;
 
-    const entry_t *entry = dictionary->buckets[index];
-    while (entry) {
-        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
+    const simplet_value_t *value = simplet_dictionary_find_text(dictionary, key, key_len, hash_key_n(key, key_len));
+    return value ? value->text : NULL;
+}
 
-    return NULL;
+/**
+ * Get value for a key given by pointer and length whose hash is already known
+ * @param dictionary Dictionary to search
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @param hash hash_key_n(key, key_len), typically computed once ahead of time
+ * @return Value string, or NULL if not found or not a string
+ */
+static inline const char* simplet_dictionary_get_n_hashed(const simplet_dictionary_t *dictionary, const char *key,
+                                                          size_t key_len, uint32_t hash) {
+    const simplet_value_t *value = simplet_dictionary_find_text(dictionary, key, key_len, hash);
+    return value ? value->text : NULL;
 }
 
 /**
- * Check if a key exists in the dictionary
+ * Check if a key exists in the dictionary or its parent chain
  * @param dictionary Dictionary to search
  * @param key Key to check
  * @return true if key exists, false otherwise
  */
 static inline bool simplet_dictionary_contains(const simplet_dictionary_t *dictionary, const char *key) {
-    return simplet_dictionary_get(dictionary, key) != NULL;
+    if (!dictionary || !key) return false;
+    return simplet_dictionary_find_value(dictionary, key, strlen(key), hash_key(key)) != NULL;
 }
 
 /**
@@ -332,69 +772,62 @@ static inline bool simplet_dictionary_contains(const simplet_dictionary_t *dicti
 static inline simplet_dictionary_error_t simplet_dictionary_remove(simplet_dictionary_t *dictionary, const char *key) {
     if (!dictionary || !key) return ERROR_NULL_PARAM;
 
-    uint32_t hash = hash_key(key);
-    size_t index = hash % dictionary->bucket_count;
-
-    entry_t *entry = dictionary->buckets[index];
-    entry_t *prev = NULL;
-
-    while (entry) {
-        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                dictionary->buckets[index] = entry->next;
-            }
-
-            // Update allocated size tracking with safe string length checks
-            size_t key_len = safe_strlen(entry->key, MAX_KEY_SIZE);
-            size_t val_len = safe_strlen(entry->value, MAX_VALUE_SIZE);
-            if (key_len != SIZE_MAX && val_len != SIZE_MAX) {
-                dictionary->total_allocated -= (key_len + 1 + val_len + 1);
-            }
-
-            free(entry->key);
-            free(entry->value);
-            free(entry);
-            dictionary->entry_count--;
-
-            // Check if dictionary should shrink
-            if (dictionary->auto_resize &&
-                dictionary->bucket_count > SIZE_SMALL &&
-                dictionary->entry_count < (size_t)(dictionary->bucket_count * LOAD_FACTOR_MIN)) {
-                resize_simplet_dictionary(dictionary, dictionary->bucket_count / 2);
-            }
+    size_t key_len = safe_strlen(key, MAX_KEY_SIZE);
+    if (key_len == SIZE_MAX) return ERROR_KEY_NOT_FOUND;
 
-            return SUCCESS;
-        }
-        prev = entry;
-        entry = entry->next;
+    entry_t *entry = dictionary_find(dictionary, key, key_len, hash_key(key));
+    if (!entry) return ERROR_KEY_NOT_FOUND;
+
+    // Update allocated size tracking
+    if (entry->flags & ENTRY_OWNS_KEY) dictionary->total_allocated -= key_len + 1;
+    if (entry->flags & ENTRY_OWNS_VALUE) {
+        dictionary->total_allocated -= value_allocated_size(&entry->value);
+        dictionary_release(dictionary->arena, (char *)entry->value.text);
+    }
+
+    entry_free_key(dictionary, entry);
+    dictionary_erase(dictionary, entry);
+    dictionary->entry_count--;
+    dictionary->generation = simplet_dictionary_next_generation();
+
+    // Check if dictionary should shrink
+    if (dictionary->auto_resize &&
+        dictionary->bucket_count > SIZE_SMALL &&
+        dictionary->entry_count < (size_t)(dictionary->bucket_count * LOAD_FACTOR_MIN)) {
+        resize_simplet_dictionary(dictionary, dictionary->bucket_count / 2);
     }
 
-    return ERROR_KEY_NOT_FOUND;
+    return SUCCESS;
 }
 
 /**
  * Clear all entries from the dictionary
+ * Arena dictionaries reset their arena instead of freeing entries one by one
+ * and empty only the buckets (or slots) filled since the last clear, so
+ * clearing costs as much as the fill did, however large the table has grown.
+ * Should removals and sets refill more buckets than the table has, the whole
+ * table is zeroed once instead. Heap dictionaries free every entry, which
+ * walks the whole table.
  * @param dictionary Dictionary to clear
  */
 static inline void clear_simplet_dictionary(simplet_dictionary_t *dictionary) {
     if (!dictionary) return;
 
-    for (size_t i = 0; i < dictionary->bucket_count; i++) {
-        entry_t *entry = dictionary->buckets[i];
-        while (entry) {
-            entry_t *next = entry->next;
-            free(entry->key);
-            free(entry->value);
-            free(entry);
-            entry = next;
+    if (dictionary->arena) {
+        simplet_arena_reset(dictionary->arena);
+    } else {
+        size_t cursor = 0;
+        entry_t *entry = NULL;
+        while ((entry = dictionary_next_entry(dictionary, &cursor, entry)) != NULL) {
+            entry_free_key(dictionary, entry);
+            if (entry->flags & ENTRY_OWNS_VALUE) simplet_free((char *)entry->value.text);
         }
-        dictionary->buckets[i] = NULL;
     }
+    dictionary_storage_clear(dictionary);
 
     dictionary->entry_count = 0;
     dictionary->total_allocated = 0;
+    dictionary->generation = simplet_dictionary_next_generation();
 }
 
 /**
@@ -405,8 +838,69 @@ static inline void destroy_simplet_dictionary(simplet_dictionary_t *dict) {
     if (!dict) return;
 
     clear_simplet_dictionary(dict);
-    free(dict->buckets);
-    free(dict);
+    dictionary_storage_destroy(dict);
+    if (dict->arena) simplet_arena_destroy(dict->arena);
+    simplet_free(dict);
+}
+
+/**
+ * Create a heap copy of a dictionary
+ * Owned keys and values are duplicated; borrowed ones stay borrowed, and
+ * list items and the parent are shared with the source.
+ * @param source Dictionary to copy
+ * @return New dictionary or NULL on NULL source or allocation failure
+ */
+static inline simplet_dictionary_t* copy_simplet_dictionary(const simplet_dictionary_t *source) {
+    if (!source) return NULL;
+
+    simplet_dictionary_t *copy = create_simplet_dictionary(source->bucket_count, source->auto_resize);
+    if (!copy) return NULL;
+    copy->parent = source->parent;
+
+    size_t cursor = 0;
+    entry_t *entry = NULL;
+    while ((entry = dictionary_next_entry(source, &cursor, entry)) != NULL) {
+        uint8_t owns = entry->flags & (ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE);
+        if (dictionary_set_entry(copy, entry_key(entry), entry->key_length, entry->hash, &entry->value, owns) != SUCCESS) {
+            destroy_simplet_dictionary(copy);
+            return NULL;
+        }
+    }
+
+    return copy;
+}
+
+/**
+ * Layer a dictionary over a parent that supplies every key it lacks
+ * Lookups (get, contains and rendering) search the dictionary first and
+ * then the parent chain, so a per-request dictionary only has to hold the
+ * values that differ from a shared global one. Writes, removal, count and
+ * clear affect only the dictionary itself; set a key to "" to hide a
+ * parent value. The parent is borrowed and is never modified.
+ * @param dictionary Dictionary to layer
+ * @param parent Fallback dictionary, or NULL to remove the layering
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_INVALID_PARENT if the chain would loop
+ */
+static inline simplet_dictionary_error_t simplet_dictionary_set_parent(simplet_dictionary_t *dictionary,
+                                                                       const simplet_dictionary_t *parent) {
+    if (!dictionary) return ERROR_NULL_PARAM;
+
+    for (const simplet_dictionary_t *layer = parent; layer; layer = layer->parent) {
+        if (layer == dictionary) return ERROR_INVALID_PARENT;
+    }
+
+    dictionary->parent = parent;
+    dictionary->generation = simplet_dictionary_next_generation();
+    return SUCCESS;
+}
+
+/**
+ * Get the parent a dictionary falls back to
+ * @param dictionary Dictionary to query
+ * @return Parent or NULL if none (or dictionary is NULL)
+ */
+static inline const simplet_dictionary_t* simplet_dictionary_parent(const simplet_dictionary_t *dictionary) {
+    return dictionary ? dictionary->parent : NULL;
 }
 
 /**
@@ -437,6 +931,34 @@ static inline size_t simplet_dictionary_allocated_size(const simplet_dictionary_
     return dictionary ? dictionary->total_allocated : 0;
 }
 
+/**
+ * Get the generation of the dictionary contents
+ * Changes whenever a value is added, changed or removed; setting a key to
+ * the value it already has leaves it alone. A layered dictionary mixes in
+ * the generations of its parent chain, so a change to any layer shows.
+ * @param dictionary Dictionary to query
+ * @return Generation number or 0 if dict is NULL
+ */
+static inline uint32_t simplet_dictionary_generation(const simplet_dictionary_t *dictionary) {
+    if (!dictionary) return 0;
+
+    uint32_t generation = dictionary->generation;
+    for (const simplet_dictionary_t *layer = dictionary->parent; layer; layer = layer->parent) {
+        generation = (generation * 0x9E3779B1u) ^ layer->generation;
+    }
+    return generation;
+}
+
+/**
+ * Mark the contents as changed without changing any value
+ * For values that changed outside the dictionary, such as provider
+ * results, so render caches and incremental updates render them again.
+ * @param dictionary Dictionary to mark
+ */
+static inline void simplet_dictionary_touch(simplet_dictionary_t *dictionary) {
+    if (dictionary) dictionary->generation = simplet_dictionary_next_generation();
+}
+
 /**
  * Check if dictionary is empty
  * @param dictionary Dictionary to check
@@ -446,5 +968,45 @@ static inline bool simplet_dictionary_is_empty(const simplet_dictionary_t *dicti
     return !dictionary || dictionary->entry_count == 0;
 }
 
+/*
+ * Packed dictionary blobs
+ * A flat, byte-aligned, little-endian image of the text and number entries
+ * of a dictionary, for persisting it in one piece (an NVS blob, a file) and
+ * loading it at boot without a set call per key:
+ *   header  "SPLT", version byte 1, three zero bytes, uint32 entry count
+ *   entry   uint8 kind, uint8 key length, key bytes, NUL, then by kind:
+ *           text              uint16 length, bytes, NUL
+ *           int, uint, float  8 bytes: two's complement, unsigned, IEEE 754 bits
+ *           bool              1 byte, 0 or 1
+ * Keys and strings are NUL-terminated in place, so a loaded dictionary can
+ * point straight into the blob.
+ */
+#define SIMPLET_BLOB_VERSION 1
+#define SIMPLET_BLOB_HEADER_SIZE 12
+
+/**
+ * Create a dictionary from a blob written by simplet_dictionary_save
+ * The table is sized once from the entry count, so loading never resizes,
+ * and lengths come from the blob, so nothing is measured.
+ * @param blob Blob bytes (need not be aligned)
+ * @param length Bytes of blob
+ * @param borrow true to point keys and strings into the blob, which must then
+ *               stay unchanged for the dictionary's lifetime; false to copy them
+ * @return New auto-resizing dictionary, or NULL on NULL param, a malformed or
+ *         truncated blob or allocation failure
+ */
+simplet_dictionary_t* simplet_dictionary_load(const void *blob, size_t length, bool borrow);
+
+/**
+ * Write the text and number entries of a dictionary as a blob, snprintf style
+ * Lists, providers and the parent are not saved.
+ * @param dictionary Dictionary to save
+ * @param buffer Destination (may be NULL when capacity is 0, to measure)
+ * @param capacity Size of buffer in bytes
+ * @param needed If not NULL, receives the blob size
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_BUFFER_TOO_SMALL (nothing written)
+ */
+simplet_dictionary_error_t simplet_dictionary_save(const simplet_dictionary_t *dictionary, void *buffer,
+                                                   size_t capacity, size_t *needed);
 
 #endif // SIMPLET_DICTIONARY_H
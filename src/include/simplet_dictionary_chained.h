@@ -0,0 +1,288 @@
+#ifndef SIMPLET_DICTIONARY_CHAINED_H
+#define SIMPLET_DICTIONARY_CHAINED_H
+
+/*
+ * Separate chaining backend for simplet_dictionary.h (default)
+ * Prime bucket count, one heap (or arena) allocated entry per key.
+ * Do not include directly.
+ */
+
+#define SIMPLET_DICTIONARY_BACKEND "chained"
+
+// Optimized entry structure with better cache alignment
+struct entry {
+    const char *key;         // Duplicated, or borrowed without ENTRY_OWNS_KEY
+    simplet_value_t value;   // Duplicated, or borrowed without ENTRY_OWNS_VALUE
+    entry_t *next;           // Next entry in chain
+    uint32_t hash;           // Cached hash value for faster comparisons
+    uint16_t key_length;     // Key length excluding terminator
+    uint8_t flags;           // ENTRY_OWNS_* flags
+};
+
+// Main dictionary structure
+struct simplet_dictionary {
+    entry_t **buckets;          // Array of bucket pointers
+    size_t bucket_count;        // Number of buckets
+    size_t entry_count;         // Number of entries
+    size_t resize_threshold;    // Threshold for automatic resize
+    size_t total_allocated;     // Total bytes allocated for keys and values
+    uint32_t generation;        // Changes whenever the contents change
+    simplet_arena_t *arena;     // Arena for entries and strings, NULL to use the heap
+    const simplet_dictionary_t *parent; // Searched for keys missing here, or NULL
+    dictionary_filled_t filled; // Arena mode: buckets to empty on clear
+    bool auto_resize;           // Enable automatic resizing
+};
+
+// Compile-time validation of structure sizes
+#if HAS_C11
+    _Static_assert(sizeof(entry_t) <= 64, "entry_t should fit in a cache line");
+    _Static_assert(MAX_KEY_SIZE <= UINT16_MAX, "key length must fit in an entry");
+#endif
+
+/**
+ * Find next prime number (for bucket sizing)
+ * @param n Starting number
+ * @return Next prime >= n
+ */
+static inline size_t next_prime(size_t n) {
+    if (n <= 2) return 2;
+    if (n % 2 == 0) n++;
+
+    while (1) {
+        bool is_prime = true;
+        for (size_t i = 3; i * i <= n; i += 2) {
+            if (n % i == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime) return n;
+        n += 2;
+    }
+}
+
+/**
+ * Get the NUL-terminated key of an entry
+ * @param entry Entry to query
+ * @return Key string
+ */
+static inline const char* entry_key(const entry_t *entry) {
+    return entry->key;
+}
+
+/**
+ * Store key in a detached entry, copying it when ENTRY_OWNS_KEY is set
+ * @param dict Dictionary that will own the key
+ * @param entry Entry being prepared for insertion (flags already set)
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t entry_init_key(simplet_dictionary_t *dict, entry_t *entry, const char *key, size_t key_len) {
+    if (entry->flags & ENTRY_OWNS_KEY) {
+        key = dictionary_strndup(dict->arena, key, key_len);
+        if (!key) return ERROR_NO_MEMORY;
+    }
+    entry->key = key;
+    entry->key_length = (uint16_t)key_len;
+    return SUCCESS;
+}
+
+/**
+ * Free the key owned by an entry
+ * @param dict Dictionary owning the key
+ * @param entry Entry whose key is released
+ */
+static inline void entry_free_key(simplet_dictionary_t *dict, entry_t *entry) {
+    if (entry->flags & ENTRY_OWNS_KEY) {
+        dictionary_release(dict->arena, (char *)entry->key);
+    }
+}
+
+/**
+ * Allocate the bucket array for a new dictionary
+ * @param dict Dictionary being created
+ * @param initial_size Requested number of buckets (rounded to next prime)
+ * @return true on success
+ */
+static inline bool dictionary_storage_create(simplet_dictionary_t *dict, size_t initial_size) {
+    // Ensure prime number of buckets for better distribution
+    initial_size = next_prime(initial_size);
+
+    dict->buckets = simplet_calloc(initial_size, sizeof(entry_t*));
+    if (!dict->buckets) return false;
+
+    if (!dictionary_filled_reserve(&dict->filled, dict->arena, initial_size)) {
+        simplet_free(dict->buckets);
+        return false;
+    }
+
+    dict->bucket_count = initial_size;
+    dict->resize_threshold = (size_t)(initial_size * LOAD_FACTOR_MAX);
+    return true;
+}
+
+/**
+ * Resize dictionary to new bucket count
+ * @param dict Dictionary to resize
+ * @param new_bucket_count New number of buckets
+ * @return Error code
+ */
+static simplet_dictionary_error_t resize_simplet_dictionary(simplet_dictionary_t *dict, size_t new_bucket_count) {
+    if (!dict) return ERROR_NULL_PARAM;
+
+    new_bucket_count = next_prime(new_bucket_count);
+    if (new_bucket_count == dict->bucket_count) return SUCCESS;
+
+    // Allocate new bucket array
+    entry_t **new_buckets = simplet_calloc(new_bucket_count, sizeof(entry_t*));
+    if (!new_buckets) return ERROR_NO_MEMORY;
+
+    if (!dictionary_filled_reserve(&dict->filled, dict->arena, new_bucket_count)) {
+        simplet_free(new_buckets);
+        return ERROR_NO_MEMORY;
+    }
+
+    // Rehash all entries
+    for (size_t i = 0; i < dict->bucket_count; i++) {
+        entry_t *entry = dict->buckets[i];
+        while (entry) {
+            entry_t *next = entry->next;
+            size_t new_index = entry->hash % new_bucket_count;
+            if (!new_buckets[new_index]) dictionary_filled_add(&dict->filled, new_bucket_count, new_index);
+            entry->next = new_buckets[new_index];
+            new_buckets[new_index] = entry;
+            entry = next;
+        }
+    }
+
+    // Replace old buckets
+    simplet_free(dict->buckets);
+    dict->buckets = new_buckets;
+    dict->bucket_count = new_bucket_count;
+    dict->resize_threshold = (size_t)(new_bucket_count * LOAD_FACTOR_MAX);
+    SIMPLET_STAT_ADD(SIMPLET_STAT_DICTIONARY_RESIZES, 1);
+
+    return SUCCESS;
+}
+
+/**
+ * Check whether an insertion should grow the bucket array first
+ * Chains never fill up, so this only happens with auto_resize.
+ * @param dict Dictionary about to receive a new key
+ * @return true if the dictionary should grow
+ */
+static inline bool dictionary_should_grow(const simplet_dictionary_t *dict) {
+    return dict->auto_resize && dict->entry_count >= dict->resize_threshold;
+}
+
+/**
+ * Find the entry for a key
+ * @param dict Dictionary to search
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @param hash hash_key(key)
+ * @return Entry or NULL if not found
+ */
+static inline entry_t* dictionary_find(const simplet_dictionary_t *dict, const char *key, size_t key_len, uint32_t hash) {
+    entry_t *entry = dict->buckets[hash % dict->bucket_count];
+    size_t probes = 0;
+    while (entry) {
+        probes++;
+        if (entry->hash == hash && entry->key_length == key_len && memcmp(entry->key, key, key_len) == 0) {
+            SIMPLET_STAT_LOOKUP(probes);
+            return entry;
+        }
+        entry = entry->next;
+    }
+    SIMPLET_STAT_LOOKUP(probes);
+    return NULL;
+}
+
+/**
+ * Insert a prepared entry for a key that is not yet present
+ * @param dict Dictionary to modify
+ * @param prepared Entry with key, value and hash filled in (copied)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t dictionary_insert(simplet_dictionary_t *dict, const entry_t *prepared) {
+    entry_t *new_entry = dictionary_alloc(dict->arena, sizeof(entry_t), _Alignof(entry_t));
+    if (!new_entry) return ERROR_NO_MEMORY;
+
+    *new_entry = *prepared;
+
+    size_t index = prepared->hash % dict->bucket_count;
+    if (!dict->buckets[index]) dictionary_filled_add(&dict->filled, dict->bucket_count, index);
+    new_entry->next = dict->buckets[index];
+    dict->buckets[index] = new_entry;
+    return SUCCESS;
+}
+
+/**
+ * Unlink and free an entry (its key and value must already be released)
+ * @param dict Dictionary to modify
+ * @param entry Entry returned by dictionary_find
+ */
+static inline void dictionary_erase(simplet_dictionary_t *dict, entry_t *entry) {
+    entry_t **link = &dict->buckets[entry->hash % dict->bucket_count];
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+    dictionary_release(dict->arena, entry);
+}
+
+/**
+ * Iterate over all entries
+ * @param dict Dictionary to walk
+ * @param cursor Iteration state, set to 0 before the first call
+ * @param current Entry returned by the previous call, NULL for the first call
+ * @return Next entry or NULL when done
+ */
+static inline entry_t* dictionary_next_entry(const simplet_dictionary_t *dict, size_t *cursor, entry_t *current) {
+    if (current && current->next) return current->next;
+
+    while (*cursor < dict->bucket_count) {
+        entry_t *entry = dict->buckets[(*cursor)++];
+        if (entry) return entry;
+    }
+    return NULL;
+}
+
+/**
+ * Drop all entries (keys and values must already be released)
+ * @param dict Dictionary to reset
+ */
+static inline void dictionary_storage_clear(simplet_dictionary_t *dict) {
+    // Arena entries go away with the arena reset; only the buckets they filled are emptied
+    if (dict->arena) {
+        if (dictionary_filled_complete(&dict->filled)) {
+            for (size_t i = 0; i < dict->filled.count; i++) dict->buckets[dict->filled.indices[i]] = NULL;
+        } else {
+            memset(dict->buckets, 0, dict->bucket_count * sizeof(entry_t*));
+        }
+        dict->filled.count = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < dict->bucket_count; i++) {
+        entry_t *entry = dict->buckets[i];
+        while (entry) {
+            entry_t *next = entry->next;
+            simplet_free(entry);
+            entry = next;
+        }
+        dict->buckets[i] = NULL;
+    }
+}
+
+/**
+ * Free the bucket array
+ * @param dict Dictionary being destroyed (must be empty)
+ */
+static inline void dictionary_storage_destroy(simplet_dictionary_t *dict) {
+    simplet_free(dict->buckets);
+    simplet_free(dict->filled.indices);
+}
+
+#endif // SIMPLET_DICTIONARY_CHAINED_H
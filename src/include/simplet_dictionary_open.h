@@ -0,0 +1,330 @@
+#ifndef SIMPLET_DICTIONARY_OPEN_H
+#define SIMPLET_DICTIONARY_OPEN_H
+
+/*
+ * Open addressing backend for simplet_dictionary.h
+ * Robin Hood linear probing over a power-of-two slot array. Entries live in
+ * the slots themselves with their hash, and short keys are stored inline,
+ * so a lookup usually touches one cache line and a short key costs only
+ * the value allocation. Selected with SIMPLET_DICTIONARY_OPEN_ADDRESSING.
+ * Do not include directly.
+ */
+
+#define SIMPLET_DICTIONARY_BACKEND "open"
+
+// Keys shorter than this are stored inside the slot (including null terminator)
+#ifndef SIMPLET_INLINE_KEY_SIZE
+#define SIMPLET_INLINE_KEY_SIZE 16
+#endif
+
+// Slot structure, stored inline in the slot array
+struct entry {
+    union {
+        const char *pointer;                        // Long keys, owned per ENTRY_OWNS_KEY
+        char inline_key[SIMPLET_INLINE_KEY_SIZE];   // Short keys stored in place
+    } key;
+    simplet_value_t value;   // Duplicated, or borrowed without ENTRY_OWNS_VALUE
+    uint32_t hash;           // Cached hash value for faster comparisons
+    uint16_t key_length;     // Key length excluding terminator
+    uint16_t probe;          // Distance from home slot + 1, 0 for an empty slot
+    uint8_t flags;           // ENTRY_OWNS_* flags
+};
+
+// Main dictionary structure
+struct simplet_dictionary {
+    entry_t *slots;             // Slot array
+    size_t bucket_count;        // Number of slots (power of two)
+    size_t entry_count;         // Number of entries
+    size_t resize_threshold;    // Entry count at which the slot array grows
+    size_t total_allocated;     // Total bytes allocated for keys and values
+    uint32_t generation;        // Changes whenever the contents change
+    simplet_arena_t *arena;     // Arena for long keys and values, NULL to use the heap
+    const simplet_dictionary_t *parent; // Searched for keys missing here, or NULL
+    dictionary_filled_t filled; // Arena mode: slots to empty on clear
+    uint32_t index_shift;       // 32 - log2(bucket_count)
+    bool auto_resize;           // Enable automatic shrinking
+};
+
+// Compile-time validation of structure sizes
+#if HAS_C11
+    _Static_assert(sizeof(entry_t) <= 64, "entry_t should fit in a cache line");
+    _Static_assert(MAX_KEY_SIZE <= UINT16_MAX, "key length must fit in a slot");
+#endif
+
+// Smallest slot array
+#define OPEN_MIN_SLOTS 8
+
+/**
+ * Home slot of a hash (Fibonacci hashing spreads FNV-1a's low bits)
+ * @param dict Dictionary
+ * @param hash Hash value
+ * @return Slot index
+ */
+static inline size_t slot_index(const simplet_dictionary_t *dict, uint32_t hash) {
+    return (size_t)((uint32_t)(hash * 2654435769U) >> dict->index_shift);
+}
+
+/**
+ * Get the NUL-terminated key of an entry
+ * @param entry Entry to query
+ * @return Key string
+ */
+static inline const char* entry_key(const entry_t *entry) {
+    return entry->key_length < SIMPLET_INLINE_KEY_SIZE ? entry->key.inline_key : entry->key.pointer;
+}
+
+/**
+ * Store key in a detached entry
+ * Short keys are always stored inline; long keys are copied when ENTRY_OWNS_KEY is set.
+ * @param dict Dictionary that will own the key
+ * @param entry Entry being prepared for insertion (flags already set)
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t entry_init_key(simplet_dictionary_t *dict, entry_t *entry, const char *key, size_t key_len) {
+    if (key_len < SIMPLET_INLINE_KEY_SIZE) {
+        memcpy(entry->key.inline_key, key, key_len);
+        entry->key.inline_key[key_len] = '\0';
+    } else if (entry->flags & ENTRY_OWNS_KEY) {
+        entry->key.pointer = dictionary_strndup(dict->arena, key, key_len);
+        if (!entry->key.pointer) return ERROR_NO_MEMORY;
+    } else {
+        entry->key.pointer = key;
+    }
+    entry->key_length = (uint16_t)key_len;
+    return SUCCESS;
+}
+
+/**
+ * Free the key owned by an entry (no-op for inline and borrowed keys)
+ * @param dict Dictionary owning the key
+ * @param entry Entry whose key is released
+ */
+static inline void entry_free_key(simplet_dictionary_t *dict, entry_t *entry) {
+    if (entry->key_length >= SIMPLET_INLINE_KEY_SIZE && (entry->flags & ENTRY_OWNS_KEY)) {
+        dictionary_release(dict->arena, (char *)entry->key.pointer);
+    }
+}
+
+/**
+ * Round a requested slot count up to a supported power of two
+ * @param slot_count Requested slots
+ * @param bits Receives log2 of the result
+ * @return Slot count
+ */
+static inline size_t open_capacity(size_t slot_count, uint32_t *bits) {
+    size_t capacity = OPEN_MIN_SLOTS;
+    *bits = 3;
+    while (capacity < slot_count && *bits < 31) {
+        capacity <<= 1;
+        (*bits)++;
+    }
+    return capacity;
+}
+
+/**
+ * Allocate an empty slot array of at least slot_count slots
+ * @param dict Dictionary receiving the array
+ * @param slot_count Requested slots (rounded up to a power of two)
+ * @return true on success
+ */
+static inline bool open_allocate_slots(simplet_dictionary_t *dict, size_t slot_count) {
+    uint32_t bits;
+    size_t capacity = open_capacity(slot_count, &bits);
+
+    entry_t *slots = simplet_calloc(capacity, sizeof(entry_t));
+    if (!slots) return false;
+
+    // Entries are placed again after this, so the fills recorded so far no longer apply
+    if (!dictionary_filled_reserve(&dict->filled, dict->arena, capacity)) {
+        simplet_free(slots);
+        return false;
+    }
+
+    dict->slots = slots;
+    dict->bucket_count = capacity;
+    dict->index_shift = 32 - bits;
+    dict->resize_threshold = (size_t)(capacity * LOAD_FACTOR_MAX);
+    return true;
+}
+
+/**
+ * Place an entry, displacing richer ones (Robin Hood); a free slot must exist
+ * @param dict Dictionary to modify
+ * @param entry Entry to place (probe is reset)
+ */
+static inline void open_place(simplet_dictionary_t *dict, entry_t entry) {
+    size_t mask = dict->bucket_count - 1;
+    size_t index = slot_index(dict, entry.hash);
+    entry.probe = 1;
+
+    while (dict->slots[index].probe != 0) {
+        entry_t *slot = &dict->slots[index];
+        if (slot->probe < entry.probe) {
+            entry_t displaced = *slot;
+            *slot = entry;
+            entry = displaced;
+        }
+        entry.probe++;
+        index = (index + 1) & mask;
+    }
+
+    dictionary_filled_add(&dict->filled, dict->bucket_count, index);
+    dict->slots[index] = entry;
+}
+
+/**
+ * Allocate the slot array for a new dictionary
+ * @param dict Dictionary being created
+ * @param initial_size Requested number of slots (rounded to a power of two)
+ * @return true on success
+ */
+static inline bool dictionary_storage_create(simplet_dictionary_t *dict, size_t initial_size) {
+    return open_allocate_slots(dict, initial_size);
+}
+
+/**
+ * Resize dictionary to a new slot count
+ * Never shrinks below what the current entries need.
+ * @param dict Dictionary to resize
+ * @param new_bucket_count New number of slots (rounded to a power of two)
+ * @return Error code
+ */
+static simplet_dictionary_error_t resize_simplet_dictionary(simplet_dictionary_t *dict, size_t new_bucket_count) {
+    if (!dict) return ERROR_NULL_PARAM;
+
+    size_t minimum = (size_t)(dict->entry_count / LOAD_FACTOR_MAX) + 1;
+    if (new_bucket_count < minimum) new_bucket_count = minimum;
+
+    uint32_t bits;
+    if (open_capacity(new_bucket_count, &bits) == dict->bucket_count) return SUCCESS;
+
+    entry_t *old_slots = dict->slots;
+    size_t old_count = dict->bucket_count;
+
+    if (!open_allocate_slots(dict, new_bucket_count)) return ERROR_NO_MEMORY;
+
+    // Rehash all entries
+    for (size_t i = 0; i < old_count; i++) {
+        if (old_slots[i].probe != 0) {
+            open_place(dict, old_slots[i]);
+        }
+    }
+
+    simplet_free(old_slots);
+    SIMPLET_STAT_ADD(SIMPLET_STAT_DICTIONARY_RESIZES, 1);
+    return SUCCESS;
+}
+
+/**
+ * Check whether an insertion must grow the slot array first
+ * Open addressing cannot exceed its capacity, so this applies even
+ * without auto_resize (which then only controls shrinking).
+ * @param dict Dictionary about to receive a new key
+ * @return true if the dictionary must grow
+ */
+static inline bool dictionary_should_grow(const simplet_dictionary_t *dict) {
+    return dict->entry_count >= dict->resize_threshold;
+}
+
+/**
+ * Find the entry for a key
+ * Stops early at an empty slot or at an entry closer to its home slot than
+ * the key would be, which the Robin Hood invariant allows.
+ * @param dict Dictionary to search
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @param hash hash_key(key)
+ * @return Entry or NULL if not found
+ */
+static inline entry_t* dictionary_find(const simplet_dictionary_t *dict, const char *key, size_t key_len, uint32_t hash) {
+    size_t mask = dict->bucket_count - 1;
+    size_t index = slot_index(dict, hash);
+
+    for (uint32_t probe = 1; ; probe++) {
+        entry_t *slot = &dict->slots[index];
+        if (slot->probe < probe) {
+            SIMPLET_STAT_LOOKUP(probe);
+            return NULL;
+        }
+        if (slot->hash == hash && slot->key_length == key_len && memcmp(entry_key(slot), key, key_len) == 0) {
+            SIMPLET_STAT_LOOKUP(probe);
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * Insert a prepared entry for a key that is not yet present
+ * @param dict Dictionary to modify (must be below its resize threshold)
+ * @param prepared Entry with key, value and hash filled in (copied)
+ * @return Error code
+ */
+static inline simplet_dictionary_error_t dictionary_insert(simplet_dictionary_t *dict, const entry_t *prepared) {
+    open_place(dict, *prepared);
+    return SUCCESS;
+}
+
+/**
+ * Remove an entry by shifting its probe run back (its key and value must already be released)
+ * @param dict Dictionary to modify
+ * @param entry Entry returned by dictionary_find
+ */
+static inline void dictionary_erase(simplet_dictionary_t *dict, entry_t *entry) {
+    size_t mask = dict->bucket_count - 1;
+    size_t index = (size_t)(entry - dict->slots);
+    size_t next = (index + 1) & mask;
+
+    while (dict->slots[next].probe > 1) {
+        dict->slots[index] = dict->slots[next];
+        dict->slots[index].probe--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    memset(&dict->slots[index], 0, sizeof(entry_t));
+}
+
+/**
+ * Iterate over all entries
+ * @param dict Dictionary to walk
+ * @param cursor Iteration state, set to 0 before the first call
+ * @param current Entry returned by the previous call, NULL for the first call
+ * @return Next entry or NULL when done
+ */
+static inline entry_t* dictionary_next_entry(const simplet_dictionary_t *dict, size_t *cursor, entry_t *current) {
+    (void)current;
+    while (*cursor < dict->bucket_count) {
+        entry_t *slot = &dict->slots[(*cursor)++];
+        if (slot->probe != 0) return slot;
+    }
+    return NULL;
+}
+
+/**
+ * Drop all entries (keys and values must already be released)
+ * @param dict Dictionary to reset
+ */
+static inline void dictionary_storage_clear(simplet_dictionary_t *dict) {
+    if (dictionary_filled_complete(&dict->filled)) {
+        for (size_t i = 0; i < dict->filled.count; i++) {
+            memset(&dict->slots[dict->filled.indices[i]], 0, sizeof(entry_t));
+        }
+    } else {
+        memset(dict->slots, 0, dict->bucket_count * sizeof(entry_t));
+    }
+    dict->filled.count = 0;
+}
+
+/**
+ * Free the slot array
+ * @param dict Dictionary being destroyed (must be empty)
+ */
+static inline void dictionary_storage_destroy(simplet_dictionary_t *dict) {
+    simplet_free(dict->slots);
+    simplet_free(dict->filled.indices);
+}
+
+#endif // SIMPLET_DICTIONARY_OPEN_H
@@ -0,0 +1,48 @@
+#ifndef SIMPLET_FILTER_H
+#define SIMPLET_FILTER_H
+
+#include <stddef.h>
+
+/*
+ * Escaping filters
+ * "{{ key | html }}" escapes the value while it is written, so values can
+ * be stored raw in the dictionary. Without a known filter name the whole
+ * text between the delimiters is the key, as before.
+ *
+ * "{{ key | %.1f }}" is a format hint for numbers stored with
+ * simplet_dictionary_set_int, _uint, _float or _bool: %[0+][width][.precision]
+ * followed by d, i, u, x, X, f, e or g, with width up to 31 and precision up
+ * to 15. Strings ignore the hint.
+ */
+
+// Escaping applied to a value as it is written
+typedef enum {
+    SIMPLET_FILTER_NONE = 0,    // Insert the value verbatim
+    SIMPLET_FILTER_HTML = 1,    // "html": & < > " ' become character references
+    SIMPLET_FILTER_URL = 2,     // "url": percent-encode all but RFC 3986 unreserved characters
+    SIMPLET_FILTER_JSON = 3     // "json": escape for use inside a JSON string literal
+} simplet_filter_t;
+
+// Longest replacement for a single byte (a JSON \u00XX escape)
+#define SIMPLET_FILTER_MAX_EXPANSION 6
+
+/**
+ * Compute the length of a value after escaping
+ * @param filter Filter to apply
+ * @param text Value bytes (may be NULL when length is 0)
+ * @param length Bytes of text
+ * @return Escaped length; equals length when nothing needs escaping
+ */
+size_t simplet_escaped_length(simplet_filter_t filter, const char *text, size_t length);
+
+/**
+ * Escape a value into a caller buffer (no terminator is written)
+ * @param filter Filter to apply
+ * @param text Value bytes (may be NULL when length is 0)
+ * @param length Bytes of text
+ * @param destination Buffer of at least simplet_escaped_length() bytes
+ * @return Bytes written
+ */
+size_t simplet_escape(simplet_filter_t filter, const char *text, size_t length, char *destination);
+
+#endif // SIMPLET_FILTER_H
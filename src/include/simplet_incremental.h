@@ -0,0 +1,98 @@
+#ifndef SIMPLET_INCREMENTAL_H
+#define SIMPLET_INCREMENTAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "simplet_dictionary.h"
+#include "simplet_template.h"
+
+// Forward declarations
+typedef struct simplet_segment simplet_segment_t;
+typedef struct simplet_incremental simplet_incremental_t;
+
+// Where a placeholder's value currently sits in the rendered page
+struct simplet_segment {
+    size_t offset;      // Output offset of the value
+    size_t length;      // Length of the value last emitted (0 if missing)
+    size_t op;          // Index of the placeholder operation
+};
+
+// Placeholder whose value changed during simplet_incremental_update
+typedef struct {
+    size_t placeholder;     // Placeholder id: index among the template's placeholders, in output order
+    const char *key;        // Placeholder key (NUL-terminated, owned by the compiled template)
+    const char *value;      // New value inside the page (not NUL-terminated)
+    size_t length;          // New value length, 0 when the key is missing or empty
+    size_t offset;          // Output offset of the new value
+} simplet_change_t;
+
+// Rendered page that remembers where each placeholder's value was written
+struct simplet_incremental {
+    const simplet_template_t *compiled;         // Template being rendered (not owned)
+    simplet_segment_t *segments;                // One per placeholder
+    char *output;                               // Rendered page (NUL-terminated)
+    size_t length;                              // Page length excluding terminator
+    size_t capacity;                            // Bytes allocated for output
+    const simplet_dictionary_t *dictionary;     // Dictionary of the last render or update
+    uint32_t generation;                        // Its generation at that point
+    char *scratch;                              // Number or provider output being placed, allocated on first use
+    size_t scratch_capacity;                    // Bytes allocated for scratch, excluding terminator
+    bool rendered;                              // Output holds a complete page
+};
+
+/**
+ * Create an incremental render of a compiled template
+ * Templates with blocks or partials change shape with the data and are not supported.
+ * @param compiled Compiled template (must outlive the incremental render)
+ * @return New incremental render or NULL on invalid input, a template with blocks or partials,
+ *         or allocation failure
+ */
+simplet_incremental_t* create_simplet_incremental(const simplet_template_t *compiled);
+
+/**
+ * Render the whole page and record every placeholder's position
+ * @param incremental Incremental render
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_incremental_render(simplet_incremental_t *incremental,
+                                                      const simplet_dictionary_t *dictionary);
+
+/**
+ * Bring the page up to date by rewriting only placeholders whose value changed
+ * Values are compared with what the page currently holds, so unchanged keys
+ * cost one lookup and nothing else; when the dictionary generation has not
+ * moved nothing is looked up at all (call simplet_dictionary_touch to have
+ * providers run again). Changed values of a different length
+ * shift the rest of the page. The first call renders the whole page and
+ * reports no changes.
+ * @param incremental Incremental render
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param changes Receives changed placeholders in output order (may be NULL when max_changes is 0)
+ * @param max_changes Capacity of changes
+ * @param change_count If not NULL, receives the number of changed placeholders
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY, or ERROR_BUFFER_TOO_SMALL if
+ *         more than max_changes placeholders changed (the page is still fully updated)
+ */
+simplet_dictionary_error_t simplet_incremental_update(simplet_incremental_t *incremental,
+                                                      const simplet_dictionary_t *dictionary,
+                                                      simplet_change_t *changes, size_t max_changes,
+                                                      size_t *change_count);
+
+/**
+ * Get the current page
+ * Change values point into this page and stay valid until the next update.
+ * @param incremental Incremental render
+ * @param length If not NULL, receives the page length
+ * @return Page (NUL-terminated), or NULL before the first render
+ */
+const char* simplet_incremental_output(const simplet_incremental_t *incremental, size_t *length);
+
+/**
+ * Destroy an incremental render (the compiled template is left alone)
+ * @param incremental Incremental render to destroy
+ */
+void destroy_simplet_incremental(simplet_incremental_t *incremental);
+
+#endif // SIMPLET_INCREMENTAL_H
@@ -0,0 +1,143 @@
+#ifndef SIMPLET_INSTRUMENT_H
+#define SIMPLET_INSTRUMENT_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+ * Optional instrumentation
+ * With SIMPLET_INSTRUMENTATION=1 every simplet allocation goes through a
+ * replaceable allocator and renders and dictionary lookups update global
+ * counters. Otherwise the wrappers below are plain malloc/free and the
+ * counting macros expand to nothing.
+ */
+#ifndef SIMPLET_INSTRUMENTATION
+#define SIMPLET_INSTRUMENTATION 0
+#endif
+
+// Replacement heap functions (e.g. heap_caps_* wrappers placing simplet in PSRAM)
+typedef struct {
+    void *(*malloc_fn)(size_t size);
+    void *(*realloc_fn)(void *memory, size_t size);
+    void (*free_fn)(void *memory);
+} simplet_allocator_t;
+
+// Counters since start-up or the last simplet_reset_stats
+typedef struct {
+    size_t allocations;             // malloc and calloc calls
+    size_t reallocations;           // realloc calls
+    size_t frees;                   // free calls with a non-NULL pointer
+    size_t bytes_requested;         // Bytes asked for by allocations and reallocations
+    size_t renders;                 // Completed renders, any entry point
+    size_t bytes_emitted;           // Output bytes of those renders
+    size_t placeholders_resolved;   // Placeholders replaced by a value
+    size_t placeholders_missed;     // Placeholders with a missing or empty value
+    size_t dictionary_lookups;      // Key searches, including those made by set and remove
+    size_t dictionary_probes;       // Entries or slots examined by those searches
+    size_t dictionary_max_probe;    // Longest single search
+    size_t dictionary_resizes;      // Bucket or slot arrays reallocated
+} simplet_stats_t;
+
+// Render phases reported to the render observer
+typedef enum {
+    SIMPLET_RENDER_BEGIN = 0,   // Before any output is produced (length is 0)
+    SIMPLET_RENDER_END = 1      // After the render (length is the output length)
+} simplet_render_event_t;
+
+/**
+ * Called around every render, e.g. to time it with esp_timer_get_time
+ * @param context Caller context passed through unchanged
+ * @param event Render phase
+ * @param length Output length at SIMPLET_RENDER_END, 0 otherwise
+ */
+typedef void (*simplet_render_observer_fn)(void *context, simplet_render_event_t event, size_t length);
+
+// Counter ids (internal, order matches simplet_stats_t)
+typedef enum {
+    SIMPLET_STAT_ALLOCATIONS = 0,
+    SIMPLET_STAT_REALLOCATIONS,
+    SIMPLET_STAT_FREES,
+    SIMPLET_STAT_BYTES_REQUESTED,
+    SIMPLET_STAT_RENDERS,
+    SIMPLET_STAT_BYTES_EMITTED,
+    SIMPLET_STAT_PLACEHOLDERS_RESOLVED,
+    SIMPLET_STAT_PLACEHOLDERS_MISSED,
+    SIMPLET_STAT_DICTIONARY_LOOKUPS,
+    SIMPLET_STAT_DICTIONARY_PROBES,
+    SIMPLET_STAT_DICTIONARY_MAX_PROBE,
+    SIMPLET_STAT_DICTIONARY_RESIZES,
+    SIMPLET_STAT_COUNT
+} simplet_stat_id_t;
+
+#if SIMPLET_INSTRUMENTATION
+
+/**
+ * Replace the allocator used by simplet
+ * Install it before creating any simplet object; memory must be released by
+ * the allocator that provided it.
+ * @param allocator Heap functions (copied), or NULL to restore malloc/realloc/free
+ */
+void simplet_set_allocator(const simplet_allocator_t *allocator);
+
+/**
+ * Install the render observer
+ * @param observer Callback, or NULL to remove it
+ * @param context Passed to every observer call
+ */
+void simplet_set_render_observer(simplet_render_observer_fn observer, void *context);
+
+/**
+ * Copy the current counters
+ * @param stats Receives the counters
+ */
+void simplet_get_stats(simplet_stats_t *stats);
+
+/**
+ * Reset all counters to zero
+ */
+void simplet_reset_stats(void);
+
+void* simplet_malloc(size_t size);
+void* simplet_calloc(size_t count, size_t size);
+void* simplet_realloc(void *memory, size_t size);
+void simplet_free(void *memory);
+
+// Internal counting, see the macros below
+void simplet_stat_add(simplet_stat_id_t id, size_t amount);
+void simplet_stat_lookup(size_t probes);
+void simplet_render_notify(simplet_render_event_t event, size_t length);
+
+#define SIMPLET_STAT_ADD(id, amount) simplet_stat_add((id), (amount))
+#define SIMPLET_STAT_LOOKUP(probes) simplet_stat_lookup(probes)
+#define SIMPLET_RENDER_NOTIFY(event, length) simplet_render_notify((event), (length))
+
+#else
+
+static inline void* simplet_malloc(size_t size) {
+    return malloc(size);
+}
+
+static inline void* simplet_calloc(size_t count, size_t size) {
+    return calloc(count, size);
+}
+
+static inline void* simplet_realloc(void *memory, size_t size) {
+    return realloc(memory, size);
+}
+
+/**
+ * Free memory returned by simplet, such as rendered pages
+ * Same as free() unless a custom allocator is installed.
+ * @param memory Memory to free (may be NULL)
+ */
+static inline void simplet_free(void *memory) {
+    free(memory);
+}
+
+#define SIMPLET_STAT_ADD(id, amount) ((void)0)
+#define SIMPLET_STAT_LOOKUP(probes) ((void)(probes))
+#define SIMPLET_RENDER_NOTIFY(event, length) ((void)0)
+
+#endif // SIMPLET_INSTRUMENTATION
+
+#endif // SIMPLET_INSTRUMENT_H
@@ -0,0 +1,90 @@
+#ifndef SIMPLET_PARALLEL_H
+#define SIMPLET_PARALLEL_H
+
+#include <stddef.h>
+
+/*
+ * Parallel rendering
+ * Large compiled templates can be rendered on several cores. The template
+ * is split between top-level operations into segments of similar size;
+ * every segment is rendered by a worker into its own buffer and the
+ * buffers are joined in order. Output is identical to a render on one
+ * thread, and every placeholder is rendered once.
+ *
+ * Off by default: enable it with simplet_set_parallel_render. It applies to
+ * simplet_template_render only: compile large pages once and render the
+ * compiled template. simplet_render_html, sinks and streams always render in
+ * order on the calling thread. Workers only read the template and the
+ * dictionary, so nothing may modify them during a render, and value
+ * providers must be safe to call from several threads at once.
+ *
+ * Workers run on an executor. The built-in one is a pool of threads (FreeRTOS
+ * tasks on ESP-IDF) started by simplet_set_parallel_render and kept waiting
+ * between renders, so a render only wakes them. Plug in an existing thread
+ * pool with simplet_set_executor instead.
+ */
+
+// Most workers a render is split into; the built-in pool has one thread less
+#ifndef SIMPLET_MAX_WORKERS
+#define SIMPLET_MAX_WORKERS 16
+#endif
+
+// Stack of each FreeRTOS task in the built-in pool
+#ifndef SIMPLET_TASK_STACK_SIZE
+#define SIMPLET_TASK_STACK_SIZE 4096
+#endif
+
+// Default literal text size of a compiled template from which renders are split
+#ifndef SIMPLET_PARALLEL_THRESHOLD
+#define SIMPLET_PARALLEL_THRESHOLD 4096
+#endif
+
+/**
+ * One task of a parallel run
+ * @param argument Argument passed to the executor's run
+ * @param index Task number, from 0 to count - 1
+ */
+typedef void (*simplet_task_fn)(void *argument, size_t index);
+
+// Runs a set of tasks on worker threads
+typedef struct {
+    /**
+     * Call task(argument, index) once for every index below count and return when all have returned
+     * Tasks may run in any order and on any threads, including the calling one.
+     * @param context The executor's context
+     * @param task Task to run
+     * @param argument Passed to every call
+     * @param count Number of calls
+     */
+    void (*run)(void *context, simplet_task_fn task, void *argument, size_t count);
+    void *context;      // Passed to run, e.g. a thread pool
+} simplet_executor_t;
+
+/**
+ * Get the built-in executor
+ * Runs tasks on the pool started by simplet_set_parallel_render and on the
+ * calling thread too. Without a pool, or while another run is using it,
+ * every task runs on the calling thread.
+ * @return Executor running on the built-in pool
+ */
+const simplet_executor_t* simplet_thread_executor(void);
+
+/**
+ * Replace the executor running parallel renders and batch workers
+ * Set it before rendering; it is read without locking.
+ * @param executor Executor (copied), or NULL to restore simplet_thread_executor
+ */
+void simplet_set_executor(const simplet_executor_t *executor);
+
+/**
+ * Enable or disable parallel rendering of large compiled templates
+ * Starts, resizes or stops the built-in pool: workers - 1 threads (FreeRTOS
+ * tasks at the caller's priority on ESP-IDF), the rendering thread being the
+ * last worker. Set it before rendering, never while a render is running; it
+ * is read without locking.
+ * @param workers Segments a large template is split into (0 or 1 disables parallel rendering and stops the pool)
+ * @param threshold Literal text size from which compiled templates are split (0 for SIMPLET_PARALLEL_THRESHOLD)
+ */
+void simplet_set_parallel_render(size_t workers, size_t threshold);
+
+#endif // SIMPLET_PARALLEL_H
@@ -0,0 +1,103 @@
+#ifndef SIMPLET_PARTIALS_H
+#define SIMPLET_PARTIALS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "simplet_dictionary.h"
+#include "simplet_template.h"
+
+// Forward declarations
+typedef struct simplet_partial simplet_partial_t;
+typedef struct simplet_partials simplet_partials_t;
+
+// Named template in a registry
+struct simplet_partial {
+    simplet_partial_t *next;                // Next registered template
+    const char *name;                       // NUL-terminated copy of the name
+    size_t name_length;                     // Name length
+    uint32_t hash;                          // hash_key_n(name, name_length)
+    simplet_template_t *compiled;           // Template rendered for {{>name}}
+    simplet_template_t *owned;              // compiled when the registry compiled it, else NULL
+};
+
+// Registry of named templates that {{>name}} tags are resolved against
+struct simplet_partials {
+    simplet_partial_t *head;                // Registered templates, most recent first
+    size_t count;                           // Number of registered templates
+    simplet_partial_t *retired;             // Replaced templates, destroyed with the registry
+};
+
+/**
+ * Create an empty partials registry
+ * @return New registry or NULL on allocation failure
+ */
+simplet_partials_t* create_simplet_partials(void);
+
+/**
+ * Compile a template string and register it under a name
+ * Every registered template is linked again, so partials may be added in
+ * any order and may include each other. Registering a name again replaces
+ * its template; templates linked outside the registry must then be linked
+ * again, and render caches holding pages that include it must be cleared.
+ * The replaced template is kept until the registry is destroyed, so
+ * templates still linked to it render the old markup rather than freed memory.
+ * @param partials Registry
+ * @param name Name used in {{>name}} (shorter than MAX_KEY_SIZE)
+ * @param html_template Template string (copied, same syntax and limits as simplet_render_html)
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG, ERROR_INVALID_SIZE or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add(simplet_partials_t *partials, const char *name,
+                                                const char *html_template);
+
+/**
+ * Register a read-only template without copying its text
+ * For shared markup in flash (EMBED_TXTFILES): only the operation list is
+ * allocated, see compile_simplet_template_borrowed.
+ * @param partials Registry
+ * @param name Name used in {{>name}} (shorter than MAX_KEY_SIZE)
+ * @param html_template Template text, which must outlive the registry
+ * @param length Bytes of template text
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add_borrowed(simplet_partials_t *partials, const char *name,
+                                                         const char *html_template, size_t length);
+
+/**
+ * Register an already compiled template, such as one generated by simplet_compile
+ * The registry links it, which writes its partial tags, but does not take ownership.
+ * @param partials Registry
+ * @param name Name used in {{>name}} (shorter than MAX_KEY_SIZE)
+ * @param compiled Compiled template, which must outlive the registry
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add_compiled(simplet_partials_t *partials, const char *name,
+                                                         simplet_template_t *compiled);
+
+/**
+ * Find a registered template by name
+ * @param partials Registry (may be NULL)
+ * @param name Name it was registered under
+ * @return Compiled template or NULL if not registered
+ */
+const simplet_template_t* simplet_partials_get(const simplet_partials_t *partials, const char *name);
+
+/**
+ * Resolve the {{>name}} tags of a compiled template against a registry
+ * Each tag is resolved once and stored in the template, so rendering a
+ * partial is a jump into its operations with no lookup or copy. Tags naming
+ * no registered template render nothing. Linking writes the template, so
+ * link before any thread renders it, never during a render; the registry
+ * must outlive every render of the template.
+ * @param partials Registry
+ * @param compiled Compiled template to link
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_KEY_NOT_FOUND if some tags were not resolved
+ */
+simplet_dictionary_error_t simplet_partials_link(const simplet_partials_t *partials, simplet_template_t *compiled);
+
+/**
+ * Destroy a registry and the templates it compiled
+ * @param partials Registry to destroy
+ */
+void destroy_simplet_partials(simplet_partials_t *partials);
+
+#endif // SIMPLET_PARTIALS_H
@@ -0,0 +1,60 @@
+#ifndef SIMPLET_PROVIDER_H
+#define SIMPLET_PROVIDER_H
+
+#include <stddef.h>
+#include "simplet_dictionary.h"
+
+/*
+ * Value providers
+ * A key set with simplet_dictionary_set_provider holds a callback instead
+ * of a string. The callback runs when a placeholder using the key is
+ * rendered and writes the value through these functions, so values the
+ * template never references cost nothing and values that are written cost
+ * no intermediate string. The placeholder's filter ("{{ key | html }}")
+ * is applied as the bytes are written.
+ *
+ * A provider runs once each time a placeholder using its key is rendered:
+ * renders that return an allocated string write into a buffer that grows as
+ * needed instead of measuring first. Only simplet_render_length and
+ * simplet_render_into, which must know the length, run it to measure. A
+ * provider always counts as set for {{?key}} and {{^key}}, since finding
+ * out whether it writes anything would mean running it; remove the key or
+ * set it to "" to hide a block.
+ */
+
+// Stack space simplet_value_printf formats into before it falls back to the heap
+#ifndef SIMPLET_VALUE_FORMAT_SIZE
+#define SIMPLET_VALUE_FORMAT_SIZE 64
+#endif
+
+/**
+ * Write part of a provided value
+ * May be called any number of times; the pieces are written in order.
+ * @param writer Writer passed to the provider
+ * @param data Bytes to write (may be NULL when length is 0)
+ * @param length Bytes of data
+ */
+void simplet_value_write(simplet_value_writer_t *writer, const char *data, size_t length);
+
+/**
+ * Write a NUL-terminated string as part of a provided value
+ * @param writer Writer passed to the provider
+ * @param text String to write (NULL writes nothing)
+ */
+void simplet_value_puts(simplet_value_writer_t *writer, const char *text);
+
+/**
+ * Format part of a provided value, printf style
+ * Output up to SIMPLET_VALUE_FORMAT_SIZE - 1 bytes is formatted on the
+ * stack; longer output is formatted into a temporary heap buffer.
+ * @param writer Writer passed to the provider
+ * @param format printf format string
+ * @return Bytes written, or -1 on a format or allocation error (nothing written)
+ */
+int simplet_value_printf(simplet_value_writer_t *writer, const char *format, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+#endif // SIMPLET_PROVIDER_H
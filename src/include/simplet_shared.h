@@ -0,0 +1,103 @@
+#ifndef SIMPLET_SHARED_H
+#define SIMPLET_SHARED_H
+
+#include <stddef.h>
+#include "simplet_dictionary.h"
+
+// Forward declarations
+typedef struct simplet_snapshot simplet_snapshot_t;
+typedef struct simplet_shared_dictionary simplet_shared_dictionary_t;
+
+/**
+ * Create a dictionary shared between rendering tasks and a writer
+ * Readers take immutable snapshots without locks and are never blocked by
+ * a writer. Writers are serialized: each update edits a private copy that
+ * replaces the current snapshot when committed (copy on write), and the
+ * old contents are freed when their last reader releases them.
+ * @param initial Initial contents, owned by the shared dictionary from now on (NULL for empty)
+ * @return New shared dictionary or NULL on allocation failure (initial is then destroyed)
+ */
+simplet_shared_dictionary_t* create_simplet_shared_dictionary(simplet_dictionary_t *initial);
+
+/**
+ * Take a snapshot of the current contents for rendering
+ * Lock-free and safe from any number of tasks at once. The snapshot never
+ * changes, so one render sees one consistent version of every value.
+ * @param shared Shared dictionary
+ * @return Snapshot to pass to simplet_snapshot_release, NULL if shared is NULL
+ */
+const simplet_snapshot_t* simplet_shared_dictionary_acquire(simplet_shared_dictionary_t *shared);
+
+/**
+ * Get the dictionary of a snapshot
+ * Use it with any render function while the snapshot is held; never modify it.
+ * @param snapshot Snapshot from simplet_shared_dictionary_acquire (may be NULL)
+ * @return Dictionary or NULL if snapshot is NULL
+ */
+const simplet_dictionary_t* simplet_snapshot_dictionary(const simplet_snapshot_t *snapshot);
+
+/**
+ * Release a snapshot, freeing it if it was replaced and this was its last reader
+ * May be called from another task than the one that acquired it, and after
+ * the shared dictionary was destroyed.
+ * @param snapshot Snapshot to release (may be NULL)
+ */
+void simplet_snapshot_release(const simplet_snapshot_t *snapshot);
+
+/**
+ * Start an update: lock out other writers and get a private copy to edit
+ * Edit the copy with the usual simplet_dictionary_* functions, then pass it
+ * to simplet_shared_dictionary_commit or simplet_shared_dictionary_abort.
+ * Readers keep seeing the current contents until the commit.
+ * @param shared Shared dictionary
+ * @return Writable copy, or NULL on NULL param or allocation failure (nothing is locked then)
+ */
+simplet_dictionary_t* simplet_shared_dictionary_begin(simplet_shared_dictionary_t *shared);
+
+/**
+ * Publish an edited copy as the current contents and unlock writers
+ * Waits only for readers still inside the few instructions of an acquire,
+ * never for renders.
+ * @param shared Shared dictionary
+ * @param edited Copy returned by simplet_shared_dictionary_begin (ownership passes to shared)
+ * @return SUCCESS, ERROR_NULL_PARAM (nothing to unlock after a failed begin)
+ *         or ERROR_NO_MEMORY (edited is discarded)
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_commit(simplet_shared_dictionary_t *shared,
+                                                            simplet_dictionary_t *edited);
+
+/**
+ * Discard an edited copy and unlock writers
+ * @param shared Shared dictionary
+ * @param edited Copy returned by simplet_shared_dictionary_begin (NULL does nothing)
+ */
+void simplet_shared_dictionary_abort(simplet_shared_dictionary_t *shared, simplet_dictionary_t *edited);
+
+/**
+ * Set one value: begin, simplet_dictionary_set and commit in one call
+ * Each call copies the whole dictionary; group several changes with begin/commit.
+ * @param shared Shared dictionary
+ * @param key Key string
+ * @param value Value string
+ * @return Error code from the copy, the set or the commit
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_set(simplet_shared_dictionary_t *shared, const char *key,
+                                                         const char *value);
+
+/**
+ * Remove one key: begin, simplet_dictionary_remove and commit in one call
+ * @param shared Shared dictionary
+ * @param key Key string
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY or ERROR_KEY_NOT_FOUND (nothing published)
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_remove(simplet_shared_dictionary_t *shared, const char *key);
+
+/**
+ * Destroy a shared dictionary
+ * No acquire or update may be in progress. Snapshots still held stay valid
+ * until they are released.
+ * @param shared Shared dictionary to destroy
+ */
+void destroy_simplet_shared_dictionary(simplet_shared_dictionary_t *shared);
+
+#endif // SIMPLET_SHARED_H
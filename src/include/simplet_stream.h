@@ -0,0 +1,97 @@
+#ifndef SIMPLET_STREAM_H
+#define SIMPLET_STREAM_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "simplet_dictionary.h"
+#include "simplet_template.h"
+
+// Longest placeholder body ("{{" to "}}", exclusive) a stream holds back while waiting for "}}"
+#ifndef SIMPLET_STREAM_TAG_SIZE
+#define SIMPLET_STREAM_TAG_SIZE 256
+#endif
+
+// Bytes read per call by simplet_render_source and simplet_render_file (stack allocated)
+#ifndef SIMPLET_STREAM_CHUNK_SIZE
+#define SIMPLET_STREAM_CHUNK_SIZE 512
+#endif
+
+/**
+ * Input callback for streaming renders (e.g. a wrapper around fread or lfs_file_read)
+ * @param context Caller context passed through unchanged
+ * @param buffer Destination for the next bytes of the template
+ * @param capacity Size of buffer
+ * @return Bytes read, 0 at the end of the template, negative on error
+ */
+typedef int (*simplet_source_fn)(void *context, char *buffer, size_t capacity);
+
+// Incremental renderer fed with template chunks (opaque)
+typedef struct simplet_stream simplet_stream_t;
+
+/**
+ * Create a streaming renderer
+ * Templates of any size can be fed in chunks of any size, including chunks
+ * that split "{{ key }}". Memory use is fixed: a SIMPLET_STREAM_TAG_SIZE
+ * buffer for an unfinished placeholder and a SIMPLET_SINK_SCRATCH_SIZE
+ * output buffer. Output matches simplet_render_html on the whole text,
+ * except that a placeholder body longer than SIMPLET_STREAM_TAG_SIZE is
+ * treated as text. Blocks need the whole template and are not evaluated:
+ * their tags render nothing and the text between them renders once, so
+ * render pages with blocks from a compiled template instead. Partial tags
+ * render nothing, as there is no registry to resolve them from.
+ * @param dictionary Key-value pairs for substitution (may be NULL, must outlive the stream)
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return New stream or NULL on invalid input or allocation failure
+ */
+simplet_stream_t* create_simplet_stream(const simplet_dictionary_t *dictionary, simplet_sink_fn write_fn, void *context);
+
+/**
+ * Render the next chunk of the template
+ * Output is written through the sink as the scratch buffer fills.
+ * @param stream Stream
+ * @param chunk Next template bytes (need not be NUL-terminated)
+ * @param length Bytes in chunk
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_stream_feed(simplet_stream_t *stream, const char *chunk, size_t length);
+
+/**
+ * Finish the template: emit any held-back text and flush the sink
+ * The stream can then be fed the next template.
+ * @param stream Stream
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_stream_finish(simplet_stream_t *stream);
+
+/**
+ * Destroy a stream (held-back text is discarded)
+ * @param stream Stream to destroy
+ */
+void destroy_simplet_stream(simplet_stream_t *stream);
+
+/**
+ * Render a template read through a source callback, with no size limit
+ * @param read_fn Source of template bytes
+ * @param read_context Passed to every read_fn call
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param write_fn Sink receiving the output in order
+ * @param write_context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY, ERROR_READ_FAILED or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_source(simplet_source_fn read_fn, void *read_context,
+                                                 const simplet_dictionary_t *dictionary,
+                                                 simplet_sink_fn write_fn, void *write_context);
+
+/**
+ * Render a template read from an open file (SPIFFS, LittleFS, SD card, ...)
+ * @param file File positioned at the start of the template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY, ERROR_READ_FAILED or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_file(FILE *file, const simplet_dictionary_t *dictionary,
+                                               simplet_sink_fn write_fn, void *context);
+
+#endif // SIMPLET_STREAM_H
@@ -0,0 +1,150 @@
+#ifndef SIMPLET_TEMPLATE_H
+#define SIMPLET_TEMPLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "simplet_dictionary.h"
+#include "simplet_filter.h"
+
+// Compiled template operation kinds
+typedef enum {
+    SIMPLET_OP_LITERAL = 0,     // Copy text verbatim
+    SIMPLET_OP_PLACEHOLDER = 1, // Substitute the dictionary value for key
+    SIMPLET_OP_SECTION = 2,     // {{#key}}: body once per list item, or once for a non-empty string
+    SIMPLET_OP_IF = 3,          // {{?key}}: body once if key is a non-empty string or list
+    SIMPLET_OP_UNLESS = 4,      // {{^key}}: body once if key is missing, empty or an empty list
+    SIMPLET_OP_PARTIAL = 5      // {{>name}}: a template from a partials registry, rendered in place
+} simplet_op_kind_t;
+
+// Deepest nesting of blocks; opening tags beyond it are ignored, and so are the closing tags that follow them
+#ifndef SIMPLET_MAX_BLOCK_DEPTH
+#define SIMPLET_MAX_BLOCK_DEPTH 16
+#endif
+
+// Deepest chain of partials rendered inside partials; deeper ones render nothing
+#ifndef SIMPLET_MAX_PARTIAL_DEPTH
+#define SIMPLET_MAX_PARTIAL_DEPTH 8
+#endif
+
+// Bytes of output coalesced before a sink is called (stack allocated per render)
+#ifndef SIMPLET_SINK_SCRATCH_SIZE
+#define SIMPLET_SINK_SCRATCH_SIZE 256
+#endif
+
+/**
+ * Output callback for streaming renders (e.g. a wrapper around httpd_resp_send_chunk)
+ * @param context Caller context passed through unchanged
+ * @param data Chunk of rendered output (not NUL-terminated)
+ * @param length Number of bytes in data, never 0
+ * @return 0 on success, any other value aborts the render
+ */
+typedef int (*simplet_sink_fn)(void *context, const char *data, size_t length);
+
+// Forward declarations
+typedef struct simplet_op simplet_op_t;
+typedef struct simplet_template simplet_template_t;
+
+// Single step of a compiled template
+struct simplet_op {
+    const char *text;    // Literal text, or NUL-terminated key for placeholders
+    size_t length;       // Literal length, or key length for placeholders
+    uint32_t hash;       // hash_key_n(text, length) for placeholders, 0 for literals
+    uint16_t kind;       // simplet_op_kind_t
+    uint16_t filter;     // simplet_filter_t applied to placeholder values
+    union {
+        uint32_t end;                       // Blocks: index of the first operation after the body
+        const simplet_template_t *partial;  // Partials: template set by simplet_partials_link, or NULL
+    };
+};
+
+// Template parsed once into a list of literal spans and placeholder lookups
+struct simplet_template {
+    simplet_op_t *ops;          // Operations in output order
+    size_t op_count;            // Number of operations
+    size_t placeholder_count;   // Number of placeholder operations
+    size_t literal_length;      // Total bytes of literal operations, including those inside blocks
+    size_t block_count;         // Number of section, if and unless operations
+    size_t partial_count;       // Number of partial operations
+};
+
+/**
+ * Compile a template for repeated rendering
+ * The template text is copied, so the source may be freed afterwards.
+ * Partials render nothing until the template is linked (simplet_partials_link).
+ * @param html_template Template string (same syntax and limits as simplet_render_html)
+ * @return Compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template(const char *html_template);
+
+/**
+ * Compile a template given by pointer and length
+ * No NUL terminator or size limit applies. The template text is copied.
+ * @param html_template Template text (may be NULL when length is 0)
+ * @param length Bytes of template text
+ * @return Compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template_n(const char *html_template, size_t length);
+
+/**
+ * Compile a read-only template without copying its text
+ * Literal operations point straight into html_template, so a template in
+ * flash (EMBED_TXTFILES) or an mmap'd file is rendered with no RAM copy;
+ * only the operation list and the keys are allocated.
+ * @param html_template Template text, which must outlive the compiled template
+ * @param length Bytes of template text
+ * @return Compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template_borrowed(const char *html_template, size_t length);
+
+/**
+ * Render a compiled template with dictionary substitutions
+ * Produces exactly the same output as simplet_render_html on the source text.
+ * @param compiled Compiled template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @return Newly allocated string with substitutions, never returns NULL
+ */
+char* simplet_template_render(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary);
+
+/**
+ * Render a compiled template straight into a sink without an output buffer
+ * Small pieces are coalesced in a SIMPLET_SINK_SCRATCH_SIZE stack buffer and
+ * flushed as it fills; literal runs larger than that are passed through as is.
+ * @param compiled Compiled template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param write_fn Sink receiving the output in order
+ * @param context Passed to every write_fn call
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED if the sink failed
+ */
+simplet_dictionary_error_t simplet_render_to_sink(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                                                  simplet_sink_fn write_fn, void *context);
+
+/**
+ * Render a compiled template into a caller-provided buffer
+ * Works like snprintf: output is truncated to capacity - 1 bytes and is always
+ * NUL-terminated when capacity > 0. No heap memory is used.
+ * @param buffer Destination (may be NULL when capacity is 0)
+ * @param capacity Size of buffer in bytes, including room for the terminator
+ * @param compiled Compiled template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @param needed If not NULL, receives the full output length excluding the terminator
+ * @return SUCCESS, ERROR_NULL_PARAM or ERROR_BUFFER_TOO_SMALL if output was truncated
+ */
+simplet_dictionary_error_t simplet_render_into(char *buffer, size_t capacity, const simplet_template_t *compiled,
+                                               const simplet_dictionary_t *dictionary, size_t *needed);
+
+/**
+ * Compute the exact length of a render without producing output
+ * Providers are run to measure what they write.
+ * @param compiled Compiled template
+ * @param dictionary Key-value pairs for substitution (may be NULL)
+ * @return Output length excluding the terminator, 0 if compiled is NULL
+ */
+size_t simplet_render_length(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary);
+
+/**
+ * Destroy a compiled template and free all memory
+ * @param compiled Template to destroy
+ */
+void destroy_simplet_template(simplet_template_t *compiled);
+
+#endif // SIMPLET_TEMPLATE_H
@@ -0,0 +1,2 @@
+# Included by ESP-IDF at project scope, so components can call simplet_add_template
+include(${CMAKE_CURRENT_LIST_DIR}/cmake/simplet_template.cmake)
@@ -1,44 +1,85 @@
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include "include/simplet.h"
 #include "include/simplet_dictionary.h"
+#include "simplet_internal.h"
+
+/* Walks a template string and writes literal runs and substituted values
+ * Keys are looked up straight from the template slice; keys too long to be
+ * stored in a dictionary are never looked up. Partial tags produce nothing
+ * (see simplet_partials_link). The first block tag hands the rest of the
+ * template to a compiled template, kept in *blocks for the caller to destroy.
+ * Returns: false if the compiled template could not be allocated
+ */
+static bool render_html_to_output(const char *html_template, size_t html_length,
+                                  const simplet_dictionary_t *dictionary, simplet_output_t *output,
+                                  simplet_template_t **blocks) {
+    simplet_placeholder_t placeholder;
+    size_t position = 0;
+
+    while (position < html_length && !output->failed) {
+        if (!simplet_find_placeholder(html_template, html_length, position, &placeholder)) {
+            output_write(output, html_template + position, html_length - position);
+            break;
+        }
 
-// Template delimiters
-#define DELIMITER_START "{{"
-#define DELIMITER_END "}}"
-#define DELIMITER_LENGTH 2
+        output_write(output, html_template + position, placeholder.start - position);
 
-// Maximum template size (including null terminator)
-#define MAX_TEMPLATE_SIZE 8192 + TERMINATOR
+        size_t name_start;
+        uint32_t kind = simplet_block_kind(html_template + placeholder.key_start, placeholder.key_length, &name_start);
 
-// Helper macro for allocating empty strings
-#define EMPTY_STRING() ({ char *s = malloc(1); if (s) s[0] = '\0'; s; })
+        // Without a registry a partial renders nothing
+        if (kind == SIMPLET_OP_PARTIAL) {
+            position = placeholder.end;
+            continue;
+        }
 
-// Compile-time assertions for assumptions
-_Static_assert(sizeof(char) == 1, "char must be 1 byte");
-_Static_assert(DELIMITER_LENGTH == 2, "Delimiter length mismatch");
+        if (kind != SIMPLET_OP_PLACEHOLDER) {
+            if (!*blocks) *blocks = simplet_compile_tail(html_template, html_length, placeholder.start);
+            if (!*blocks) return false;
 
-/* Helper function to skip whitespace characters
- * Returns: position after whitespace
- */
-static inline size_t skip_whitespace(const char *str, size_t pos, size_t max_len) {
-    while (pos < max_len && (str[pos] == ' ' || str[pos] == '\t')) {
-        pos++;
+            simplet_render_ops(*blocks, dictionary, output);
+            return true;
+        }
+
+        // If value is null or empty, render nothing (no key, no value)
+        const simplet_value_t *value = NULL;
+        if (placeholder.key_length < MAX_KEY_SIZE) {
+            const char *key = html_template + placeholder.key_start;
+            value = simplet_lookup_value(dictionary, key, placeholder.key_length,
+                                         hash_key_n(key, placeholder.key_length));
+        }
+        output_value(output, placeholder.filter, value);
+
+        position = placeholder.end;
     }
-    return pos;
+
+    return true;
 }
 
-/* Helper function to skip trailing whitespace backwards
- * Returns: position of last non-whitespace character + 1
+/* Renders a template of known length in one pass into a buffer that grows as needed
+ * Returns: newly allocated string with substitutions, NULL on allocation failure
  */
-static inline size_t skip_trailing_whitespace(const char *str, size_t start, size_t end) {
-    while (end > start && (str[end - 1] == ' ' || str[end - 1] == '\t')) {
-        end--;
+char* simplet_render_html_checked(const char *html_template, size_t html_length, const simplet_dictionary_t *dictionary) {
+    if (html_length == 0) {
+        return EMPTY_STRING();
     }
-    return end;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    // Start at the template size; values usually replace tags about as long as themselves
+    simplet_template_t *blocks = NULL;
+    simplet_output_t output;
+    output_init_growing(&output, html_length);
+    if (!render_html_to_output(html_template, html_length, dictionary, &output, &blocks)) output.failed = true;
+    destroy_simplet_template(blocks);
+
+    char *output_buffer = simplet_growing_finish(&output);
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.failed ? 0 : output.length);
+
+    return output_buffer;
 }
 
 /* Renders HTML template with dictionary substitutions
@@ -56,122 +97,68 @@ char* simplet_render_html(const char *html_template, simplet_dictionary_t *dicti
 
     const size_t html_length = safe_strlen(html_template, MAX_TEMPLATE_SIZE);
 
-    if (html_length == SIZE_MAX || html_length == 0) {
+    if (html_length == SIZE_MAX) {
         return EMPTY_STRING();
     }
 
-    // Create empty dictionary if none provided
-    bool empty_dictionary = false;
-    if (!dictionary) {
-        dictionary = EMPTY_DICTIONARY();
-        empty_dictionary = true;
-    }
-
-    // Initial buffer allocation based on template size plus dictionary content
-    // Use total_allocated which tracks all malloc'd strings (keys + values)
-    size_t total_dict_size = simplet_dictionary_allocated_size(dictionary);
-    size_t buffer_capacity = html_length + total_dict_size;
-    if (buffer_capacity < html_length || buffer_capacity < total_dict_size) { // Overflow check
-        buffer_capacity = SIZE_MAX / 2;
-    }
+    char *rendered = simplet_render_html_checked(html_template, html_length, dictionary);
+    return rendered ? rendered : EMPTY_STRING();
+}
 
-    char *output_buffer = malloc(buffer_capacity);
-    if (!output_buffer) {
+/* Renders a template given by pointer and length (no NUL scan, no size limit)
+ * Returns: newly allocated string with substitutions, never returns NULL
+ */
+char* simplet_render_html_n(const char *html_template, size_t length, const simplet_dictionary_t *dictionary) {
+    if (!html_template) {
         return EMPTY_STRING();
     }
 
-    size_t output_length = 0;
-    size_t position = 0;
+    char *rendered = simplet_render_html_checked(html_template, length, dictionary);
+    return rendered ? rendered : EMPTY_STRING();
+}
 
-    // Stack-allocated buffer for small keys (common case optimization)
-    _Alignas(16) char key_stack_buffer[MAX_KEY_SIZE];
-
-    while (position < html_length) {
-        // Check for template delimiter start
-        if (position + DELIMITER_LENGTH <= html_length && memcmp(html_template + position, DELIMITER_START, DELIMITER_LENGTH) == 0) {
-
-            // Skip opening delimiter and whitespace
-            size_t key_start = skip_whitespace(html_template, position + DELIMITER_LENGTH, html_length);
-
-            // Find closing delimiter
-            size_t search_pos = key_start;
-            size_t key_end = 0;
-
-            while (search_pos < html_length - 1) {
-                if (memcmp(html_template + search_pos, DELIMITER_END, DELIMITER_LENGTH) == 0) {
-                    key_end = search_pos;
-                    break;
-                }
-                search_pos++;
-             }
-
-            if (key_end > 0) {
-                // Trim trailing whitespace from key
-                const size_t key_actual_end = skip_trailing_whitespace(html_template, key_start, key_end);
-                const size_t key_length = key_actual_end - key_start;
-
-                if (key_length > 0) {
-                    // Use stack buffer for small keys, heap for large ones
-                    char *key_buffer;
-                    int heap_allocated = 0;
-
-                    if (key_length < MAX_KEY_SIZE) {
-                        key_buffer = key_stack_buffer;
-                    } else {
-                        key_buffer = malloc(key_length + 1);
-                        if (!key_buffer) {
-                            free(output_buffer);
-                            if (empty_dictionary) destroy_simplet_dictionary(dictionary);
-                            return EMPTY_STRING();
-                        }
-                        heap_allocated = 1;
-                    }
-
-                    // Copy and null-terminate key
-                    memcpy(key_buffer, html_template + key_start, key_length);
-                    key_buffer[key_length] = '\0';
-
-                    // Look up value in dictionary
-                    const char *value = simplet_dictionary_get(dictionary, key_buffer);
-
-                    if (value && value[0] != '\0') {
-                        // Substitute with value (only if non-empty) - validate length
-                        const size_t value_length = safe_strlen(value, MAX_VALUE_SIZE);
-                        if (value_length != SIZE_MAX && value_length > 0) {
-                            memcpy(output_buffer + output_length, value, value_length);
-                            output_length += value_length;
-                        }
-                    }
-                    // If value is null or empty, render nothing (no key, no value)
-
-                    if (heap_allocated) {
-                        free(key_buffer);
-                    }
-
-                    position = key_end + DELIMITER_LENGTH;
-                    continue;
-                }
-            }
-        }
+/* Streams a template of known length into a sink through a fixed scratch buffer
+ * Returns: SUCCESS, ERROR_NO_MEMORY or ERROR_WRITE_FAILED
+ */
+static simplet_dictionary_error_t render_html_n_to_sink(const char *html_template, size_t html_length,
+                                                        const simplet_dictionary_t *dictionary,
+                                                        simplet_sink_fn write_fn, void *context) {
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    simplet_template_t *blocks = NULL;
+    simplet_output_t output;
+    output_init_sink(&output, write_fn, context);
+    bool rendered = render_html_to_output(html_template, html_length, dictionary, &output, &blocks);
+    destroy_simplet_template(blocks);
+
+    bool flushed = output_flush(&output);
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.length);
+
+    if (!rendered) return ERROR_NO_MEMORY;
+    return flushed ? SUCCESS : ERROR_WRITE_FAILED;
+}
 
-        // Copy regular character
-        output_buffer[output_length++] = html_template[position++];
-    }
+/* Renders HTML template with dictionary substitutions into a sink
+ * Literal runs and values are written in order through a fixed scratch buffer.
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_INVALID_SIZE, ERROR_NO_MEMORY or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_html_to_sink(const char *html_template, const simplet_dictionary_t *dictionary,
+                                                       simplet_sink_fn write_fn, void *context) {
+    if (!html_template || !write_fn) return ERROR_NULL_PARAM;
 
-    // Null-terminate the result
-    output_buffer[output_length] = '\0';
+    const size_t html_length = safe_strlen(html_template, MAX_TEMPLATE_SIZE);
+    if (html_length == SIZE_MAX) return ERROR_INVALID_SIZE;
 
-    // Clean up temporary dictionary if we created it
-    if (empty_dictionary) {
-        destroy_simplet_dictionary(dictionary);
-    }
+    return render_html_n_to_sink(html_template, html_length, dictionary, write_fn, context);
+}
 
-    // Shrink buffer to actual size (optional optimization)
-    char *final_buffer = realloc(output_buffer, output_length + 1);
-    if (final_buffer) {
-        return final_buffer;
-    }
+/* Renders a template given by pointer and length into a sink
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_html_n_to_sink(const char *html_template, size_t length,
+                                                         const simplet_dictionary_t *dictionary,
+                                                         simplet_sink_fn write_fn, void *context) {
+    if ((!html_template && length > 0) || !write_fn) return ERROR_NULL_PARAM;
 
-    // If realloc fails, return the original buffer (still valid)
-    return output_buffer;
+    return render_html_n_to_sink(html_template, length, dictionary, write_fn, context);
 }
@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_batch.h"
+#include "simplet_internal.h"
+
+// A contiguous run of rows and the output it is rendered into
+typedef struct {
+    const simplet_template_t *compiled;
+    const simplet_dictionary_t *const *dictionaries;
+    size_t begin;                       // First row
+    size_t end;                         // One past the last row
+    simplet_output_t output;            // Growing output of the run
+} batch_run_t;
+
+/* Renders the rows of a run one after another into its growing output
+ * The first row sizes the buffer for the whole run, so later rows rarely
+ * grow it; every row is rendered once.
+ * Returns: SUCCESS or ERROR_NO_MEMORY
+ */
+static simplet_dictionary_error_t batch_render_run(batch_run_t *run) {
+    simplet_output_t *output = &run->output;
+    output_init_growing(output, run->compiled->literal_length);
+
+    for (size_t row = run->begin; row < run->end && !output->failed; row++) {
+        simplet_render_ops(run->compiled, run->dictionaries[row], output);
+
+        size_t rest = run->end - row - 1;
+        if (row == run->begin && rest > 0 && output->length <= SIZE_MAX / 2 / rest) {
+            size_t needed = output->length * rest;
+            if (needed > output->capacity - output->length) output_grow(output, needed);
+        }
+    }
+
+    return output->failed ? ERROR_NO_MEMORY : SUCCESS;
+}
+
+static void batch_task(void *argument, size_t index) {
+    batch_run_t *runs = argument;
+    batch_render_run(&runs[index]);
+}
+
+/* Renders every row into one allocation, in runs on the executor if asked to
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_render_batch(const simplet_template_t *compiled,
+                                                const simplet_dictionary_t *const *dictionaries, size_t count,
+                                                size_t workers, char **output, size_t *length) {
+    if (output) *output = NULL;
+    if (!compiled || !output || (!dictionaries && count > 0)) return ERROR_NULL_PARAM;
+
+    if (workers > count) workers = count;
+    if (workers > SIMPLET_BATCH_MAX_WORKERS) workers = SIMPLET_BATCH_MAX_WORKERS;
+    if (workers == 0) workers = 1;
+
+    batch_run_t single;
+    batch_run_t *runs = workers > 1 ? simplet_calloc(workers, sizeof(batch_run_t)) : &single;
+    if (!runs) return ERROR_NO_MEMORY;
+
+    for (size_t i = 0; i < workers; i++) {
+        runs[i] = (batch_run_t){
+            .compiled = compiled,
+            .dictionaries = dictionaries,
+            .begin = count / workers * i + (i < count % workers ? i : count % workers),
+        };
+        runs[i].end = runs[i].begin + count / workers + (i < count % workers ? 1 : 0);
+    }
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+    simplet_run_tasks(batch_task, runs, workers);
+
+    // Append the later runs to the first, whose buffer becomes the output
+    simplet_output_t *joined = &runs[0].output;
+    size_t total = 0;
+    for (size_t i = 0; i < workers; i++) {
+        if (runs[i].output.failed) joined->failed = true;
+        total += runs[i].output.length;
+    }
+
+    if (!joined->failed && total > joined->capacity) output_grow(joined, total - joined->length);
+    for (size_t i = 1; i < workers; i++) {
+        output_write(joined, runs[i].output.buffer, runs[i].output.length);
+        simplet_free(runs[i].output.buffer);
+    }
+
+    *output = simplet_growing_finish(joined);
+    simplet_dictionary_error_t result = *output ? SUCCESS : ERROR_NO_MEMORY;
+    if (result == SUCCESS && length) *length = total;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, result == SUCCESS ? total : 0);
+    if (runs != &single) simplet_free(runs);
+    return result;
+}
+
+/* Renders every row through one sink output
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_batch_to_sink(const simplet_template_t *compiled,
+                                                        const simplet_dictionary_t *const *dictionaries, size_t count,
+                                                        simplet_sink_fn write_fn, void *context) {
+    if (!compiled || !write_fn || (!dictionaries && count > 0)) return ERROR_NULL_PARAM;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    simplet_output_t output;
+    output_init_sink(&output, write_fn, context);
+    for (size_t row = 0; row < count && !output.failed; row++) {
+        simplet_render_ops(compiled, dictionaries[row], &output);
+    }
+
+    bool flushed = output_flush(&output);
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.length);
+
+    return flushed ? SUCCESS : ERROR_WRITE_FAILED;
+}
@@ -0,0 +1,210 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet.h"
+#include "include/simplet_cache.h"
+#include "simplet_internal.h"
+
+/* Computes the budget charge of a page
+ * Returns: page bytes plus terminator and entry bookkeeping
+ */
+static size_t entry_cost(size_t length) {
+    return sizeof(simplet_cache_entry_t) + length + TERMINATOR;
+}
+
+static void entry_destroy(simplet_cache_entry_t *entry) {
+    simplet_free(entry->text);
+    simplet_free(entry);
+}
+
+static void list_unlink(simplet_render_cache_t *cache, simplet_cache_entry_t *entry) {
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void list_push_front(simplet_render_cache_t *cache, simplet_cache_entry_t *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) cache->head->prev = entry;
+    else cache->tail = entry;
+    cache->head = entry;
+}
+
+/* Creates an empty cache
+ * Returns: cache or NULL on allocation failure
+ */
+simplet_render_cache_t* create_simplet_render_cache(size_t byte_budget) {
+    simplet_render_cache_t *cache = simplet_calloc(1, sizeof(simplet_render_cache_t));
+    if (!cache) return NULL;
+
+    cache->byte_budget = byte_budget;
+    return cache;
+}
+
+/* Finds the page for a template and dictionary, dropping pages of older generations
+ * A hit is moved to the front of the list.
+ * Returns: entry or NULL on a miss
+ */
+static simplet_cache_entry_t* cache_lookup(simplet_render_cache_t *cache, const void *template_id,
+                                           const simplet_dictionary_t *dictionary) {
+    uint32_t generation = simplet_dictionary_generation(dictionary);
+
+    for (simplet_cache_entry_t *entry = cache->head; entry; entry = entry->next) {
+        if (entry->template_id != template_id || entry->dictionary != dictionary) continue;
+
+        if (entry->generation != generation) {
+            // Stale page can never match again
+            list_unlink(cache, entry);
+            cache->stats.bytes_used -= entry_cost(entry->length);
+            cache->stats.entry_count--;
+            entry_destroy(entry);
+            return NULL;
+        }
+
+        if (entry != cache->head) {
+            list_unlink(cache, entry);
+            list_push_front(cache, entry);
+        }
+        return entry;
+    }
+
+    return NULL;
+}
+
+/* Takes ownership of a freshly rendered page
+ * Evicts least recently used pages until it fits; a page larger than the
+ * whole budget is held aside until the next call instead.
+ * Returns: entry holding the page, or NULL (page freed) on allocation failure
+ */
+static simplet_cache_entry_t* cache_store(simplet_render_cache_t *cache, const void *template_id,
+                                          const simplet_dictionary_t *dictionary, char *text) {
+    simplet_cache_entry_t *entry = simplet_malloc(sizeof(simplet_cache_entry_t));
+    if (!entry) {
+        simplet_free(text);
+        return NULL;
+    }
+
+    entry->prev = entry->next = NULL;
+    entry->template_id = template_id;
+    entry->dictionary = dictionary;
+    entry->generation = simplet_dictionary_generation(dictionary);
+    entry->text = text;
+    entry->length = strlen(text);
+
+    size_t cost = entry_cost(entry->length);
+    if (cost > cache->byte_budget) {
+        cache->oversize = entry;
+        return entry;
+    }
+
+    while (cache->tail && cache->stats.bytes_used + cost > cache->byte_budget) {
+        simplet_cache_entry_t *victim = cache->tail;
+        list_unlink(cache, victim);
+        cache->stats.bytes_used -= entry_cost(victim->length);
+        cache->stats.entry_count--;
+        cache->stats.evictions++;
+        entry_destroy(victim);
+    }
+
+    list_push_front(cache, entry);
+    cache->stats.bytes_used += cost;
+    cache->stats.entry_count++;
+    return entry;
+}
+
+/* Releases the page handed out by the previous call if it was not cached */
+static void cache_drop_oversize(simplet_render_cache_t *cache) {
+    if (cache->oversize) {
+        entry_destroy(cache->oversize);
+        cache->oversize = NULL;
+    }
+}
+
+static const char* entry_result(const simplet_cache_entry_t *entry, size_t *length) {
+    if (!entry) return NULL;
+    if (length) *length = entry->length;
+    return entry->text;
+}
+
+/* Serves a template string from cache or renders it with simplet_render_html
+ * Returns: page owned by the cache, NULL on NULL params or allocation failure
+ */
+const char* simplet_render_cache_html(simplet_render_cache_t *cache, const char *html_template,
+                                      simplet_dictionary_t *dictionary, size_t *length) {
+    if (!cache || !html_template) return NULL;
+
+    cache_drop_oversize(cache);
+
+    simplet_cache_entry_t *entry = cache_lookup(cache, html_template, dictionary);
+    if (entry) {
+        cache->stats.hits++;
+        return entry_result(entry, length);
+    }
+
+    cache->stats.misses++;
+    size_t html_length = safe_strlen(html_template, MAX_TEMPLATE_SIZE);
+    if (html_length == SIZE_MAX) return NULL;
+
+    // A failed render is not cached, or every later hit would serve the empty page
+    char *text = simplet_render_html_checked(html_template, html_length, dictionary);
+    if (!text) return NULL;
+
+    return entry_result(cache_store(cache, html_template, dictionary, text), length);
+}
+
+/* Serves a compiled template from cache or renders it with simplet_template_render
+ * Returns: page owned by the cache, NULL on NULL params or allocation failure
+ */
+const char* simplet_render_cache_template(simplet_render_cache_t *cache, const simplet_template_t *compiled,
+                                          const simplet_dictionary_t *dictionary, size_t *length) {
+    if (!cache || !compiled) return NULL;
+
+    cache_drop_oversize(cache);
+
+    simplet_cache_entry_t *entry = cache_lookup(cache, compiled, dictionary);
+    if (entry) {
+        cache->stats.hits++;
+        return entry_result(entry, length);
+    }
+
+    cache->stats.misses++;
+    char *text = simplet_template_render_checked(compiled, dictionary);
+    if (!text) return NULL;
+
+    return entry_result(cache_store(cache, compiled, dictionary, text), length);
+}
+
+/* Copies the cache counters */
+void simplet_render_cache_stats(const simplet_render_cache_t *cache, simplet_render_cache_stats_t *stats) {
+    if (!stats) return;
+    if (!cache) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = cache->stats;
+}
+
+/* Frees every cached page, keeping hit, miss and eviction counts */
+void clear_simplet_render_cache(simplet_render_cache_t *cache) {
+    if (!cache) return;
+
+    cache_drop_oversize(cache);
+    while (cache->head) {
+        simplet_cache_entry_t *entry = cache->head;
+        list_unlink(cache, entry);
+        entry_destroy(entry);
+    }
+    cache->stats.bytes_used = 0;
+    cache->stats.entry_count = 0;
+}
+
+/* Frees the cache and every cached page */
+void destroy_simplet_render_cache(simplet_render_cache_t *cache) {
+    if (!cache) return;
+
+    clear_simplet_render_cache(cache);
+    simplet_free(cache);
+}
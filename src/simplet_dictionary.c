@@ -0,0 +1,178 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include "include/simplet_dictionary.h"
+
+// Shared by every dictionary so that no two dictionary states get the same number
+static atomic_uint_least32_t generation_counter = 0;
+
+/* Hands out generation numbers for dictionary contents
+ * Returns: next generation, never 0 until the counter wraps
+ */
+uint32_t simplet_dictionary_next_generation(void) {
+    return (uint32_t)atomic_fetch_add_explicit(&generation_counter, 1, memory_order_relaxed) + 1;
+}
+
+static const char BLOB_MAGIC[4] = { 'S', 'P', 'L', 'T' };
+
+// Smallest entry: kind, key length, one key byte, NUL and a bool
+#define BLOB_MIN_ENTRY_SIZE 5
+
+static uint64_t read_le(const uint8_t *bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = size; i > 0; i--) value = (value << 8) | bytes[i - 1];
+    return value;
+}
+
+static void write_le(uint8_t *bytes, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++, value >>= 8) bytes[i] = (uint8_t)value;
+}
+
+/* Bytes an entry takes in a blob
+ * Returns: size, or 0 for values that are not saved (lists, providers)
+ */
+static size_t blob_entry_size(const entry_t *entry) {
+    size_t size = 2 + entry->key_length + TERMINATOR;
+
+    switch (entry->value.kind) {
+        case SIMPLET_VALUE_TEXT:
+            return size + 2 + entry->value.length + TERMINATOR;
+        case SIMPLET_VALUE_INT:
+        case SIMPLET_VALUE_UINT:
+        case SIMPLET_VALUE_FLOAT:
+            return size + 8;
+        case SIMPLET_VALUE_BOOL:
+            return size + 1;
+        default:
+            return 0;
+    }
+}
+
+/* Checks that a string of length bytes and its terminator lie inside the blob
+ * Returns: true if they do
+ */
+static bool blob_has_string(const uint8_t *cursor, const uint8_t *end, size_t length) {
+    return (size_t)(end - cursor) > length && cursor[length] == '\0';
+}
+
+/* Creates a dictionary sized for the blob's entry count and inserts every entry
+ * Returns: new dictionary, or NULL on a malformed blob or allocation failure
+ */
+simplet_dictionary_t* simplet_dictionary_load(const void *blob, size_t length, bool borrow) {
+    if (!blob || length < SIMPLET_BLOB_HEADER_SIZE) return NULL;
+
+    const uint8_t *cursor = blob;
+    const uint8_t *end = cursor + length;
+    if (memcmp(cursor, BLOB_MAGIC, sizeof(BLOB_MAGIC)) != 0 || read_le(cursor + 4, 4) != SIMPLET_BLOB_VERSION) {
+        return NULL;
+    }
+
+    // A count the blob cannot hold would only size a useless table
+    size_t count = (size_t)read_le(cursor + 8, 4);
+    if (count > (length - SIMPLET_BLOB_HEADER_SIZE) / BLOB_MIN_ENTRY_SIZE) return NULL;
+    cursor += SIMPLET_BLOB_HEADER_SIZE;
+
+    // Buckets for count entries below the maximum load factor: no resize while loading
+    simplet_dictionary_t *dict = create_simplet_dictionary(count + count / 3 + 1, true);
+    if (!dict) return NULL;
+
+    uint8_t copy = borrow ? 0 : ENTRY_OWNS_KEY | ENTRY_OWNS_VALUE;
+    size_t loaded = 0;
+    for (; loaded < count && end - cursor >= 2; loaded++) {
+        uint32_t kind = cursor[0];
+        size_t key_len = cursor[1];
+        cursor += 2;
+
+        if (key_len == 0 || key_len >= MAX_KEY_SIZE || !blob_has_string(cursor, end, key_len)) break;
+        const char *key = (const char *)cursor;
+        cursor += key_len + TERMINATOR;
+
+        simplet_value_t value = { .kind = kind };
+        uint8_t owns = copy;
+        if (kind == SIMPLET_VALUE_TEXT) {
+            if (end - cursor < 2) break;
+            value.length = (uint32_t)read_le(cursor, 2);
+            cursor += 2;
+
+            if (value.length >= MAX_VALUE_SIZE || !blob_has_string(cursor, end, value.length)) break;
+            value.text = (const char *)cursor;
+            cursor += value.length + TERMINATOR;
+        } else if (kind == SIMPLET_VALUE_INT || kind == SIMPLET_VALUE_UINT || kind == SIMPLET_VALUE_FLOAT) {
+            if (end - cursor < 8) break;
+            value.unsigned_integer = read_le(cursor, 8);
+            cursor += 8;
+            owns &= ENTRY_OWNS_KEY;
+        } else if (kind == SIMPLET_VALUE_BOOL) {
+            if (end - cursor < 1 || cursor[0] > 1) break;
+            value.integer = cursor[0];
+            cursor += 1;
+            owns &= ENTRY_OWNS_KEY;
+        } else {
+            break;
+        }
+
+        if (dictionary_set_entry(dict, key, key_len, hash_key_n(key, key_len), &value, owns) != SUCCESS) break;
+    }
+
+    // Every entry must have loaded and used the blob up exactly
+    if (loaded != count || cursor != end) {
+        destroy_simplet_dictionary(dict);
+        return NULL;
+    }
+
+    return dict;
+}
+
+/* Measures the saved entries, then writes the header and entries
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_BUFFER_TOO_SMALL
+ */
+simplet_dictionary_error_t simplet_dictionary_save(const simplet_dictionary_t *dictionary, void *buffer,
+                                                   size_t capacity, size_t *needed) {
+    if (!dictionary || (!buffer && capacity > 0)) return ERROR_NULL_PARAM;
+
+    size_t size = SIMPLET_BLOB_HEADER_SIZE;
+    size_t count = 0;
+    size_t cursor = 0;
+    entry_t *entry = NULL;
+    while ((entry = dictionary_next_entry(dictionary, &cursor, entry)) != NULL) {
+        size_t entry_size = blob_entry_size(entry);
+        size += entry_size;
+        if (entry_size > 0) count++;
+    }
+
+    if (needed) *needed = size;
+    if (capacity < size) return ERROR_BUFFER_TOO_SMALL;
+
+    uint8_t *out = buffer;
+    memcpy(out, BLOB_MAGIC, sizeof(BLOB_MAGIC));
+    write_le(out + 4, SIMPLET_BLOB_VERSION, 4);
+    write_le(out + 8, count, 4);
+    out += SIMPLET_BLOB_HEADER_SIZE;
+
+    cursor = 0;
+    entry = NULL;
+    while ((entry = dictionary_next_entry(dictionary, &cursor, entry)) != NULL) {
+        if (blob_entry_size(entry) == 0) continue;
+
+        out[0] = (uint8_t)entry->value.kind;
+        out[1] = (uint8_t)entry->key_length;
+        memcpy(out + 2, entry_key(entry), entry->key_length);
+        out[2 + entry->key_length] = '\0';
+        out += 2 + entry->key_length + TERMINATOR;
+
+        if (entry->value.kind == SIMPLET_VALUE_TEXT) {
+            write_le(out, entry->value.length, 2);
+            memcpy(out + 2, entry->value.text, entry->value.length);
+            out[2 + entry->value.length] = '\0';
+            out += 2 + entry->value.length + TERMINATOR;
+        } else if (entry->value.kind == SIMPLET_VALUE_BOOL) {
+            out[0] = entry->value.integer ? 1 : 0;
+            out += 1;
+        } else {
+            write_le(out, entry->value.unsigned_integer, 8);
+            out += 8;
+        }
+    }
+
+    return SUCCESS;
+}
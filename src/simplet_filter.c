@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_filter.h"
+#include "simplet_internal.h"
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+/* Helper function to classify URL bytes
+ * Returns: true for RFC 3986 unreserved characters, which are never encoded
+ */
+static inline bool url_unreserved(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+/* Finds the next byte the filter rewrites
+ * Returns: offset of the byte, or length if the rest can be copied as is
+ */
+static inline size_t filter_scan(simplet_filter_t filter, const char *text, size_t position, size_t length) {
+    switch (filter) {
+        case SIMPLET_FILTER_HTML:
+            return simplet_scan_html_special(text, position, length);
+        case SIMPLET_FILTER_JSON:
+            return simplet_scan_json_special(text, position, length);
+        case SIMPLET_FILTER_URL:
+            while (position < length && url_unreserved((unsigned char)text[position])) {
+                position++;
+            }
+            return position;
+        default:
+            return length;
+    }
+}
+
+/* Writes the replacement for a byte found by filter_scan
+ * Returns: replacement length, at most SIMPLET_FILTER_MAX_EXPANSION
+ */
+static size_t filter_escape_byte(simplet_filter_t filter, unsigned char c, char *out) {
+    const char *named = NULL;
+
+    if (filter == SIMPLET_FILTER_HTML) {
+        switch (c) {
+            case '&': named = "&amp;"; break;
+            case '<': named = "&lt;"; break;
+            case '>': named = "&gt;"; break;
+            case '"': named = "&quot;"; break;
+            default: named = "&#39;"; break;
+        }
+    } else if (filter == SIMPLET_FILTER_JSON) {
+        switch (c) {
+            case '"': named = "\\\""; break;
+            case '\\': named = "\\\\"; break;
+            case '\b': named = "\\b"; break;
+            case '\f': named = "\\f"; break;
+            case '\n': named = "\\n"; break;
+            case '\r': named = "\\r"; break;
+            case '\t': named = "\\t"; break;
+            default:
+                memcpy(out, "\\u00", 4);
+                out[4] = HEX_DIGITS[c >> 4];
+                out[5] = HEX_DIGITS[c & 0x0F];
+                return 6;
+        }
+    } else {
+        out[0] = '%';
+        out[1] = HEX_DIGITS[c >> 4];
+        out[2] = HEX_DIGITS[c & 0x0F];
+        return 3;
+    }
+
+    size_t length = strlen(named);
+    memcpy(out, named, length);
+    return length;
+}
+
+/* Sums plain runs and replacements
+ * Returns: escaped length
+ */
+size_t simplet_escaped_length(simplet_filter_t filter, const char *text, size_t length) {
+    if (filter == SIMPLET_FILTER_NONE) return length;
+
+    char replacement[SIMPLET_FILTER_MAX_EXPANSION];
+    size_t escaped = 0;
+    size_t position = 0;
+
+    while ((position = filter_scan(filter, text, position, length)) < length) {
+        escaped += filter_escape_byte(filter, (unsigned char)text[position], replacement) - 1;
+        position++;
+    }
+
+    return length + escaped;
+}
+
+/* Copies plain runs with memcpy and replaces special bytes
+ * Returns: bytes written
+ */
+size_t simplet_escape(simplet_filter_t filter, const char *text, size_t length, char *destination) {
+    size_t written = 0;
+    size_t position = 0;
+
+    while (position < length) {
+        size_t special = filter_scan(filter, text, position, length);
+        memcpy(destination + written, text + position, special - position);
+        written += special - position;
+        if (special == length) break;
+
+        written += filter_escape_byte(filter, (unsigned char)text[special], destination + written);
+        position = special + 1;
+    }
+
+    return written;
+}
+
+/* Writes an escaped value to an output
+ * A value without special bytes costs one scan and a single output_write.
+ */
+void simplet_output_escaped(simplet_output_t *output, uint32_t filter, const char *text, size_t length) {
+    char replacement[SIMPLET_FILTER_MAX_EXPANSION];
+    size_t position = 0;
+
+    while (position < length && !output->failed) {
+        size_t special = filter_scan((simplet_filter_t)filter, text, position, length);
+        output_write(output, text + position, special - position);
+        if (special == length) break;
+
+        output_write(output, replacement,
+                     filter_escape_byte((simplet_filter_t)filter, (unsigned char)text[special], replacement));
+        position = special + 1;
+    }
+}
+
+/* Compares a value, once escaped, with text already on a page
+ * expected must hold simplet_escaped_length() bytes.
+ * Returns: true if escaping text reproduces expected
+ */
+bool simplet_escaped_equals(uint32_t filter, const char *text, size_t length, const char *expected) {
+    char replacement[SIMPLET_FILTER_MAX_EXPANSION];
+    size_t position = 0;
+
+    while (position < length) {
+        size_t special = filter_scan((simplet_filter_t)filter, text, position, length);
+        if (memcmp(expected, text + position, special - position) != 0) return false;
+        expected += special - position;
+        if (special == length) break;
+
+        size_t escaped = filter_escape_byte((simplet_filter_t)filter, (unsigned char)text[special], replacement);
+        if (memcmp(expected, replacement, escaped) != 0) return false;
+        expected += escaped;
+        position = special + 1;
+    }
+
+    return true;
+}
+
+// Two-digit pairs "00" to "99", so integers take one division per two digits
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Writes the decimal digits of a number
+ * Returns: digit count (at most 20)
+ */
+static size_t format_decimal(uint64_t value, char *buffer) {
+    char digits[20];
+    size_t start = sizeof(digits);
+
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        digits[--start] = DIGIT_PAIRS[pair + 1];
+        digits[--start] = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        digits[--start] = DIGIT_PAIRS[value * 2 + 1];
+        digits[--start] = DIGIT_PAIRS[value * 2];
+    } else {
+        digits[--start] = (char)('0' + value);
+    }
+
+    memcpy(buffer, digits + start, sizeof(digits) - start);
+    return sizeof(digits) - start;
+}
+
+/* Formats a number the way it is written without a hint
+ * Integers skip printf, floats use "%g" and booleans "true" or "false".
+ * Returns: text length
+ */
+static size_t format_default(const simplet_value_t *value, char *buffer) {
+    switch (value->kind) {
+        case SIMPLET_VALUE_INT:
+            if (value->integer < 0) {
+                buffer[0] = '-';
+                return 1 + format_decimal(0 - (uint64_t)value->integer, buffer + 1);
+            }
+            return format_decimal((uint64_t)value->integer, buffer);
+        case SIMPLET_VALUE_UINT:
+            return format_decimal(value->unsigned_integer, buffer);
+        case SIMPLET_VALUE_BOOL:
+            memcpy(buffer, value->integer ? "true" : "false", value->integer ? 4 : 5);
+            return value->integer ? 4 : 5;
+        default: {
+            int length = snprintf(buffer, SIMPLET_NUMBER_SIZE, "%g", value->number);
+            return length > 0 ? (size_t)length : 0;
+        }
+    }
+}
+
+/* Formats a number by its placeholder's hint, or by default without one
+ * The hint was validated when it was parsed, so it is rebuilt with width and
+ * precision as arguments. Integer conversions of values they cannot hold
+ * (a negative or huge float, an unsigned number above INT64_MAX for d) and
+ * output that would not fit SIMPLET_NUMBER_SIZE fall back to the default.
+ * Returns: text length, always less than SIMPLET_NUMBER_SIZE
+ */
+size_t simplet_format_number(const simplet_value_t *value, uint32_t filter, char *buffer) {
+    if (!simplet_filter_is_format(filter)) return format_default(value, buffer);
+
+    char conversion = SIMPLET_FORMAT_CONVERSIONS[SIMPLET_FORMAT_CONVERSION(filter) - 1];
+    int width = (int)SIMPLET_FORMAT_WIDTH(filter);
+    int precision = (filter & SIMPLET_FORMAT_HAS_PRECISION) ? (int)SIMPLET_FORMAT_PRECISION(filter) : -1;
+
+    // A negative precision argument counts as no precision
+    char format[12];
+    size_t f = 0;
+    format[f++] = '%';
+    if (filter & SIMPLET_FORMAT_ZERO) format[f++] = '0';
+    if (filter & SIMPLET_FORMAT_PLUS) format[f++] = '+';
+    memcpy(format + f, "*.*", 3);
+    f += 3;
+    if (conversion == 'd' || conversion == 'u' || conversion == 'x' || conversion == 'X') {
+        memcpy(format + f, "ll", 2);
+        f += 2;
+    }
+    format[f++] = conversion;
+    format[f] = '\0';
+
+    int length = -1;
+    if (conversion == 'd') {
+        long long number;
+        if (value->kind == SIMPLET_VALUE_UINT && value->unsigned_integer > (uint64_t)INT64_MAX) {
+            return format_default(value, buffer);
+        } else if (value->kind == SIMPLET_VALUE_FLOAT) {
+            if (!(value->number >= -9223372036854775808.0 && value->number < 9223372036854775808.0)) {
+                return format_default(value, buffer);
+            }
+            number = (long long)value->number;
+        } else {
+            number = (long long)value->integer;
+        }
+        length = snprintf(buffer, SIMPLET_NUMBER_SIZE, format, width, precision, number);
+    } else if (conversion == 'u' || conversion == 'x' || conversion == 'X') {
+        unsigned long long number;
+        if (value->kind == SIMPLET_VALUE_FLOAT) {
+            if (!(value->number >= 0.0 && value->number < 18446744073709551616.0)) {
+                return format_default(value, buffer);
+            }
+            number = (unsigned long long)value->number;
+        } else {
+            number = (unsigned long long)value->unsigned_integer;
+        }
+        length = snprintf(buffer, SIMPLET_NUMBER_SIZE, format, width, precision, number);
+    } else {
+        double number = value->number;
+        if (value->kind == SIMPLET_VALUE_INT || value->kind == SIMPLET_VALUE_BOOL) number = (double)value->integer;
+        if (value->kind == SIMPLET_VALUE_UINT) number = (double)value->unsigned_integer;
+        length = snprintf(buffer, SIMPLET_NUMBER_SIZE, format, width, precision, number);
+    }
+
+    if (length < 0 || length >= SIMPLET_NUMBER_SIZE) return format_default(value, buffer);
+    return (size_t)length;
+}
@@ -0,0 +1,257 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_incremental.h"
+#include "simplet_internal.h"
+
+/* Creates an incremental render with one segment per placeholder
+ * Returns: incremental render or NULL on invalid input or allocation failure
+ */
+simplet_incremental_t* create_simplet_incremental(const simplet_template_t *compiled) {
+    if (!compiled || !simplet_template_is_flat(compiled)) return NULL;
+
+    // Segments follow the struct in the same allocation
+    simplet_incremental_t *incremental = simplet_calloc(1, sizeof(simplet_incremental_t) +
+                                                   compiled->placeholder_count * sizeof(simplet_segment_t));
+    if (!incremental) return NULL;
+
+    incremental->compiled = compiled;
+    incremental->segments = (simplet_segment_t *)(incremental + 1);
+
+    size_t placeholder = 0;
+    for (size_t i = 0; i < compiled->op_count; i++) {
+        if (compiled->ops[i].kind == SIMPLET_OP_PLACEHOLDER) {
+            incremental->segments[placeholder++].op = i;
+        }
+    }
+
+    return incremental;
+}
+
+/* Makes room for a page of the given length plus terminator
+ * Returns: true on success, false on allocation failure (output untouched)
+ */
+static bool reserve_page(simplet_incremental_t *incremental, size_t length) {
+    if (length + TERMINATOR <= incremental->capacity) return true;
+
+    size_t capacity = incremental->capacity * 2;
+    if (capacity < length + TERMINATOR) capacity = length + TERMINATOR;
+
+    char *grown = simplet_realloc(incremental->output, capacity);
+    if (!grown) return false;
+
+    incremental->output = grown;
+    incremental->capacity = capacity;
+    return true;
+}
+
+/* Finds the unescaped text a placeholder puts on the page
+ * Numbers are formatted and a provider's output is captured in the scratch
+ * buffer, which grows to fit the longest output so far.
+ * Returns: false on allocation failure, else true with text (NULL when missing) and length set
+ */
+static bool segment_text(simplet_incremental_t *incremental, const simplet_op_t *op,
+                         const simplet_dictionary_t *dictionary, const char **text, size_t *length) {
+    const simplet_value_t *value = simplet_lookup_value(dictionary, op->text, op->length, op->hash);
+    *text = NULL;
+    *length = 0;
+
+    if (!value) return true;
+
+    if (value->kind == SIMPLET_VALUE_TEXT) {
+        *text = value->text;
+        *length = value->length;
+        return true;
+    }
+
+    simplet_output_t output;
+    output_init_buffer(&output, incremental->scratch, incremental->scratch_capacity);
+    output.growing = true;
+
+    if (SIMPLET_VALUE_IS_NUMBER(value->kind)) {
+        char number[SIMPLET_NUMBER_SIZE];
+        output_write(&output, number, simplet_format_number(value, op->filter, number));
+    } else {
+        output_provided(&output, SIMPLET_FILTER_NONE, value->provider);
+    }
+
+    // Keep the buffer even when it grew and then failed, so it is freed with the render
+    incremental->scratch = output.buffer;
+    incremental->scratch_capacity = output.capacity;
+    if (output.failed) return false;
+
+    // A provider that writes nothing still resolves its placeholder
+    *text = output.buffer ? output.buffer : "";
+    *length = output.length;
+    return true;
+}
+
+/* Renders the whole page in one pass, growing the buffer as it goes
+ * The buffer is kept between renders, so it settles at the page size.
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_incremental_render(simplet_incremental_t *incremental,
+                                                      const simplet_dictionary_t *dictionary) {
+    if (!incremental) return ERROR_NULL_PARAM;
+
+    const simplet_template_t *compiled = incremental->compiled;
+    if (!reserve_page(incremental, compiled->literal_length)) return ERROR_NO_MEMORY;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    // A failure part way leaves no complete page
+    incremental->rendered = false;
+
+    size_t length = 0;
+    size_t placeholder = 0;
+
+    for (size_t i = 0; i < compiled->op_count; i++) {
+        const simplet_op_t *op = &compiled->ops[i];
+        const char *text = op->text;
+        size_t text_length = op->length;
+
+        if (op->kind == SIMPLET_OP_PLACEHOLDER) {
+            simplet_segment_t *segment = &incremental->segments[placeholder++];
+            bool found = segment_text(incremental, op, dictionary, &text, &text_length);
+            SIMPLET_STAT_ADD(text ? SIMPLET_STAT_PLACEHOLDERS_RESOLVED : SIMPLET_STAT_PLACEHOLDERS_MISSED, 1);
+
+            if (!found || !reserve_page(incremental, length + simplet_escaped_length(op->filter, text, text_length))) {
+                SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, 0);
+                return ERROR_NO_MEMORY;
+            }
+
+            // Segments hold the value as it appears on the page, escaped
+            segment->offset = length;
+            segment->length = simplet_escape(op->filter, text, text_length, incremental->output + length);
+            length += segment->length;
+            continue;
+        }
+
+        // Values may have taken the room reserved for literals
+        if (!reserve_page(incremental, length + text_length)) {
+            SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, 0);
+            return ERROR_NO_MEMORY;
+        }
+
+        memcpy(incremental->output + length, text, text_length);
+        length += text_length;
+    }
+
+    incremental->output[length] = '\0';
+    incremental->length = length;
+    incremental->dictionary = dictionary;
+    incremental->generation = simplet_dictionary_generation(dictionary);
+    incremental->rendered = true;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, length);
+
+    return SUCCESS;
+}
+
+/* Replaces one segment's value, moving the rest of the page if the length differs
+ * length is the escaped length of value under filter.
+ * Returns: true on success, false on allocation failure (page untouched)
+ */
+static bool rewrite_segment(simplet_incremental_t *incremental, simplet_segment_t *segment,
+                            uint32_t filter, const char *value, size_t value_length, size_t length) {
+    if (length != segment->length) {
+        size_t tail = segment->offset + segment->length;
+        size_t new_length = incremental->length - segment->length + length;
+        if (!reserve_page(incremental, new_length)) return false;
+
+        // Tail includes the terminator
+        memmove(incremental->output + segment->offset + length, incremental->output + tail,
+                incremental->length - tail + TERMINATOR);
+        incremental->length = new_length;
+    }
+
+    simplet_escape(filter, value, value_length, incremental->output + segment->offset);
+    segment->length = length;
+    return true;
+}
+
+/* Looks up every placeholder and rewrites the ones whose value differs from the page
+ * Segment offsets are shifted by the running size difference as the walk goes
+ * (unsigned arithmetic, so a shrinking page wraps and comes back in range).
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY or ERROR_BUFFER_TOO_SMALL
+ */
+simplet_dictionary_error_t simplet_incremental_update(simplet_incremental_t *incremental,
+                                                      const simplet_dictionary_t *dictionary,
+                                                      simplet_change_t *changes, size_t max_changes,
+                                                      size_t *change_count) {
+    if (!incremental || (!changes && max_changes > 0)) return ERROR_NULL_PARAM;
+
+    if (change_count) *change_count = 0;
+
+    if (!incremental->rendered) return simplet_incremental_render(incremental, dictionary);
+
+    uint32_t generation = simplet_dictionary_generation(dictionary);
+    if (dictionary == incremental->dictionary && generation == incremental->generation) return SUCCESS;
+
+    const simplet_template_t *compiled = incremental->compiled;
+    size_t changed = 0;
+    size_t shift = 0;   // Size change so far, wrapping when the page shrank
+
+    for (size_t i = 0; i < compiled->placeholder_count; i++) {
+        simplet_segment_t *segment = &incremental->segments[i];
+        const simplet_op_t *op = &compiled->ops[segment->op];
+
+        // Apply the size change of earlier segments
+        segment->offset += shift;
+
+        const char *value;
+        size_t value_length;
+        if (!segment_text(incremental, op, dictionary, &value, &value_length)) {
+            incremental->rendered = false;
+            return ERROR_NO_MEMORY;
+        }
+
+        size_t length = simplet_escaped_length(op->filter, value, value_length);
+        if (length == segment->length &&
+            simplet_escaped_equals(op->filter, value, value_length, incremental->output + segment->offset)) {
+            continue;
+        }
+
+        size_t old_length = segment->length;
+        if (!rewrite_segment(incremental, segment, op->filter, value, value_length, length)) {
+            // Page is consistent up to this segment; start over next time
+            incremental->rendered = false;
+            return ERROR_NO_MEMORY;
+        }
+
+        shift += length - old_length;
+
+        if (changed < max_changes) changes[changed].placeholder = i;
+        changed++;
+    }
+
+    // Fill in pointers only now that the page will not move again
+    for (size_t c = 0; c < changed && c < max_changes; c++) {
+        const simplet_segment_t *segment = &incremental->segments[changes[c].placeholder];
+        changes[c].key = compiled->ops[segment->op].text;
+        changes[c].value = incremental->output + segment->offset;
+        changes[c].length = segment->length;
+        changes[c].offset = segment->offset;
+    }
+
+    incremental->dictionary = dictionary;
+    incremental->generation = generation;
+
+    if (change_count) *change_count = changed;
+    return changed <= max_changes ? SUCCESS : ERROR_BUFFER_TOO_SMALL;
+}
+
+/* Returns: current page or NULL before the first render */
+const char* simplet_incremental_output(const simplet_incremental_t *incremental, size_t *length) {
+    if (!incremental || !incremental->rendered) return NULL;
+    if (length) *length = incremental->length;
+    return incremental->output;
+}
+
+/* Frees the page and the incremental render (single allocation plus the page and scratch) */
+void destroy_simplet_incremental(simplet_incremental_t *incremental) {
+    if (!incremental) return;
+    simplet_free(incremental->scratch);
+    simplet_free(incremental->output);
+    simplet_free(incremental);
+}
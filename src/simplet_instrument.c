@@ -0,0 +1,103 @@
+#include <string.h>
+#include "include/simplet_instrument.h"
+
+#if SIMPLET_INSTRUMENTATION
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+_Static_assert(sizeof(simplet_stats_t) == SIMPLET_STAT_COUNT * sizeof(size_t),
+               "simplet_stats_t must list every counter");
+
+static simplet_allocator_t allocator = { malloc, realloc, free };
+static simplet_render_observer_fn render_observer = NULL;
+static void *render_observer_context = NULL;
+
+// Relaxed atomics: counters may be bumped from several rendering tasks
+static atomic_size_t counters[SIMPLET_STAT_COUNT];
+
+/* Installs replacement heap functions, or restores the C library ones */
+void simplet_set_allocator(const simplet_allocator_t *replacement) {
+    if (replacement && replacement->malloc_fn && replacement->realloc_fn && replacement->free_fn) {
+        allocator = *replacement;
+    } else {
+        allocator.malloc_fn = malloc;
+        allocator.realloc_fn = realloc;
+        allocator.free_fn = free;
+    }
+}
+
+void simplet_set_render_observer(simplet_render_observer_fn observer, void *context) {
+    render_observer = observer;
+    render_observer_context = context;
+}
+
+void simplet_get_stats(simplet_stats_t *stats) {
+    if (!stats) return;
+
+    size_t *fields = (size_t *)stats;
+    for (int i = 0; i < SIMPLET_STAT_COUNT; i++) {
+        fields[i] = atomic_load_explicit(&counters[i], memory_order_relaxed);
+    }
+}
+
+void simplet_reset_stats(void) {
+    for (int i = 0; i < SIMPLET_STAT_COUNT; i++) {
+        atomic_store_explicit(&counters[i], 0, memory_order_relaxed);
+    }
+}
+
+void simplet_stat_add(simplet_stat_id_t id, size_t amount) {
+    atomic_fetch_add_explicit(&counters[id], amount, memory_order_relaxed);
+}
+
+/* Records one dictionary search and keeps the longest probe sequence */
+void simplet_stat_lookup(size_t probes) {
+    simplet_stat_add(SIMPLET_STAT_DICTIONARY_LOOKUPS, 1);
+    simplet_stat_add(SIMPLET_STAT_DICTIONARY_PROBES, probes);
+
+    size_t longest = atomic_load_explicit(&counters[SIMPLET_STAT_DICTIONARY_MAX_PROBE], memory_order_relaxed);
+    while (probes > longest &&
+           !atomic_compare_exchange_weak_explicit(&counters[SIMPLET_STAT_DICTIONARY_MAX_PROBE], &longest, probes,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/* Counts a finished render and forwards both phases to the observer */
+void simplet_render_notify(simplet_render_event_t event, size_t length) {
+    if (event == SIMPLET_RENDER_END) {
+        simplet_stat_add(SIMPLET_STAT_RENDERS, 1);
+        simplet_stat_add(SIMPLET_STAT_BYTES_EMITTED, length);
+    }
+
+    simplet_render_observer_fn observer = render_observer;
+    if (observer) observer(render_observer_context, event, length);
+}
+
+void* simplet_malloc(size_t size) {
+    simplet_stat_add(SIMPLET_STAT_ALLOCATIONS, 1);
+    simplet_stat_add(SIMPLET_STAT_BYTES_REQUESTED, size);
+    return allocator.malloc_fn(size);
+}
+
+void* simplet_calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+
+    void *memory = simplet_malloc(count * size);
+    if (memory) memset(memory, 0, count * size);
+    return memory;
+}
+
+void* simplet_realloc(void *memory, size_t size) {
+    simplet_stat_add(SIMPLET_STAT_REALLOCATIONS, 1);
+    simplet_stat_add(SIMPLET_STAT_BYTES_REQUESTED, size);
+    return allocator.realloc_fn(memory, size);
+}
+
+void simplet_free(void *memory) {
+    if (!memory) return;
+    simplet_stat_add(SIMPLET_STAT_FREES, 1);
+    allocator.free_fn(memory);
+}
+
+#endif // SIMPLET_INSTRUMENTATION
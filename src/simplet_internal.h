@@ -0,0 +1,475 @@
+#ifndef SIMPLET_INTERNAL_H
+#define SIMPLET_INTERNAL_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_dictionary.h"
+#include "include/simplet_template.h"
+#include "include/simplet_parallel.h"
+#include "simplet_scan.h"
+
+// Template delimiters
+#define DELIMITER_START "{{"
+#define DELIMITER_END "}}"
+#define DELIMITER_LENGTH 2
+
+// Maximum template size (including null terminator)
+#define MAX_TEMPLATE_SIZE 8192 + TERMINATOR
+
+// Helper macro for allocating empty strings
+#define EMPTY_STRING() ({ char *s = simplet_malloc(1); if (s) s[0] = '\0'; s; })
+
+// Compile-time assertions for assumptions
+_Static_assert(sizeof(char) == 1, "char must be 1 byte");
+_Static_assert(DELIMITER_LENGTH == 2, "Delimiter length mismatch");
+
+/* Helper function to skip whitespace characters
+ * Returns: position after whitespace
+ */
+static inline size_t skip_whitespace(const char *str, size_t pos, size_t max_len) {
+    while (pos < max_len && (str[pos] == ' ' || str[pos] == '\t')) {
+        pos++;
+    }
+    return pos;
+}
+
+/* Helper function to skip trailing whitespace backwards
+ * Returns: position of last non-whitespace character + 1
+ */
+static inline size_t skip_trailing_whitespace(const char *str, size_t start, size_t end) {
+    while (end > start && (str[end - 1] == ' ' || str[end - 1] == '\t')) {
+        end--;
+    }
+    return end;
+}
+
+// Location of a placeholder within template text
+typedef struct {
+    size_t start;       // Offset of the opening delimiter
+    size_t end;         // Offset just past the closing delimiter
+    size_t key_start;   // Offset of the first key character
+    size_t key_length;  // Key length with surrounding whitespace and any filter trimmed
+    uint32_t filter;    // simplet_filter_t named after "|", SIMPLET_FILTER_NONE without one
+} simplet_placeholder_t;
+
+// Filter names accepted after "|"
+static const struct {
+    const char *name;
+    size_t length;
+    simplet_filter_t filter;
+} SIMPLET_FILTER_NAMES[] = {
+    { "html", 4, SIMPLET_FILTER_HTML },
+    { "url", 3, SIMPLET_FILTER_URL },
+    { "json", 4, SIMPLET_FILTER_JSON },
+};
+
+/* Number format hints, "{{ key | %.1f }}"
+ * A hint is parsed once and kept in the placeholder's filter:
+ * SIMPLET_FORMAT_FLAG, the conversion (index into SIMPLET_FORMAT_CONVERSIONS
+ * plus one), the '0' and '+' flags, the width and the precision.
+ */
+#define SIMPLET_FORMAT_FLAG 0x8000u
+#define SIMPLET_FORMAT_CONVERSIONS "duxXfeg"
+#define SIMPLET_FORMAT_CONVERSION(filter) ((filter) & 0x7u)
+#define SIMPLET_FORMAT_ZERO 0x0008u
+#define SIMPLET_FORMAT_PLUS 0x0010u
+#define SIMPLET_FORMAT_WIDTH(filter) (((filter) >> 5) & 0x1Fu)
+#define SIMPLET_FORMAT_HAS_PRECISION 0x0400u
+#define SIMPLET_FORMAT_PRECISION(filter) (((filter) >> 11) & 0xFu)
+#define SIMPLET_FORMAT_MAX_WIDTH 31
+#define SIMPLET_FORMAT_MAX_PRECISION 15
+
+// Whether a filter is a number format hint rather than an escaping filter
+static inline bool simplet_filter_is_format(uint32_t filter) {
+    return (filter & SIMPLET_FORMAT_FLAG) != 0;
+}
+
+/* Parses a hint of the form %[0+][width][.precision]conversion
+ * Conversions are d, i, u, x, X, f, e and g (i is d); width and precision
+ * are limited to SIMPLET_FORMAT_MAX_WIDTH and SIMPLET_FORMAT_MAX_PRECISION,
+ * so every hint can be formatted without checking the pattern again.
+ * Returns: encoded hint, or SIMPLET_FILTER_NONE if spec is not a valid hint
+ */
+static inline uint32_t simplet_parse_format(const char *spec, size_t length) {
+    if (length < 2 || spec[0] != '%') return SIMPLET_FILTER_NONE;
+
+    uint32_t format = SIMPLET_FORMAT_FLAG;
+    size_t i = 1;
+
+    for (; i < length && (spec[i] == '0' || spec[i] == '+'); i++) {
+        format |= spec[i] == '0' ? SIMPLET_FORMAT_ZERO : SIMPLET_FORMAT_PLUS;
+    }
+
+    uint32_t width = 0;
+    for (; i < length && spec[i] >= '0' && spec[i] <= '9'; i++) {
+        width = width * 10 + (uint32_t)(spec[i] - '0');
+        if (width > SIMPLET_FORMAT_MAX_WIDTH) return SIMPLET_FILTER_NONE;
+    }
+    format |= width << 5;
+
+    if (i < length && spec[i] == '.') {
+        uint32_t precision = 0;
+        for (i++; i < length && spec[i] >= '0' && spec[i] <= '9'; i++) {
+            precision = precision * 10 + (uint32_t)(spec[i] - '0');
+            if (precision > SIMPLET_FORMAT_MAX_PRECISION) return SIMPLET_FILTER_NONE;
+        }
+        format |= SIMPLET_FORMAT_HAS_PRECISION | precision << 11;
+    }
+
+    if (i + 1 != length) return SIMPLET_FILTER_NONE;
+
+    char conversion = spec[i] == 'i' ? 'd' : spec[i];
+    const char *found = conversion ? strchr(SIMPLET_FORMAT_CONVERSIONS, conversion) : NULL;
+    if (!found) return SIMPLET_FILTER_NONE;
+
+    return format | (uint32_t)(found - SIMPLET_FORMAT_CONVERSIONS + 1);
+}
+
+/* Splits a trimmed placeholder body "key | name" into key and filter
+ * Only a known name or a valid format hint after the first "|" and a
+ * non-empty key make a filter; anything else stays a plain key, as before
+ * filters existed.
+ * Returns: key length, with filter set (SIMPLET_FILTER_NONE if there is none)
+ */
+static inline size_t simplet_split_filter(const char *key, size_t length, uint32_t *filter) {
+    *filter = SIMPLET_FILTER_NONE;
+
+    const char *bar = memchr(key, '|', length);
+    if (!bar) return length;
+
+    size_t key_end = skip_trailing_whitespace(key, 0, (size_t)(bar - key));
+    size_t name_start = skip_whitespace(key, (size_t)(bar - key) + 1, length);
+    if (key_end == 0) return length;
+
+    uint32_t format = simplet_parse_format(key + name_start, length - name_start);
+    if (format != SIMPLET_FILTER_NONE) {
+        *filter = format;
+        return key_end;
+    }
+
+    for (size_t i = 0; i < sizeof(SIMPLET_FILTER_NAMES) / sizeof(SIMPLET_FILTER_NAMES[0]); i++) {
+        if (length - name_start == SIMPLET_FILTER_NAMES[i].length &&
+            memcmp(key + name_start, SIMPLET_FILTER_NAMES[i].name, SIMPLET_FILTER_NAMES[i].length) == 0) {
+            *filter = SIMPLET_FILTER_NAMES[i].filter;
+            return key_end;
+        }
+    }
+
+    return length;
+}
+
+/* Finds the next placeholder at or after position
+ * Follows the same rules as simplet_render_html: an opening delimiter
+ * without a closing one, or with an empty key, is plain text.
+ * Returns: true and fills placeholder if one was found, false otherwise
+ */
+static inline bool simplet_find_placeholder(const char *text, size_t length, size_t position,
+                                            simplet_placeholder_t *placeholder) {
+    while ((position = simplet_scan_pair(text, position, length, DELIMITER_START[0])) < length) {
+        size_t key_start = skip_whitespace(text, position + DELIMITER_LENGTH, length);
+
+        // No closing delimiter after this point means none after any later opening either
+        size_t key_close = simplet_scan_pair(text, key_start, length, DELIMITER_END[0]);
+        if (key_close == length) return false;
+
+        size_t key_end = skip_trailing_whitespace(text, key_start, key_close);
+        if (key_end > key_start) {
+            placeholder->start = position;
+            placeholder->end = key_close + DELIMITER_LENGTH;
+            placeholder->key_start = key_start;
+            placeholder->key_length = simplet_split_filter(text + key_start, key_end - key_start, &placeholder->filter);
+            return true;
+        }
+
+        position++;
+    }
+
+    return false;
+}
+
+/* Filters a stored value down to what a placeholder writes
+ * Returns: string or provider, or NULL for a missing value, an empty string or a list
+ */
+static inline const simplet_value_t* simplet_written_value(const simplet_value_t *value) {
+    if (!value || value->kind == SIMPLET_VALUE_LIST) return NULL;
+    if (value->kind == SIMPLET_VALUE_TEXT && value->length == 0) return NULL;
+    return value;
+}
+
+/* Looks up the value substituted for a placeholder
+ * Strings carry their length, so they are never rescanned.
+ * Returns: as simplet_written_value
+ */
+static inline const simplet_value_t* simplet_lookup_value(const simplet_dictionary_t *dictionary, const char *key,
+                                                          size_t key_length, uint32_t hash) {
+    return simplet_written_value(simplet_dictionary_find_value(dictionary, key, key_length, hash));
+}
+
+// Closing tag of a block, {{/key}} (never stored as an operation)
+#define SIMPLET_BLOCK_END 0xFFFF
+
+/* Classifies a placeholder key as a block or partial tag by its leading sigil
+ * {{#key}}, {{?key}}, {{^key}} open a block, {{/key}} closes it and {{>name}}
+ * includes a partial; the name may follow the sigil after whitespace but
+ * must not be empty.
+ * Returns: SIMPLET_OP_SECTION, SIMPLET_OP_IF, SIMPLET_OP_UNLESS, SIMPLET_OP_PARTIAL
+ *          or SIMPLET_BLOCK_END with name_start set, SIMPLET_OP_PLACEHOLDER otherwise
+ */
+static inline uint32_t simplet_block_kind(const char *key, size_t length, size_t *name_start) {
+    uint32_t kind;
+    switch (key[0]) {
+        case '#': kind = SIMPLET_OP_SECTION; break;
+        case '?': kind = SIMPLET_OP_IF; break;
+        case '^': kind = SIMPLET_OP_UNLESS; break;
+        case '/': kind = SIMPLET_BLOCK_END; break;
+        case '>': kind = SIMPLET_OP_PARTIAL; break;
+        default: return SIMPLET_OP_PLACEHOLDER;
+    }
+
+    // A sigil alone is an ordinary key
+    size_t start = skip_whitespace(key, 1, length);
+    if (start == length) return SIMPLET_OP_PLACEHOLDER;
+
+    *name_start = start;
+    return kind;
+}
+
+// Dictionaries a placeholder is resolved against: a list item first, then the enclosing scopes
+typedef struct simplet_scope {
+    const simplet_dictionary_t *dictionary;
+    const struct simplet_scope *parent;
+} simplet_scope_t;
+
+/* Finds a key in the innermost scope that has it
+ * Returns: stored value, or NULL if no scope has the key
+ */
+static inline const simplet_value_t* simplet_scope_find(const simplet_scope_t *scope, const char *key, size_t key_length,
+                                                        uint32_t hash) {
+    for (; scope; scope = scope->parent) {
+        const simplet_value_t *value = simplet_dictionary_find_value(scope->dictionary, key, key_length, hash);
+        if (value) return value;
+    }
+    return NULL;
+}
+
+/* Looks up the value substituted for a placeholder through the scopes
+ * Returns: as simplet_written_value
+ */
+static inline const simplet_value_t* simplet_scope_lookup(const simplet_scope_t *scope, const char *key,
+                                                          size_t key_length, uint32_t hash) {
+    return simplet_written_value(simplet_scope_find(scope, key, key_length, hash));
+}
+
+// Destination for rendered output: a bounded buffer or a buffered sink
+typedef struct {
+    simplet_sink_fn write_fn;   // Sink, or NULL to write into buffer
+    void *context;              // Passed to write_fn
+    char *buffer;               // Buffer target (NULL with capacity 0 only measures)
+    size_t capacity;            // Usable bytes in buffer
+    size_t length;              // Total bytes produced, may exceed capacity
+    size_t used;                // Bytes pending in scratch (sink mode)
+    bool failed;                // Sink reported an error, or a growing buffer could not grow
+    bool growing;               // Buffer mode reallocates buffer instead of truncating
+    char scratch[SIMPLET_SINK_SCRATCH_SIZE];
+} simplet_output_t;
+
+static inline void output_init_buffer(simplet_output_t *output, char *buffer, size_t capacity) {
+    output->write_fn = NULL;
+    output->context = NULL;
+    output->buffer = buffer;
+    output->capacity = buffer ? capacity : 0;
+    output->length = 0;
+    output->used = 0;
+    output->failed = false;
+    output->growing = false;
+}
+
+static inline void output_init_sink(simplet_output_t *output, simplet_sink_fn write_fn, void *context) {
+    output_init_buffer(output, NULL, 0);
+    output->write_fn = write_fn;
+    output->context = context;
+}
+
+/* Reallocates a growing output's buffer so that length more bytes fit (simplet_template.c)
+ * Returns: false after marking the output failed on allocation failure
+ */
+bool output_grow(simplet_output_t *output, size_t length);
+
+/* Hands buffered bytes to the sink (no-op in buffer mode)
+ * Returns: false once the sink has reported a failure
+ */
+static inline bool output_flush(simplet_output_t *output) {
+    if (!output->failed && output->used > 0) {
+        output->failed = output->write_fn(output->context, output->scratch, output->used) != 0;
+        output->used = 0;
+    }
+    return !output->failed;
+}
+
+/* Appends data to the output
+ * Buffer mode copies what fits and keeps counting, like snprintf, unless the
+ * buffer is growing. Sink mode coalesces small pieces in scratch; chunks
+ * larger than scratch bypass it.
+ */
+static inline void output_write(simplet_output_t *output, const char *data, size_t length) {
+    if (output->failed || length == 0) return;
+
+    if (!output->write_fn) {
+        if (output->growing && length > output->capacity - output->length && !output_grow(output, length)) return;
+        if (output->length < output->capacity) {
+            size_t room = output->capacity - output->length;
+            memcpy(output->buffer + output->length, data, length < room ? length : room);
+        }
+        output->length += length;
+        return;
+    }
+
+    output->length += length;
+
+    if (length <= SIMPLET_SINK_SCRATCH_SIZE - output->used) {
+        memcpy(output->scratch + output->used, data, length);
+        output->used += length;
+        return;
+    }
+
+    if (!output_flush(output)) return;
+
+    if (length >= SIMPLET_SINK_SCRATCH_SIZE) {
+        output->failed = output->write_fn(output->context, data, length) != 0;
+    } else {
+        memcpy(output->scratch, data, length);
+        output->used = length;
+    }
+}
+
+/* Compiled-template rendering shared with simplet_render_html (simplet_template.c)
+ * simplet_compile_tail compiles text from position on, borrowing its literals.
+ */
+simplet_template_t* simplet_compile_tail(const char *html_template, size_t html_length, size_t position);
+void simplet_render_ops(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                        simplet_output_t *output);
+void simplet_render_range(const simplet_template_t *compiled, size_t begin, size_t end,
+                          const simplet_dictionary_t *dictionary, simplet_output_t *output);
+
+/* Whole-page renders that report failure (simplet.c, simplet_template.c)
+ * The public simplet_render_html and simplet_template_render hand out an empty
+ * string when these return NULL; the render cache must not store that page.
+ */
+char* simplet_render_html_checked(const char *html_template, size_t html_length, const simplet_dictionary_t *dictionary);
+char* simplet_template_render_checked(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary);
+
+/* Parallel rendering (simplet_parallel.c)
+ * simplet_parallel_applies tells whether a template of length bytes should
+ * be split; simplet_render_parallel returns NULL when it cannot be, and the
+ * caller renders on its own thread instead.
+ */
+void simplet_run_tasks(simplet_task_fn task, void *argument, size_t count);
+bool simplet_parallel_applies(size_t length);
+char* simplet_render_parallel(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                              size_t *length);
+
+/* Whether every operation is a literal or a placeholder (no blocks or partials)
+ * Only such templates have a fixed literal length and one lookup per placeholder.
+ */
+static inline bool simplet_template_is_flat(const simplet_template_t *compiled) {
+    return compiled->block_count == 0 && compiled->partial_count == 0;
+}
+
+/* Escaping counterparts of output_write and memcmp (simplet_filter.c) */
+void simplet_output_escaped(simplet_output_t *output, uint32_t filter, const char *text, size_t length);
+bool simplet_escaped_equals(uint32_t filter, const char *text, size_t length, const char *expected);
+
+// Output and filter behind the writer a provider receives
+struct simplet_value_writer {
+    simplet_output_t *output;
+    uint32_t filter;
+};
+
+/* Runs a provider, which writes its value through the filter */
+static inline void output_provided(simplet_output_t *output, uint32_t filter, const simplet_provider_t *provider) {
+    simplet_value_writer_t writer = { output, filter };
+    provider->fn(provider->context, &writer);
+}
+
+/* Runs a provider into a measuring output
+ * Returns: bytes it wrote after filtering
+ */
+static inline size_t simplet_provided_length(const simplet_provider_t *provider, uint32_t filter) {
+    simplet_output_t output;
+    output_init_buffer(&output, NULL, 0);
+    output_provided(&output, filter, provider);
+    return output.length;
+}
+
+// Room for any formatted number, with or without a hint
+#define SIMPLET_NUMBER_SIZE 64
+_Static_assert(SIMPLET_NUMBER_SIZE <= MAX_VALUE_SIZE, "numbers are formatted into value-sized buffers");
+
+/* Formats a number value by the placeholder's hint, or by its kind without one (simplet_filter.c)
+ * Returns: text length, always less than SIMPLET_NUMBER_SIZE
+ */
+size_t simplet_format_number(const simplet_value_t *value, uint32_t filter, char *buffer);
+
+/* Whether a value is set for {{?key}} and {{^key}}
+ * False booleans and empty strings are unset. Providers are always set:
+ * they run only where their placeholder is rendered, never to test a block.
+ */
+static inline bool simplet_value_is_set(const simplet_value_t *value) {
+    if (!value) return false;
+
+    switch (value->kind) {
+        case SIMPLET_VALUE_BOOL: return value->integer != 0;
+        case SIMPLET_VALUE_PROVIDER:
+        case SIMPLET_VALUE_INT:
+        case SIMPLET_VALUE_UINT:
+        case SIMPLET_VALUE_FLOAT: return true;
+        default: return value->length > 0;
+    }
+}
+
+/* Appends text through a filter; format hints leave text as it is */
+static inline void output_text(simplet_output_t *output, uint32_t filter, const char *text, size_t length) {
+    if (filter == SIMPLET_FILTER_NONE || simplet_filter_is_format(filter)) {
+        output_write(output, text, length);
+    } else {
+        simplet_output_escaped(output, filter, text, length);
+    }
+}
+
+/* Appends a placeholder's value through its filter, or nothing when it is missing (value NULL)
+ * Counts the placeholder unless the output only measures.
+ */
+static inline void output_value(simplet_output_t *output, uint32_t filter, const simplet_value_t *value) {
+#if SIMPLET_INSTRUMENTATION
+    if (output->buffer || output->write_fn || output->growing) {
+        SIMPLET_STAT_ADD(value ? SIMPLET_STAT_PLACEHOLDERS_RESOLVED : SIMPLET_STAT_PLACEHOLDERS_MISSED, 1);
+    }
+#endif
+    if (!value) return;
+
+    if (value->kind == SIMPLET_VALUE_PROVIDER) {
+        output_provided(output, filter, value->provider);
+    } else if (SIMPLET_VALUE_IS_NUMBER(value->kind)) {
+        char number[SIMPLET_NUMBER_SIZE];
+        output_text(output, filter, number, simplet_format_number(value, filter, number));
+    } else {
+        output_text(output, filter, value->text, value->length);
+    }
+}
+
+/* Points an output at a heap buffer that grows as it is written, starting at capacity bytes
+ * The render then takes a single pass; simplet_growing_finish hands the buffer over.
+ */
+static inline void output_init_growing(simplet_output_t *output, size_t capacity) {
+    output_init_buffer(output, NULL, 0);
+    output->growing = true;
+    if (capacity > 0) output_grow(output, capacity);
+}
+
+/* Terminates a growing output and shrinks its buffer to fit (simplet_template.c)
+ * Returns: the NUL-terminated buffer, NULL if the output failed
+ */
+char* simplet_growing_finish(simplet_output_t *output);
+
+#endif // SIMPLET_INTERNAL_H
@@ -0,0 +1,341 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "include/simplet_parallel.h"
+#include "simplet_internal.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#else
+#include <pthread.h>
+#endif
+
+// Guessed output bytes of a placeholder or partial when splitting a template
+#define PARALLEL_VALUE_WEIGHT 16
+
+// Threads kept between runs; the thread calling run claims tasks too
+typedef struct {
+    simplet_task_fn task;           // Task of the current run
+    void *argument;                 // Its argument
+    size_t count;                   // Its number of tasks
+    atomic_size_t next;             // Next task index to claim
+    size_t thread_count;            // Threads started
+    bool stopping;                  // Threads exit at their next wake-up
+#ifdef ESP_PLATFORM
+    SemaphoreHandle_t start;        // Given once per thread and run
+    SemaphoreHandle_t done;         // Given by every thread after its share of a run
+    SemaphoreHandle_t running;      // Held by the caller of the current run
+#else
+    pthread_mutex_t lock;           // Guards run, busy and stopping
+    pthread_cond_t start;           // Signalled for a new run or to stop
+    pthread_cond_t done;            // Signalled when the last thread leaves a run
+    pthread_mutex_t running;        // Held by the caller of the current run
+    unsigned long run;              // Incremented for every run
+    size_t busy;                    // Threads still in the current run
+    pthread_t threads[SIMPLET_MAX_WORKERS];
+#endif
+} thread_pool_t;
+
+/* Claims and runs tasks of the current run until none are left */
+static void pool_work(thread_pool_t *pool) {
+    for (size_t index; (index = atomic_fetch_add(&pool->next, 1)) < pool->count;) {
+        pool->task(pool->argument, index);
+    }
+}
+
+/* Runs every task on the calling thread */
+static void run_inline(simplet_task_fn task, void *argument, size_t count) {
+    for (size_t index = 0; index < count; index++) task(argument, index);
+}
+
+#ifdef ESP_PLATFORM
+
+static thread_pool_t pool;
+
+static void pool_main(void *argument) {
+    thread_pool_t *pool = argument;
+
+    for (;;) {
+        xSemaphoreTake(pool->start, portMAX_DELAY);
+        if (pool->stopping) break;
+        pool_work(pool);
+        xSemaphoreGive(pool->done);
+    }
+
+    xSemaphoreGive(pool->done);
+    vTaskDelete(NULL);
+}
+
+/* Starts the given number of FreeRTOS tasks at the caller's priority; tasks that cannot be created are left out */
+static void pool_start(thread_pool_t *pool, size_t threads) {
+    // Created once and kept, like the pool itself
+    if (!pool->start) pool->start = xSemaphoreCreateCounting(SIMPLET_MAX_WORKERS, 0);
+    if (!pool->done) pool->done = xSemaphoreCreateCounting(SIMPLET_MAX_WORKERS, 0);
+    if (!pool->running) pool->running = xSemaphoreCreateMutex();
+    if (!pool->start || !pool->done || !pool->running) return;
+
+    for (size_t i = 0; i < threads; i++) {
+        if (xTaskCreate(pool_main, "simplet", SIMPLET_TASK_STACK_SIZE, pool, uxTaskPriorityGet(NULL), NULL) == pdPASS) {
+            pool->thread_count++;
+        }
+    }
+}
+
+/* Wakes every task to exit and waits until they have */
+static void pool_stop(thread_pool_t *pool) {
+    pool->stopping = true;
+    for (size_t i = 0; i < pool->thread_count; i++) xSemaphoreGive(pool->start);
+    for (size_t i = 0; i < pool->thread_count; i++) xSemaphoreTake(pool->done, portMAX_DELAY);
+    pool->thread_count = 0;
+    pool->stopping = false;
+}
+
+/* Hands the tasks to the pool and works on them on the calling task too
+ * Without pool tasks, or while another run holds them, the calling task
+ * runs every task itself.
+ */
+static void pool_run(void *context, simplet_task_fn task, void *argument, size_t count) {
+    thread_pool_t *pool = context;
+    if (pool->thread_count == 0 || count < 2 || xSemaphoreTake(pool->running, 0) != pdTRUE) {
+        run_inline(task, argument, count);
+        return;
+    }
+
+    pool->task = task;
+    pool->argument = argument;
+    pool->count = count;
+    atomic_store(&pool->next, 0);
+    for (size_t i = 0; i < pool->thread_count; i++) xSemaphoreGive(pool->start);
+
+    pool_work(pool);
+
+    for (size_t i = 0; i < pool->thread_count; i++) xSemaphoreTake(pool->done, portMAX_DELAY);
+    xSemaphoreGive(pool->running);
+}
+
+#else
+
+static thread_pool_t pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .running = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static void* pool_main(void *argument) {
+    thread_pool_t *pool = argument;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->run == seen) pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->stopping) break;
+        seen = pool->run;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_work(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Starts the given number of threads; threads that cannot be created are left out */
+static void pool_start(thread_pool_t *pool, size_t threads) {
+    // New threads have seen no run yet
+    pool->run = 0;
+    for (size_t i = 0; i < threads; i++) {
+        if (pthread_create(&pool->threads[pool->thread_count], NULL, pool_main, pool) == 0) pool->thread_count++;
+    }
+}
+
+/* Wakes every thread to exit and joins them */
+static void pool_stop(thread_pool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->thread_count; i++) pthread_join(pool->threads[i], NULL);
+    pool->thread_count = 0;
+    pool->stopping = false;
+}
+
+/* Hands the tasks to the pool and works on them on the calling thread too
+ * Without pool threads, or while another run holds them, the calling
+ * thread runs every task itself.
+ */
+static void pool_run(void *context, simplet_task_fn task, void *argument, size_t count) {
+    thread_pool_t *pool = context;
+    if (pool->thread_count == 0 || count < 2 || pthread_mutex_trylock(&pool->running) != 0) {
+        run_inline(task, argument, count);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->argument = argument;
+    pool->count = count;
+    atomic_store(&pool->next, 0);
+    pool->busy = pool->thread_count;
+    pool->run++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_work(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->running);
+}
+
+#endif // ESP_PLATFORM
+
+static const simplet_executor_t thread_executor = { pool_run, &pool };
+
+static simplet_executor_t executor = { pool_run, &pool };
+static size_t parallel_workers = 1;
+static size_t parallel_threshold = SIMPLET_PARALLEL_THRESHOLD;
+
+const simplet_executor_t* simplet_thread_executor(void) {
+    return &thread_executor;
+}
+
+void simplet_set_executor(const simplet_executor_t *replacement) {
+    executor = replacement && replacement->run ? *replacement : thread_executor;
+}
+
+/* Sets the split and resizes the pool to one thread less than the workers, the caller being one */
+void simplet_set_parallel_render(size_t workers, size_t threshold) {
+    parallel_workers = workers < SIMPLET_MAX_WORKERS ? workers : SIMPLET_MAX_WORKERS;
+    parallel_threshold = threshold ? threshold : SIMPLET_PARALLEL_THRESHOLD;
+
+    size_t threads = parallel_workers > 1 ? parallel_workers - 1 : 0;
+    if (threads != pool.thread_count) {
+        pool_stop(&pool);
+        pool_start(&pool, threads);
+    }
+}
+
+/* Runs tasks on the current executor; a single task runs on the calling thread */
+void simplet_run_tasks(simplet_task_fn task, void *argument, size_t count) {
+    if (count == 1) {
+        task(argument, 0);
+    } else if (count > 1) {
+        executor.run(executor.context, task, argument, count);
+    }
+}
+
+bool simplet_parallel_applies(size_t length) {
+    return parallel_workers > 1 && length >= parallel_threshold;
+}
+
+// A run of top-level operations and the output it is rendered into
+typedef struct {
+    size_t begin;               // First operation
+    size_t end;                 // One past the last operation
+    size_t weight;              // Guessed output length
+    simplet_output_t output;    // Growing output of the segment
+} parallel_segment_t;
+
+typedef struct {
+    const simplet_template_t *compiled;
+    const simplet_dictionary_t *dictionary;
+    parallel_segment_t segments[SIMPLET_MAX_WORKERS];
+} parallel_render_t;
+
+/* Renders a segment into its own growing output */
+static void parallel_task(void *argument, size_t index) {
+    parallel_render_t *render = argument;
+    parallel_segment_t *segment = &render->segments[index];
+
+    output_init_growing(&segment->output, segment->weight);
+    simplet_render_range(render->compiled, segment->begin, segment->end, render->dictionary, &segment->output);
+}
+
+/* Splits the top-level operations into up to workers segments of similar weight
+ * A segment closes after the operation that brings it to its share of the
+ * total; blocks are never split.
+ * Returns: number of segments
+ */
+static size_t split_segments(const simplet_template_t *compiled, parallel_segment_t *segments, size_t workers) {
+    size_t total = compiled->literal_length +
+                   (compiled->placeholder_count + compiled->partial_count) * PARALLEL_VALUE_WEIGHT;
+    size_t count = 0;
+    size_t begin = 0;
+    size_t weight = 0;
+    size_t closed = 0;          // Weight of the segments before begin
+
+    for (size_t i = 0; i < compiled->op_count;) {
+        const simplet_op_t *op = &compiled->ops[i];
+        size_t next = op->kind >= SIMPLET_OP_SECTION && op->kind <= SIMPLET_OP_UNLESS ? op->end : i + 1;
+
+        for (; i < next; i++) {
+            op = &compiled->ops[i];
+            if (op->kind == SIMPLET_OP_LITERAL) {
+                weight += op->length;
+            } else if (op->kind == SIMPLET_OP_PLACEHOLDER || op->kind == SIMPLET_OP_PARTIAL) {
+                weight += PARALLEL_VALUE_WEIGHT;
+            }
+        }
+
+        if (count + 1 < workers && weight * workers >= total * (count + 1)) {
+            segments[count++] = (parallel_segment_t){ .begin = begin, .end = i, .weight = weight - closed };
+            begin = i;
+            closed = weight;
+        }
+    }
+
+    if (begin < compiled->op_count) {
+        segments[count++] = (parallel_segment_t){ .begin = begin, .end = compiled->op_count, .weight = weight - closed };
+    }
+    return count;
+}
+
+/* Renders the segments in one run of the executor, each into its own
+ * growing buffer, then appends them to the first
+ * Every placeholder is rendered once, so providers run once.
+ * Returns: newly allocated string, or NULL if the template does not split
+ * or on allocation failure (render serially then)
+ */
+char* simplet_render_parallel(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                              size_t *length) {
+    // Segment outputs carry sink scratch space, too much for a small task stack
+    parallel_render_t *render = simplet_malloc(sizeof(parallel_render_t));
+    if (!render) return NULL;
+
+    render->compiled = compiled;
+    render->dictionary = dictionary;
+    size_t count = split_segments(compiled, render->segments, parallel_workers);
+    if (count < 2) {
+        simplet_free(render);
+        return NULL;
+    }
+
+    simplet_run_tasks(parallel_task, render, count);
+
+    simplet_output_t *page = &render->segments[0].output;
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (render->segments[i].output.failed) page->failed = true;
+        total += render->segments[i].output.length;
+    }
+
+    if (!page->failed && total > page->capacity) output_grow(page, total - page->length);
+    for (size_t i = 1; i < count; i++) {
+        output_write(page, render->segments[i].output.buffer, render->segments[i].output.length);
+        simplet_free(render->segments[i].output.buffer);
+    }
+
+    char *rendered = simplet_growing_finish(page);
+    if (rendered) *length = total;
+
+    simplet_free(render);
+    return rendered;
+}
@@ -0,0 +1,176 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_partials.h"
+#include "simplet_internal.h"
+
+/* Creates an empty registry
+ * Returns: registry or NULL on allocation failure
+ */
+simplet_partials_t* create_simplet_partials(void) {
+    return simplet_calloc(1, sizeof(simplet_partials_t));
+}
+
+/* Finds a registered template by name bytes
+ * Returns: entry or NULL if the name is not registered
+ */
+static simplet_partial_t* partials_find(const simplet_partials_t *partials, const char *name, size_t name_length,
+                                        uint32_t hash) {
+    for (simplet_partial_t *entry = partials->head; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->name_length == name_length && memcmp(entry->name, name, name_length) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Points every partial operation of a template at its registered template
+ * Returns: SUCCESS or ERROR_KEY_NOT_FOUND if some names are not registered
+ */
+static simplet_dictionary_error_t partials_link(const simplet_partials_t *partials, simplet_template_t *compiled) {
+    simplet_dictionary_error_t result = SUCCESS;
+
+    for (size_t i = 0; i < compiled->op_count && compiled->partial_count > 0; i++) {
+        simplet_op_t *op = &compiled->ops[i];
+        if (op->kind != SIMPLET_OP_PARTIAL) continue;
+
+        const simplet_partial_t *entry = partials_find(partials, op->text, op->length, op->hash);
+        op->partial = entry ? entry->compiled : NULL;
+        if (!entry) result = ERROR_KEY_NOT_FOUND;
+    }
+
+    return result;
+}
+
+/* Registers a template under a name, replacing any template of that name
+ * Takes ownership of owned (destroyed on failure). A replaced template the
+ * registry owns moves to the retired list, as templates linked outside the
+ * registry may still point at it. Every registered template is linked
+ * again, as the new name may resolve tags that were unresolved.
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG or ERROR_NO_MEMORY
+ */
+static simplet_dictionary_error_t partials_add(simplet_partials_t *partials, const char *name,
+                                               simplet_template_t *compiled, simplet_template_t *owned) {
+    size_t name_length = safe_strlen(name, MAX_KEY_SIZE);
+    if (name_length == SIZE_MAX || name_length >= MAX_KEY_SIZE) {
+        destroy_simplet_template(owned);
+        return ERROR_KEY_TOO_LONG;
+    }
+
+    uint32_t hash = hash_key_n(name, name_length);
+    simplet_partial_t *entry = partials_find(partials, name, name_length, hash);
+
+    if (entry && entry->owned) {
+        simplet_partial_t *retired = simplet_calloc(1, sizeof(simplet_partial_t));
+        if (!retired) {
+            destroy_simplet_template(owned);
+            return ERROR_NO_MEMORY;
+        }
+
+        retired->owned = entry->owned;
+        retired->next = partials->retired;
+        partials->retired = retired;
+    } else if (!entry) {
+        // Entry and name share one allocation
+        entry = simplet_malloc(sizeof(simplet_partial_t) + name_length + TERMINATOR);
+        if (!entry) {
+            destroy_simplet_template(owned);
+            return ERROR_NO_MEMORY;
+        }
+
+        char *copy = (char *)(entry + 1);
+        memcpy(copy, name, name_length);
+        copy[name_length] = '\0';
+        entry->name = copy;
+        entry->name_length = name_length;
+        entry->hash = hash;
+        entry->next = partials->head;
+        partials->head = entry;
+        partials->count++;
+    }
+
+    entry->compiled = compiled;
+    entry->owned = owned;
+
+    for (simplet_partial_t *linked = partials->head; linked; linked = linked->next) {
+        partials_link(partials, linked->compiled);
+    }
+
+    return SUCCESS;
+}
+
+/* Compiles a copy of a template string and registers it
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG, ERROR_INVALID_SIZE or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add(simplet_partials_t *partials, const char *name,
+                                                const char *html_template) {
+    if (!partials || !name || !html_template) return ERROR_NULL_PARAM;
+    if (safe_strlen(html_template, MAX_TEMPLATE_SIZE) == SIZE_MAX) return ERROR_INVALID_SIZE;
+
+    simplet_template_t *compiled = compile_simplet_template(html_template);
+    if (!compiled) return ERROR_NO_MEMORY;
+
+    return partials_add(partials, name, compiled, compiled);
+}
+
+/* Compiles a read-only template in place and registers it
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add_borrowed(simplet_partials_t *partials, const char *name,
+                                                         const char *html_template, size_t length) {
+    if (!partials || !name || (!html_template && length > 0)) return ERROR_NULL_PARAM;
+
+    simplet_template_t *compiled = compile_simplet_template_borrowed(html_template, length);
+    if (!compiled) return ERROR_NO_MEMORY;
+
+    return partials_add(partials, name, compiled, compiled);
+}
+
+/* Registers a template the caller keeps ownership of
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_KEY_TOO_LONG or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_partials_add_compiled(simplet_partials_t *partials, const char *name,
+                                                         simplet_template_t *compiled) {
+    if (!partials || !name || !compiled) return ERROR_NULL_PARAM;
+    return partials_add(partials, name, compiled, NULL);
+}
+
+/* Finds a registered template by name
+ * Returns: compiled template or NULL if not registered
+ */
+const simplet_template_t* simplet_partials_get(const simplet_partials_t *partials, const char *name) {
+    if (!partials || !name) return NULL;
+
+    size_t name_length = safe_strlen(name, MAX_KEY_SIZE);
+    if (name_length == SIZE_MAX) return NULL;
+
+    const simplet_partial_t *entry = partials_find(partials, name, name_length, hash_key_n(name, name_length));
+    return entry ? entry->compiled : NULL;
+}
+
+/* Resolves the partial tags of a template against a registry
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_KEY_NOT_FOUND
+ */
+simplet_dictionary_error_t simplet_partials_link(const simplet_partials_t *partials, simplet_template_t *compiled) {
+    if (!partials || !compiled) return ERROR_NULL_PARAM;
+    return partials_link(partials, compiled);
+}
+
+/* Frees a list of entries and the templates they own */
+static void partials_free(simplet_partial_t *entry) {
+    while (entry) {
+        simplet_partial_t *next = entry->next;
+        destroy_simplet_template(entry->owned);
+        simplet_free(entry);
+        entry = next;
+    }
+}
+
+/* Frees the registry, its entries and the templates it compiled, including replaced ones */
+void destroy_simplet_partials(simplet_partials_t *partials) {
+    if (!partials) return;
+
+    partials_free(partials->head);
+    partials_free(partials->retired);
+    simplet_free(partials);
+}
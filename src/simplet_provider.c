@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_provider.h"
+#include "simplet_internal.h"
+
+/* Writes provider output through the placeholder's filter */
+void simplet_value_write(simplet_value_writer_t *writer, const char *data, size_t length) {
+    if (!writer || !data || length == 0) return;
+
+    output_text(writer->output, writer->filter, data, length);
+}
+
+/* Writes a NUL-terminated string through the placeholder's filter */
+void simplet_value_puts(simplet_value_writer_t *writer, const char *text) {
+    if (text) simplet_value_write(writer, text, strlen(text));
+}
+
+/* Formats on the stack, or on the heap when the output does not fit
+ * Returns: bytes written, or -1 on a format or allocation error
+ */
+int simplet_value_printf(simplet_value_writer_t *writer, const char *format, ...) {
+    if (!writer || !format) return -1;
+
+    char small[SIMPLET_VALUE_FORMAT_SIZE];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+
+    if (length < 0) return -1;
+    if ((size_t)length < sizeof(small)) {
+        simplet_value_write(writer, small, (size_t)length);
+        return length;
+    }
+
+    char *large = simplet_malloc((size_t)length + TERMINATOR);
+    if (!large) return -1;
+
+    va_start(args, format);
+    vsnprintf(large, (size_t)length + TERMINATOR, format, args);
+    va_end(args);
+
+    simplet_value_write(writer, large, (size_t)length);
+    simplet_free(large);
+    return length;
+}
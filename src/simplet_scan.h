@@ -0,0 +1,211 @@
+#ifndef SIMPLET_SCAN_H
+#define SIMPLET_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Delimiter scanning
+ * Templates are mostly literal text, so finding the next "{{" or "}}" is
+ * where rendering spends its time. One implementation is picked at compile
+ * time; define SIMPLET_SCAN_PORTABLE or SIMPLET_SCAN_SWAR to force one.
+ */
+#if defined(SIMPLET_SCAN_PORTABLE)
+    #define SIMPLET_SCAN_IMPL "portable"
+#elif defined(SIMPLET_SCAN_SWAR)
+    #define SIMPLET_SCAN_IMPL "swar"
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define SIMPLET_SCAN_SSE2 1
+    #define SIMPLET_SCAN_IMPL "sse2"
+#elif defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #include <arm_neon.h>
+    #define SIMPLET_SCAN_NEON 1
+    #define SIMPLET_SCAN_IMPL "neon"
+#else
+    #define SIMPLET_SCAN_SWAR 1
+    #define SIMPLET_SCAN_IMPL "swar"
+#endif
+
+// Bytes examined per step by the vector paths
+#define SCAN_VECTOR_WIDTH 16
+
+#if defined(SIMPLET_SCAN_SWAR)
+// Native word for word-at-a-time scanning (4 bytes on ESP32, 8 on 64-bit hosts)
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t scan_word_t;
+#else
+typedef uint32_t scan_word_t;
+#endif
+
+#define SCAN_WORD_ONES ((scan_word_t)-1 / 0xFF)
+#define SCAN_WORD_HIGHS (SCAN_WORD_ONES * 0x80)
+
+/* Helper function to test a word for a byte value
+ * Returns: non-zero if any byte of word equals the byte repeated in pattern
+ */
+static inline scan_word_t scan_word_has_byte(scan_word_t word, scan_word_t pattern) {
+    scan_word_t x = word ^ pattern;
+    return (x - SCAN_WORD_ONES) & ~x & SCAN_WORD_HIGHS;
+}
+#endif
+
+/* Finds the first doubled delimiter byte ("{{" or "}}") at or after position
+ * Returns: offset of the first byte of the pair, or length if there is none
+ */
+static inline size_t simplet_scan_pair(const char *text, size_t position, size_t length, char c) {
+#if defined(SIMPLET_SCAN_SSE2)
+    const __m128i needle = _mm_set1_epi8(c);
+
+    // Compare each block and the same block shifted by one; both must match
+    while (position + SCAN_VECTOR_WIDTH + 1 <= length) {
+        __m128i first = _mm_loadu_si128((const __m128i *)(const void *)(text + position));
+        __m128i second = _mm_loadu_si128((const __m128i *)(const void *)(text + position + 1));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, needle), _mm_cmpeq_epi8(second, needle)));
+        if (mask) return position + (size_t)__builtin_ctz(mask);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_NEON)
+    const uint8x16_t needle = vdupq_n_u8((uint8_t)c);
+
+    while (position + SCAN_VECTOR_WIDTH + 1 <= length) {
+        uint8x16_t first = vld1q_u8((const uint8_t *)text + position);
+        uint8x16_t second = vld1q_u8((const uint8_t *)text + position + 1);
+        uint8x16_t matches = vandq_u8(vceqq_u8(first, needle), vceqq_u8(second, needle));
+
+        // Narrow each byte lane to a nibble so the mask fits in 64 bits
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        if (mask) return position + (size_t)(__builtin_ctzll(mask) >> 2);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_SWAR)
+    const scan_word_t pattern = SCAN_WORD_ONES * (unsigned char)c;
+
+    // Skip whole words without the byte; the next byte must stay in bounds for the pair check
+    while (position + sizeof(scan_word_t) < length) {
+        scan_word_t word;
+        memcpy(&word, text + position, sizeof(word));
+        if (scan_word_has_byte(word, pattern)) {
+            for (size_t i = position; i < position + sizeof(scan_word_t); i++) {
+                if (text[i] == c && text[i + 1] == c) return i;
+            }
+        }
+        position += sizeof(scan_word_t);
+    }
+#endif
+
+    // Portable path, also used for the tail of the vector paths
+    while (position + 1 < length) {
+        if (text[position] == c && text[position + 1] == c) return position;
+        position++;
+    }
+
+    return length;
+}
+
+/* Helper functions to classify bytes rewritten by the escaping filters
+ * Returns: true if the html or json filter replaces c
+ */
+static inline int scan_is_html_special(unsigned char c) {
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+static inline int scan_is_json_special(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+/* Finds the first byte the html filter rewrites (& < > " ') at or after position
+ * Values are usually plain text, so whole blocks are skipped at once.
+ * Returns: offset of the byte, or length if there is none
+ */
+static inline size_t simplet_scan_html_special(const char *text, size_t position, size_t length) {
+#if defined(SIMPLET_SCAN_SSE2)
+    while (position + SCAN_VECTOR_WIDTH <= length) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(const void *)(text + position));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('&')), _mm_cmpeq_epi8(block, _mm_set1_epi8('<'))),
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('>')),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\'')))));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hits);
+        if (mask) return position + (size_t)__builtin_ctz(mask);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_NEON)
+    while (position + SCAN_VECTOR_WIDTH <= length) {
+        uint8x16_t block = vld1q_u8((const uint8_t *)text + position);
+        uint8x16_t hits = vorrq_u8(
+            vorrq_u8(vceqq_u8(block, vdupq_n_u8('&')), vceqq_u8(block, vdupq_n_u8('<'))),
+            vorrq_u8(vceqq_u8(block, vdupq_n_u8('>')),
+                     vorrq_u8(vceqq_u8(block, vdupq_n_u8('"')), vceqq_u8(block, vdupq_n_u8('\'')))));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask) return position + (size_t)(__builtin_ctzll(mask) >> 2);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_SWAR)
+    while (position + sizeof(scan_word_t) <= length) {
+        scan_word_t word;
+        memcpy(&word, text + position, sizeof(word));
+        if (scan_word_has_byte(word, SCAN_WORD_ONES * '&') | scan_word_has_byte(word, SCAN_WORD_ONES * '<') |
+            scan_word_has_byte(word, SCAN_WORD_ONES * '>') | scan_word_has_byte(word, SCAN_WORD_ONES * '"') |
+            scan_word_has_byte(word, SCAN_WORD_ONES * '\'')) {
+            break;
+        }
+        position += sizeof(scan_word_t);
+    }
+#endif
+
+    while (position < length && !scan_is_html_special((unsigned char)text[position])) {
+        position++;
+    }
+
+    return position;
+}
+
+/* Finds the first byte the json filter rewrites (" \ and control bytes) at or after position
+ * Returns: offset of the byte, or length if there is none
+ */
+static inline size_t simplet_scan_json_special(const char *text, size_t position, size_t length) {
+#if defined(SIMPLET_SCAN_SSE2)
+    const __m128i controls = _mm_set1_epi8(0x1F);
+    while (position + SCAN_VECTOR_WIDTH <= length) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(const void *)(text + position));
+        // Unsigned block <= 0x1F exactly when max(block, 0x1F) == 0x1F
+        __m128i hits = _mm_or_si128(
+            _mm_cmpeq_epi8(_mm_max_epu8(block, controls), controls),
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hits);
+        if (mask) return position + (size_t)__builtin_ctz(mask);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_NEON)
+    while (position + SCAN_VECTOR_WIDTH <= length) {
+        uint8x16_t block = vld1q_u8((const uint8_t *)text + position);
+        uint8x16_t hits = vorrq_u8(vcleq_u8(block, vdupq_n_u8(0x1F)),
+                                   vorrq_u8(vceqq_u8(block, vdupq_n_u8('"')), vceqq_u8(block, vdupq_n_u8('\\'))));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask) return position + (size_t)(__builtin_ctzll(mask) >> 2);
+        position += SCAN_VECTOR_WIDTH;
+    }
+#elif defined(SIMPLET_SCAN_SWAR)
+    while (position + sizeof(scan_word_t) <= length) {
+        scan_word_t word;
+        memcpy(&word, text + position, sizeof(word));
+        // Non-zero if any byte is below 0x20 (exact as a yes/no answer)
+        scan_word_t controls = (word - SCAN_WORD_ONES * 0x20) & ~word & SCAN_WORD_HIGHS;
+        if (controls | scan_word_has_byte(word, SCAN_WORD_ONES * '"') | scan_word_has_byte(word, SCAN_WORD_ONES * '\\')) {
+            break;
+        }
+        position += sizeof(scan_word_t);
+    }
+#endif
+
+    while (position < length && !scan_is_json_special((unsigned char)text[position])) {
+        position++;
+    }
+
+    return position;
+}
+
+#endif // SIMPLET_SCAN_H
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "include/simplet_shared.h"
+#include "simplet_internal.h"
+
+// Lets a reader inside an acquire run while a writer waits for it. On
+// FreeRTOS a plain yield never reaches lower-priority tasks, so sleep a tick.
+#ifndef SIMPLET_SHARED_YIELD
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#define SIMPLET_SHARED_YIELD() vTaskDelay(1)
+#else
+#include <sched.h>
+#define SIMPLET_SHARED_YIELD() sched_yield()
+#endif
+#endif
+
+// One published version of the contents, freed with its last reference
+struct simplet_snapshot {
+    atomic_size_t references;           // Readers holding it, plus one while it is current
+    simplet_dictionary_t *dictionary;   // Never modified once published
+};
+
+/* Readers announce themselves in the counter of the epoch they start in.
+ * A writer swaps the current snapshot, moves to the next epoch and waits
+ * for the previous epoch's counter to drain: after that no reader can still
+ * be about to take a reference to the old snapshot.
+ */
+struct simplet_shared_dictionary {
+    _Atomic(simplet_snapshot_t *) current;  // Snapshot handed to new readers
+    atomic_uint epoch;                      // Selects the reader counter for new acquires
+    atomic_size_t readers[2];               // Readers between loading current and taking a reference
+    pthread_mutex_t writer;                 // Serializes begin ... commit/abort
+};
+
+/* Wraps a dictionary in a snapshot holding one reference
+ * Returns: snapshot or NULL on allocation failure (dictionary destroyed)
+ */
+static simplet_snapshot_t* snapshot_create(simplet_dictionary_t *dictionary) {
+    simplet_snapshot_t *snapshot = simplet_malloc(sizeof(simplet_snapshot_t));
+    if (!snapshot) {
+        destroy_simplet_dictionary(dictionary);
+        return NULL;
+    }
+
+    atomic_init(&snapshot->references, 1);
+    snapshot->dictionary = dictionary;
+    return snapshot;
+}
+
+/* Creates a shared dictionary around initial contents
+ * Returns: shared dictionary or NULL on allocation failure
+ */
+simplet_shared_dictionary_t* create_simplet_shared_dictionary(simplet_dictionary_t *initial) {
+    if (!initial) initial = create_simplet_dictionary(SIZE_SMALL, true);
+    if (!initial) return NULL;
+
+    simplet_shared_dictionary_t *shared = simplet_malloc(sizeof(simplet_shared_dictionary_t));
+    if (!shared) {
+        destroy_simplet_dictionary(initial);
+        return NULL;
+    }
+
+    simplet_snapshot_t *snapshot = snapshot_create(initial);
+    if (!snapshot || pthread_mutex_init(&shared->writer, NULL) != 0) {
+        simplet_snapshot_release(snapshot);
+        simplet_free(shared);
+        return NULL;
+    }
+
+    atomic_init(&shared->current, snapshot);
+    atomic_init(&shared->epoch, 0);
+    atomic_init(&shared->readers[0], 0);
+    atomic_init(&shared->readers[1], 0);
+    return shared;
+}
+
+/* Takes a reference to the current snapshot without locking
+ * Returns: snapshot or NULL if shared is NULL
+ */
+const simplet_snapshot_t* simplet_shared_dictionary_acquire(simplet_shared_dictionary_t *shared) {
+    if (!shared) return NULL;
+
+    // Join the current epoch; retry if a writer moved on in between
+    unsigned epoch;
+    for (;;) {
+        epoch = atomic_load(&shared->epoch);
+        atomic_fetch_add(&shared->readers[epoch & 1], 1);
+        if (atomic_load(&shared->epoch) == epoch) break;
+        atomic_fetch_sub(&shared->readers[epoch & 1], 1);
+    }
+
+    simplet_snapshot_t *snapshot = atomic_load(&shared->current);
+    atomic_fetch_add_explicit(&snapshot->references, 1, memory_order_relaxed);
+
+    atomic_fetch_sub_explicit(&shared->readers[epoch & 1], 1, memory_order_release);
+    return snapshot;
+}
+
+const simplet_dictionary_t* simplet_snapshot_dictionary(const simplet_snapshot_t *snapshot) {
+    return snapshot ? snapshot->dictionary : NULL;
+}
+
+/* Drops a reference and frees the snapshot with the last one */
+void simplet_snapshot_release(const simplet_snapshot_t *snapshot) {
+    if (!snapshot) return;
+
+    simplet_snapshot_t *owned = (simplet_snapshot_t *)snapshot;
+    if (atomic_fetch_sub_explicit(&owned->references, 1, memory_order_acq_rel) != 1) return;
+
+    destroy_simplet_dictionary(owned->dictionary);
+    simplet_free(owned);
+}
+
+/* Locks out other writers and copies the current contents
+ * Returns: writable copy or NULL on NULL param or allocation failure
+ */
+simplet_dictionary_t* simplet_shared_dictionary_begin(simplet_shared_dictionary_t *shared) {
+    if (!shared) return NULL;
+
+    pthread_mutex_lock(&shared->writer);
+
+    // Only writers store current, and the lock is held
+    const simplet_snapshot_t *current = atomic_load_explicit(&shared->current, memory_order_relaxed);
+    simplet_dictionary_t *copy = copy_simplet_dictionary(current->dictionary);
+    if (!copy) pthread_mutex_unlock(&shared->writer);
+    return copy;
+}
+
+/* Publishes an edited copy, waits out readers of the old one and unlocks
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_NO_MEMORY
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_commit(simplet_shared_dictionary_t *shared,
+                                                            simplet_dictionary_t *edited) {
+    // A NULL copy comes from a failed begin, which holds no lock
+    if (!shared || !edited) return ERROR_NULL_PARAM;
+
+    simplet_snapshot_t *snapshot = snapshot_create(edited);
+    if (!snapshot) {
+        pthread_mutex_unlock(&shared->writer);
+        return ERROR_NO_MEMORY;
+    }
+
+    simplet_snapshot_t *previous = atomic_exchange(&shared->current, snapshot);
+
+    // Readers starting from here see the new snapshot; wait for the rest
+    unsigned epoch = atomic_fetch_add(&shared->epoch, 1);
+    while (atomic_load_explicit(&shared->readers[epoch & 1], memory_order_acquire) != 0) {
+        SIMPLET_SHARED_YIELD();
+    }
+
+    pthread_mutex_unlock(&shared->writer);
+
+    simplet_snapshot_release(previous);
+    return SUCCESS;
+}
+
+/* Discards an edited copy and unlocks writers */
+void simplet_shared_dictionary_abort(simplet_shared_dictionary_t *shared, simplet_dictionary_t *edited) {
+    if (!shared || !edited) return;
+
+    destroy_simplet_dictionary(edited);
+    pthread_mutex_unlock(&shared->writer);
+}
+
+/* Sets one value through a copy
+ * Returns: SUCCESS or the error of the copy, the set or the commit
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_set(simplet_shared_dictionary_t *shared, const char *key,
+                                                         const char *value) {
+    if (!shared || !key || !value) return ERROR_NULL_PARAM;
+
+    simplet_dictionary_t *edited = simplet_shared_dictionary_begin(shared);
+    if (!edited) return ERROR_NO_MEMORY;
+
+    simplet_dictionary_error_t result = simplet_dictionary_set(edited, key, value);
+    if (result != SUCCESS) {
+        simplet_shared_dictionary_abort(shared, edited);
+        return result;
+    }
+
+    return simplet_shared_dictionary_commit(shared, edited);
+}
+
+/* Removes one key through a copy
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY or ERROR_KEY_NOT_FOUND
+ */
+simplet_dictionary_error_t simplet_shared_dictionary_remove(simplet_shared_dictionary_t *shared, const char *key) {
+    if (!shared || !key) return ERROR_NULL_PARAM;
+
+    simplet_dictionary_t *edited = simplet_shared_dictionary_begin(shared);
+    if (!edited) return ERROR_NO_MEMORY;
+
+    simplet_dictionary_error_t result = simplet_dictionary_remove(edited, key);
+    if (result != SUCCESS) {
+        simplet_shared_dictionary_abort(shared, edited);
+        return result;
+    }
+
+    return simplet_shared_dictionary_commit(shared, edited);
+}
+
+/* Drops the current snapshot's reference and frees the shared state */
+void destroy_simplet_shared_dictionary(simplet_shared_dictionary_t *shared) {
+    if (!shared) return;
+
+    simplet_snapshot_release(atomic_load(&shared->current));
+    pthread_mutex_destroy(&shared->writer);
+    simplet_free(shared);
+}
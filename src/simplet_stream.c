@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_stream.h"
+#include "simplet_internal.h"
+
+_Static_assert(SIMPLET_STREAM_TAG_SIZE >= MAX_KEY_SIZE, "a stream must be able to hold any valid key");
+
+// Room for the longest placeholder body plus the "}}" that closes it
+#define STREAM_TAG_CAPACITY (SIMPLET_STREAM_TAG_SIZE + DELIMITER_LENGTH)
+
+// Streaming renderer state; the output must stay last (largest member)
+struct simplet_stream {
+    const simplet_dictionary_t *dictionary;
+    bool in_tag;                            // Inside "{{", waiting for "}}"
+    bool pending_open;                      // Previous chunk ended in a lone "{"
+    bool started;                           // Render observer told about this template
+    size_t tag_length;                      // Bytes of placeholder body held in tag
+    char tag[STREAM_TAG_CAPACITY];          // Placeholder body after "{{", then "}}"
+    char replay[STREAM_TAG_CAPACITY];       // Overflowing body, rescanned as text
+    simplet_output_t output;
+};
+
+/* Creates a stream writing to a sink
+ * Returns: stream or NULL on NULL sink or allocation failure
+ */
+simplet_stream_t* create_simplet_stream(const simplet_dictionary_t *dictionary, simplet_sink_fn write_fn, void *context) {
+    if (!write_fn) return NULL;
+
+    simplet_stream_t *stream = simplet_malloc(sizeof(simplet_stream_t));
+    if (!stream) return NULL;
+
+    stream->dictionary = dictionary;
+    stream->in_tag = false;
+    stream->pending_open = false;
+    stream->started = false;
+    stream->tag_length = 0;
+    output_init_sink(&stream->output, write_fn, context);
+    return stream;
+}
+
+/* Resolves a complete placeholder body the way simplet_find_placeholder does
+ * An empty key makes the whole tag plain text.
+ */
+static void stream_close_tag(simplet_stream_t *stream) {
+    size_t key_start = skip_whitespace(stream->tag, 0, stream->tag_length);
+    size_t key_end = skip_trailing_whitespace(stream->tag, key_start, stream->tag_length);
+    stream->in_tag = false;
+
+    if (key_end == key_start) {
+        output_write(&stream->output, DELIMITER_START, DELIMITER_LENGTH);
+        output_write(&stream->output, stream->tag, stream->tag_length);
+        output_write(&stream->output, DELIMITER_END, DELIMITER_LENGTH);
+        return;
+    }
+
+    const simplet_value_t *value = NULL;
+    uint32_t filter;
+    const char *key = stream->tag + key_start;
+    size_t key_length = simplet_split_filter(key, key_end - key_start, &filter);
+
+    // Block and partial tags are dropped (see create_simplet_stream)
+    size_t name_start;
+    if (simplet_block_kind(key, key_length, &name_start) != SIMPLET_OP_PLACEHOLDER) return;
+
+    if (key_length < MAX_KEY_SIZE) {
+        value = simplet_lookup_value(stream->dictionary, key, key_length, hash_key_n(key, key_length));
+    }
+    output_value(&stream->output, filter, value);
+}
+
+static void stream_process(simplet_stream_t *stream, const char *chunk, size_t length);
+
+/* Gives up on a placeholder body longer than SIMPLET_STREAM_TAG_SIZE
+ * Emits the first "{" as text and rescans the rest, like simplet_find_placeholder
+ * moving on by one byte.
+ */
+static void stream_overflow_tag(simplet_stream_t *stream) {
+    size_t length = stream->tag_length;
+    memcpy(stream->replay, stream->tag, length);
+    stream->in_tag = false;
+    stream->tag_length = 0;
+
+    // "{{" + body rescanned from the second "{"; the replay cannot overflow again
+    output_write(&stream->output, DELIMITER_START, 1);
+    stream_process(stream, DELIMITER_START, 1);
+    stream_process(stream, stream->replay, length);
+}
+
+/* Consumes template bytes, holding back at most a lone "{" or an unfinished placeholder */
+static void stream_process(simplet_stream_t *stream, const char *chunk, size_t length) {
+    size_t position = 0;
+
+    while (position < length && !stream->output.failed) {
+        if (stream->in_tag) {
+            // Append what fits, then look for "}}" including one split across chunks
+            size_t previous = stream->tag_length;
+            size_t room = STREAM_TAG_CAPACITY - previous;
+            size_t take = length - position < room ? length - position : room;
+            memcpy(stream->tag + previous, chunk + position, take);
+            stream->tag_length += take;
+
+            size_t scan_from = previous > 0 ? previous - 1 : 0;
+            size_t close = simplet_scan_pair(stream->tag, scan_from, stream->tag_length, DELIMITER_END[0]);
+            if (close < stream->tag_length) {
+                position += close + DELIMITER_LENGTH - previous;
+                stream->tag_length = close;
+                stream_close_tag(stream);
+                stream->tag_length = 0;
+                continue;
+            }
+
+            // A full buffer without "}}" holds a body past the limit
+            position += take;
+            if (stream->tag_length == STREAM_TAG_CAPACITY) stream_overflow_tag(stream);
+            continue;
+        }
+
+        if (stream->pending_open) {
+            stream->pending_open = false;
+            if (chunk[position] == DELIMITER_START[0]) {
+                stream->in_tag = true;
+                position++;
+                continue;
+            }
+            output_write(&stream->output, DELIMITER_START, 1);
+        }
+
+        size_t open = simplet_scan_pair(chunk, position, length, DELIMITER_START[0]);
+        if (open < length) {
+            output_write(&stream->output, chunk + position, open - position);
+            stream->in_tag = true;
+            position = open + DELIMITER_LENGTH;
+            continue;
+        }
+
+        // A final "{" may start a delimiter completed by the next chunk
+        if (chunk[length - 1] == DELIMITER_START[0]) {
+            output_write(&stream->output, chunk + position, length - 1 - position);
+            stream->pending_open = true;
+        } else {
+            output_write(&stream->output, chunk + position, length - position);
+        }
+        position = length;
+    }
+}
+
+/* Feeds template bytes through the stream
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_stream_feed(simplet_stream_t *stream, const char *chunk, size_t length) {
+    if (!stream || (!chunk && length > 0)) return ERROR_NULL_PARAM;
+
+    if (!stream->started) {
+        stream->started = true;
+        SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+    }
+
+    stream_process(stream, chunk, length);
+    return stream->output.failed ? ERROR_WRITE_FAILED : SUCCESS;
+}
+
+/* Emits held-back text (an unclosed placeholder is plain text) and flushes
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_stream_finish(simplet_stream_t *stream) {
+    if (!stream) return ERROR_NULL_PARAM;
+
+    if (stream->pending_open) {
+        output_write(&stream->output, DELIMITER_START, 1);
+    } else if (stream->in_tag) {
+        output_write(&stream->output, DELIMITER_START, DELIMITER_LENGTH);
+        output_write(&stream->output, stream->tag, stream->tag_length);
+    }
+
+    bool flushed = output_flush(&stream->output);
+    if (stream->started) SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, stream->output.length);
+
+    // Ready for the next template
+    stream->in_tag = false;
+    stream->pending_open = false;
+    stream->started = false;
+    stream->tag_length = 0;
+    output_init_sink(&stream->output, stream->output.write_fn, stream->output.context);
+
+    return flushed ? SUCCESS : ERROR_WRITE_FAILED;
+}
+
+/* Frees a stream (single allocation) */
+void destroy_simplet_stream(simplet_stream_t *stream) {
+    simplet_free(stream);
+}
+
+/* Pulls chunks from a source into a heap-allocated stream until it is exhausted
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY, ERROR_READ_FAILED or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_source(simplet_source_fn read_fn, void *read_context,
+                                                 const simplet_dictionary_t *dictionary,
+                                                 simplet_sink_fn write_fn, void *write_context) {
+    if (!read_fn || !write_fn) return ERROR_NULL_PARAM;
+
+    simplet_stream_t *stream = create_simplet_stream(dictionary, write_fn, write_context);
+    if (!stream) return ERROR_NO_MEMORY;
+
+    char chunk[SIMPLET_STREAM_CHUNK_SIZE];
+    simplet_dictionary_error_t result = SUCCESS;
+
+    for (;;) {
+        int count = read_fn(read_context, chunk, sizeof(chunk));
+        if (count < 0) {
+            result = ERROR_READ_FAILED;
+            break;
+        }
+        if (count == 0) break;
+
+        result = simplet_stream_feed(stream, chunk, (size_t)count);
+        if (result != SUCCESS) break;
+    }
+
+    // Finish even after an error so the render observer sees the end
+    simplet_dictionary_error_t finished = simplet_stream_finish(stream);
+    if (result == SUCCESS) result = finished;
+
+    destroy_simplet_stream(stream);
+    return result;
+}
+
+/* Adapts fread to simplet_source_fn
+ * Returns: bytes read, 0 at end of file, -1 on a read error
+ */
+static int read_file(void *context, char *buffer, size_t capacity) {
+    FILE *file = context;
+    size_t count = fread(buffer, 1, capacity, file);
+    if (count == 0 && ferror(file)) return -1;
+    return (int)count;
+}
+
+/* Streams a template from an open file
+ * Returns: SUCCESS, ERROR_NULL_PARAM, ERROR_NO_MEMORY, ERROR_READ_FAILED or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_file(FILE *file, const simplet_dictionary_t *dictionary,
+                                               simplet_sink_fn write_fn, void *context) {
+    if (!file) return ERROR_NULL_PARAM;
+    return simplet_render_source(read_file, file, dictionary, write_fn, context);
+}
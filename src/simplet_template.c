@@ -0,0 +1,516 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "include/simplet_template.h"
+#include "include/simplet_dictionary.h"
+#include "simplet_internal.h"
+
+// Open block while compiling, matched to its closing tag by name
+typedef struct {
+    const char *name;   // Name in the template text
+    size_t length;      // Name length
+    size_t op;          // Index of the block operation
+} open_block_t;
+
+// Counts and sizes gathered while building operations
+typedef struct {
+    size_t placeholder_count;
+    size_t block_count;
+    size_t partial_count;
+    size_t literal_length;
+    size_t pool_length;
+} build_totals_t;
+
+/* Walks the template once, either counting (ops == NULL) or filling ops
+ * NUL-terminated keys, and literal text when copy_literals is set, are
+ * packed into pool in output order; otherwise literals point into the source.
+ * A closing tag ends the innermost open block of that name along with any
+ * blocks still open inside it; unmatched closing tags produce nothing and
+ * blocks left open end with the template. Blocks opened past
+ * SIMPLET_MAX_BLOCK_DEPTH are only counted, and the closing tags that follow
+ * end them first, so they cannot close an outer block early.
+ * Returns: number of operations
+ */
+static size_t build_ops(const char *html_template, size_t html_length, bool copy_literals, simplet_op_t *ops,
+                        char *pool, build_totals_t *totals) {
+    size_t op_count = 0;
+    size_t position = 0;
+    size_t pool_used = 0;
+    size_t depth = 0;
+    size_t overflow = 0;            // Blocks opened past the deepest tracked level
+    open_block_t blocks[SIMPLET_MAX_BLOCK_DEPTH];
+    simplet_placeholder_t placeholder;
+
+    memset(totals, 0, sizeof(*totals));
+
+    while (position < html_length) {
+        bool found = simplet_find_placeholder(html_template, html_length, position, &placeholder);
+        size_t literal_end = found ? placeholder.start : html_length;
+
+        if (literal_end > position) {
+            size_t span = literal_end - position;
+            if (ops) {
+                if (copy_literals) {
+                    memcpy(pool + pool_used, html_template + position, span);
+                    ops[op_count].text = pool + pool_used;
+                } else {
+                    ops[op_count].text = html_template + position;
+                }
+                ops[op_count].length = span;
+                ops[op_count].hash = 0;
+                ops[op_count].kind = SIMPLET_OP_LITERAL;
+                ops[op_count].filter = SIMPLET_FILTER_NONE;
+                ops[op_count].end = 0;
+            }
+            if (copy_literals) pool_used += span;
+            totals->literal_length += span;
+            op_count++;
+        }
+
+        if (!found) break;
+        position = placeholder.end;
+
+        size_t name_start = 0;
+        uint32_t kind = simplet_block_kind(html_template + placeholder.key_start, placeholder.key_length, &name_start);
+        const char *key_text = html_template + placeholder.key_start + name_start;
+        size_t key_length = placeholder.key_length - name_start;
+
+        if (kind == SIMPLET_BLOCK_END) {
+            if (overflow > 0) {
+                overflow--;
+                continue;
+            }
+            for (size_t d = depth; d-- > 0;) {
+                if (blocks[d].length == key_length && memcmp(blocks[d].name, key_text, key_length) == 0) {
+                    for (size_t j = d; ops && j < depth; j++) ops[blocks[j].op].end = (uint32_t)op_count;
+                    depth = d;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        if (kind == SIMPLET_OP_PARTIAL) {
+            totals->partial_count++;
+        } else if (kind != SIMPLET_OP_PLACEHOLDER) {
+            if (depth == SIMPLET_MAX_BLOCK_DEPTH) {
+                overflow++;
+                continue;
+            }
+            blocks[depth].name = key_text;
+            blocks[depth].length = key_length;
+            blocks[depth].op = op_count;
+            depth++;
+            totals->block_count++;
+        } else {
+            totals->placeholder_count++;
+        }
+
+        if (ops) {
+            char *key = pool + pool_used;
+            memcpy(key, key_text, key_length);
+            key[key_length] = '\0';
+            ops[op_count].text = key;
+            ops[op_count].length = key_length;
+            ops[op_count].hash = hash_key_n(key, key_length);
+            ops[op_count].kind = (uint16_t)kind;
+            ops[op_count].filter = kind == SIMPLET_OP_PLACEHOLDER ? (uint16_t)placeholder.filter : SIMPLET_FILTER_NONE;
+            if (kind == SIMPLET_OP_PARTIAL) ops[op_count].partial = NULL;
+            else ops[op_count].end = 0;
+        }
+        pool_used += key_length + TERMINATOR;
+        op_count++;
+    }
+
+    // Blocks still open run to the end
+    for (size_t j = 0; ops && j < depth; j++) ops[blocks[j].op].end = (uint32_t)op_count;
+
+    totals->pool_length = pool_used;
+    return op_count;
+}
+
+/* Compiles a template of known length
+ * The template, operation list and text pool share a single allocation.
+ * Returns: compiled template or NULL on allocation failure
+ */
+static simplet_template_t* compile_template(const char *html_template, size_t html_length, bool copy_literals) {
+    build_totals_t totals;
+    size_t op_count = build_ops(html_template, html_length, copy_literals, NULL, NULL, &totals);
+    if (op_count > UINT32_MAX) return NULL;
+
+    size_t ops_size = op_count * sizeof(simplet_op_t);
+    simplet_template_t *compiled = simplet_malloc(sizeof(simplet_template_t) + ops_size + totals.pool_length);
+    if (!compiled) return NULL;
+
+    compiled->ops = (simplet_op_t *)(compiled + 1);
+    char *pool = (char *)compiled->ops + ops_size;
+
+    compiled->op_count = build_ops(html_template, html_length, copy_literals, compiled->ops, pool, &totals);
+    compiled->placeholder_count = totals.placeholder_count;
+    compiled->literal_length = totals.literal_length;
+    compiled->block_count = totals.block_count;
+    compiled->partial_count = totals.partial_count;
+
+    return compiled;
+}
+
+/* Compiles the rest of a template from a given offset, keeping literals in place
+ * Used by simplet_render_html once it meets a block tag.
+ * Returns: compiled template or NULL on allocation failure
+ */
+simplet_template_t* simplet_compile_tail(const char *html_template, size_t html_length, size_t position) {
+    return compile_template(html_template + position, html_length - position, false);
+}
+
+/* Compiles a template into literal spans and pre-hashed placeholder lookups
+ * Returns: compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template(const char *html_template) {
+    if (!html_template) return NULL;
+
+    const size_t html_length = safe_strlen(html_template, MAX_TEMPLATE_SIZE);
+    if (html_length == SIZE_MAX) return NULL;
+
+    return compile_template(html_template, html_length, true);
+}
+
+/* Compiles a template given by pointer and length, copying its text
+ * Returns: compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template_n(const char *html_template, size_t length) {
+    if (!html_template && length > 0) return NULL;
+    return compile_template(html_template, length, true);
+}
+
+/* Compiles a template whose literal text stays where it is (flash, mmap)
+ * Only the operation list and keys are allocated.
+ * Returns: compiled template or NULL on invalid input or allocation failure
+ */
+simplet_template_t* compile_simplet_template_borrowed(const char *html_template, size_t length) {
+    if (!html_template && length > 0) return NULL;
+    return compile_template(html_template, length, false);
+}
+
+/* Grows output buffer so that at least required bytes fit
+ * Returns: true on success, false on allocation failure (buffer untouched)
+ */
+static bool reserve_output(char **buffer, size_t *capacity, size_t required) {
+    if (required <= *capacity) return true;
+
+    size_t new_capacity = *capacity * 2;
+    if (new_capacity < required) new_capacity = required;
+
+    char *grown = simplet_realloc(*buffer, new_capacity);
+    if (!grown) return false;
+
+    *buffer = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/* Grows an output's buffer to twice its capacity, or to what fits length more bytes
+ * One byte past capacity is always allocated for the terminator.
+ * Returns: true on success, false on allocation failure (the output is then failed)
+ */
+bool output_grow(simplet_output_t *output, size_t length) {
+    size_t capacity = output->capacity * 2;
+    if (capacity - output->length < length) capacity = output->length + length;
+
+    char *grown = output->buffer ? simplet_realloc(output->buffer, capacity + TERMINATOR)
+                                 : simplet_malloc(capacity + TERMINATOR);
+    if (!grown) {
+        output->failed = true;
+        return false;
+    }
+
+    output->buffer = grown;
+    output->capacity = capacity;
+    return true;
+}
+
+/* Terminates a growing output, giving back the unused capacity
+ * Returns: NUL-terminated buffer, NULL if the output failed or on allocation failure
+ */
+char* simplet_growing_finish(simplet_output_t *output) {
+    if (output->failed) {
+        simplet_free(output->buffer);
+        return NULL;
+    }
+    if (!output->buffer) return EMPTY_STRING();
+
+    output->buffer[output->length] = '\0';
+    if (output->length == output->capacity) return output->buffer;
+
+    // Shrinking in place cannot fail in practice; keep the larger buffer if it does
+    char *shrunk = simplet_realloc(output->buffer, output->length + TERMINATOR);
+    return shrunk ? shrunk : output->buffer;
+}
+
+static void render_ops_to_output(const simplet_template_t *compiled, size_t begin, size_t end,
+                                 const simplet_scope_t *scope, size_t depth, simplet_output_t *output);
+
+/* Renders the body of a block zero or more times
+ * A section over a list renders its body once per item, with the item
+ * searched before the enclosing scopes.
+ */
+static void render_block(const simplet_template_t *compiled, size_t index, const simplet_scope_t *scope,
+                         size_t depth, simplet_output_t *output) {
+    const simplet_op_t *op = &compiled->ops[index];
+    const simplet_value_t *value = simplet_scope_find(scope, op->text, op->length, op->hash);
+
+    if (op->kind == SIMPLET_OP_SECTION && value && value->kind == SIMPLET_VALUE_LIST) {
+        for (uint32_t i = 0; i < value->length && !output->failed; i++) {
+            simplet_scope_t item = { value->items[i], scope };
+            render_ops_to_output(compiled, index + 1, op->end, &item, depth, output);
+        }
+        return;
+    }
+
+    bool set = simplet_value_is_set(value);
+    if (set != (op->kind == SIMPLET_OP_UNLESS)) {
+        render_ops_to_output(compiled, index + 1, op->end, scope, depth, output);
+    }
+}
+
+/* Walks a range of the operation list and writes literals, substituted values and blocks
+ * A linked partial is rendered in place with the current scopes; depth counts
+ * the partials already entered, so a partial including itself stops at
+ * SIMPLET_MAX_PARTIAL_DEPTH.
+ */
+static void render_ops_to_output(const simplet_template_t *compiled, size_t begin, size_t end,
+                                 const simplet_scope_t *scope, size_t depth, simplet_output_t *output) {
+    for (size_t i = begin; i < end && !output->failed; i++) {
+        const simplet_op_t *op = &compiled->ops[i];
+
+        if (op->kind == SIMPLET_OP_PLACEHOLDER) {
+            output_value(output, op->filter, simplet_scope_lookup(scope, op->text, op->length, op->hash));
+        } else if (op->kind == SIMPLET_OP_LITERAL) {
+            output_write(output, op->text, op->length);
+        } else if (op->kind == SIMPLET_OP_PARTIAL) {
+            if (op->partial && depth < SIMPLET_MAX_PARTIAL_DEPTH) {
+                render_ops_to_output(op->partial, 0, op->partial->op_count, scope, depth + 1, output);
+            }
+        } else {
+            render_block(compiled, i, scope, depth, output);
+            i = op->end - 1;
+        }
+    }
+}
+
+/* Renders a whole compiled template to an output */
+void simplet_render_ops(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                        simplet_output_t *output) {
+    simplet_render_range(compiled, 0, compiled->op_count, dictionary, output);
+}
+
+/* Renders a range of top-level operations to an output (a parallel render's segment) */
+void simplet_render_range(const simplet_template_t *compiled, size_t begin, size_t end,
+                          const simplet_dictionary_t *dictionary, simplet_output_t *output) {
+    simplet_scope_t scope = { dictionary, NULL };
+    render_ops_to_output(compiled, begin, end, &scope, 0, output);
+}
+
+/* Renders a template with blocks, partials or providers in one pass into a growing buffer
+ * Returns: newly allocated string with substitutions, NULL on allocation failure
+ */
+static char* render_blocks(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary) {
+    simplet_output_t output;
+    output_init_growing(&output, compiled->literal_length);
+    simplet_render_ops(compiled, dictionary, &output);
+
+    char *output_buffer = simplet_growing_finish(&output);
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.failed ? 0 : output.length);
+    return output_buffer;
+}
+
+/* Renders a compiled template with dictionary substitutions
+ * Only walks the operation list: literals are copied with memcpy and each
+ * placeholder costs a single lookup using its precomputed hash.
+ * Returns: newly allocated string with substitutions, NULL on NULL compiled or allocation failure
+ */
+char* simplet_template_render_checked(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary) {
+    if (!compiled) {
+        return NULL;
+    }
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    // Large templates are split across workers when parallel rendering is enabled
+    if (simplet_parallel_applies(compiled->literal_length)) {
+        size_t length;
+        char *rendered = simplet_render_parallel(compiled, dictionary, &length);
+        if (rendered) {
+            SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, length);
+            return rendered;
+        }
+    }
+
+    // Blocks repeat or skip literals and partials add their own, so their output grows as it is rendered
+    if (!simplet_template_is_flat(compiled)) return render_blocks(compiled, dictionary);
+
+    // Literals are known up front; values are added as they are looked up
+    size_t required = compiled->literal_length + TERMINATOR;
+    size_t capacity = required;
+    char *output_buffer = simplet_malloc(capacity);
+    if (!output_buffer) {
+        SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, 0);
+        return NULL;
+    }
+
+    size_t output_length = 0;
+
+    for (size_t i = 0; i < compiled->op_count; i++) {
+        const simplet_op_t *op = &compiled->ops[i];
+        const char *text = op->text;
+        size_t length = op->length;
+        char number[SIMPLET_NUMBER_SIZE];
+
+        if (op->kind == SIMPLET_OP_PLACEHOLDER) {
+            // Missing or empty values render nothing
+            const simplet_value_t *value = simplet_lookup_value(dictionary, op->text, op->length, op->hash);
+
+            // Provider output is not known up front; render the rest into the buffer as it grows
+            if (value && value->kind == SIMPLET_VALUE_PROVIDER) {
+                simplet_output_t output;
+                output_init_buffer(&output, output_buffer, capacity - TERMINATOR);
+                output.length = output_length;
+                output.growing = true;
+                simplet_render_range(compiled, i, compiled->op_count, dictionary, &output);
+
+                output_buffer = simplet_growing_finish(&output);
+                SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.failed ? 0 : output.length);
+                return output_buffer;
+            }
+
+            SIMPLET_STAT_ADD(value ? SIMPLET_STAT_PLACEHOLDERS_RESOLVED : SIMPLET_STAT_PLACEHOLDERS_MISSED, 1);
+            if (!value) continue;
+
+            if (SIMPLET_VALUE_IS_NUMBER(value->kind)) {
+                text = number;
+                length = simplet_format_number(value, op->filter, number);
+            } else {
+                text = value->text;
+                length = value->length;
+            }
+
+            // Escaped values are sized before they are copied
+            size_t escaped = simplet_escaped_length(op->filter, text, length);
+            required += escaped;
+            if (!reserve_output(&output_buffer, &capacity, required)) {
+                simplet_free(output_buffer);
+                SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, 0);
+                return NULL;
+            }
+
+            if (op->filter != SIMPLET_FILTER_NONE) {
+                output_length += simplet_escape(op->filter, text, length, output_buffer + output_length);
+                continue;
+            }
+        }
+
+        memcpy(output_buffer + output_length, text, length);
+        output_length += length;
+    }
+
+    // Null-terminate the result
+    output_buffer[output_length] = '\0';
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output_length);
+
+    return output_buffer;
+}
+
+/* Renders a compiled template with dictionary substitutions
+ * Returns: newly allocated string with substitutions, never returns NULL
+ */
+char* simplet_template_render(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary) {
+    char *rendered = simplet_template_render_checked(compiled, dictionary);
+    return rendered ? rendered : EMPTY_STRING();
+}
+
+/* Streams a compiled template into a sink through a fixed scratch buffer
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_WRITE_FAILED
+ */
+simplet_dictionary_error_t simplet_render_to_sink(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary,
+                                                  simplet_sink_fn write_fn, void *context) {
+    if (!compiled || !write_fn) return ERROR_NULL_PARAM;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    simplet_output_t output;
+    output_init_sink(&output, write_fn, context);
+    simplet_render_ops(compiled, dictionary, &output);
+
+    bool flushed = output_flush(&output);
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.length);
+
+    return flushed ? SUCCESS : ERROR_WRITE_FAILED;
+}
+
+/* Renders a compiled template into a caller-provided buffer, snprintf style
+ * Returns: SUCCESS, ERROR_NULL_PARAM or ERROR_BUFFER_TOO_SMALL when truncated
+ */
+simplet_dictionary_error_t simplet_render_into(char *buffer, size_t capacity, const simplet_template_t *compiled,
+                                               const simplet_dictionary_t *dictionary, size_t *needed) {
+    if (!compiled || (!buffer && capacity > 0)) return ERROR_NULL_PARAM;
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);
+
+    // Reserve room for the terminator
+    simplet_output_t output;
+    output_init_buffer(&output, buffer, capacity > 0 ? capacity - TERMINATOR : 0);
+    simplet_render_ops(compiled, dictionary, &output);
+
+    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, output.length);
+
+    if (capacity > 0) {
+        buffer[output.length < output.capacity ? output.length : output.capacity] = '\0';
+    }
+
+    if (needed) *needed = output.length;
+
+    return output.length < capacity ? SUCCESS : ERROR_BUFFER_TOO_SMALL;
+}
+
+/* Computes the exact rendered length: literal bytes plus one lookup per placeholder
+ * Filtered values are scanned for the bytes their escaping expands; providers
+ * run into an output that only counts.
+ * Returns: output length excluding the terminator, 0 if compiled is NULL
+ */
+size_t simplet_render_length(const simplet_template_t *compiled, const simplet_dictionary_t *dictionary) {
+    if (!compiled) return 0;
+
+    if (!simplet_template_is_flat(compiled)) {
+        simplet_output_t output;
+        output_init_buffer(&output, NULL, 0);
+        simplet_render_ops(compiled, dictionary, &output);
+        return output.length;
+    }
+
+    size_t length = compiled->literal_length;
+
+    for (size_t i = 0; i < compiled->op_count; i++) {
+        const simplet_op_t *op = &compiled->ops[i];
+        if (op->kind != SIMPLET_OP_PLACEHOLDER) continue;
+
+        const simplet_value_t *value = simplet_lookup_value(dictionary, op->text, op->length, op->hash);
+        if (!value) continue;
+
+        if (value->kind == SIMPLET_VALUE_PROVIDER) {
+            length += simplet_provided_length(value->provider, op->filter);
+        } else if (SIMPLET_VALUE_IS_NUMBER(value->kind)) {
+            char number[SIMPLET_NUMBER_SIZE];
+            length += simplet_escaped_length(op->filter, number, simplet_format_number(value, op->filter, number));
+        } else {
+            length += simplet_escaped_length(op->filter, value->text, value->length);
+        }
+    }
+
+    return length;
+}
+
+/* Frees a compiled template (single allocation) */
+void destroy_simplet_template(simplet_template_t *compiled) {
+    simplet_free(compiled);
+}
@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include "../simplet_internal.h"
+
+/*
+ * Build-time template compiler
+ * Usage: simplet_compile <template> <output.c> <output.h> <name>
+ * Parses the template with the same rules as the runtime and writes C
+ * source with the literal segments as const arrays, a render function
+ * specialised for the template (keys pre-hashed, looked up once each) and
+ * a simplet_template_t usable with every compiled-template API.
+ */
+
+// One literal span, placeholder or block in output order (an operation)
+typedef struct {
+    size_t start;       // Offset in the template
+    size_t length;      // Literal length or key length
+    uint32_t kind;      // simplet_op_kind_t
+    size_t key_index;   // Index into the unique keys (placeholders and blocks)
+    uint32_t filter;    // simplet_filter_t (placeholders)
+    size_t end;         // Blocks: index of the first segment after the body
+} segment_t;
+
+// Unique key
+typedef struct {
+    const char *text;
+    size_t length;
+    uint32_t hash;
+} template_key_t;
+
+typedef struct {
+    const char *text;
+    size_t length;
+    segment_t *segments;
+    size_t segment_count;
+    template_key_t *keys;
+    size_t key_count;
+    size_t literal_length;
+    size_t block_count;
+    size_t partial_count;
+} parsed_t;
+
+static void fail(const char *message, const char *detail) {
+    fprintf(stderr, "simplet_compile: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+static void* checked_realloc(void *memory, size_t size) {
+    memory = realloc(memory, size ? size : 1);
+    if (!memory) fail("out of memory", NULL);
+    return memory;
+}
+
+static char* read_file(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (!file) fail("cannot open", path);
+
+    char *data = NULL;
+    size_t used = 0;
+    size_t capacity = 0;
+    for (;;) {
+        if (used == capacity) {
+            capacity = capacity ? capacity * 2 : 4096;
+            data = checked_realloc(data, capacity);
+        }
+        size_t count = fread(data + used, 1, capacity - used, file);
+        if (count == 0) break;
+        used += count;
+    }
+    if (ferror(file)) fail("cannot read", path);
+    fclose(file);
+
+    *length = used;
+    return data;
+}
+
+static void add_segment(parsed_t *parsed, size_t start, size_t length, uint32_t kind, size_t key_index,
+                        uint32_t filter) {
+    parsed->segments = checked_realloc(parsed->segments, (parsed->segment_count + 1) * sizeof(segment_t));
+    segment_t *segment = &parsed->segments[parsed->segment_count++];
+    segment->start = start;
+    segment->length = length;
+    segment->kind = kind;
+    segment->end = 0;
+    segment->key_index = key_index;
+    segment->filter = filter;
+}
+
+/* Returns: index of the key, added if it is new */
+static size_t intern_key(parsed_t *parsed, const char *text, size_t length) {
+    for (size_t i = 0; i < parsed->key_count; i++) {
+        if (parsed->keys[i].length == length && memcmp(parsed->keys[i].text, text, length) == 0) return i;
+    }
+
+    parsed->keys = checked_realloc(parsed->keys, (parsed->key_count + 1) * sizeof(template_key_t));
+    parsed->keys[parsed->key_count].text = text;
+    parsed->keys[parsed->key_count].length = length;
+    parsed->keys[parsed->key_count].hash = hash_key_n(text, length);
+    return parsed->key_count++;
+}
+
+/* Splits the template exactly like compile_simplet_template
+ * Placeholders whose key is too long for a dictionary can never match, so
+ * they produce nothing. Blocks are matched to closing tags by the same rules.
+ */
+static void parse(parsed_t *parsed) {
+    simplet_placeholder_t placeholder;
+    size_t position = 0;
+    size_t open[SIMPLET_MAX_BLOCK_DEPTH];
+    size_t depth = 0;
+    size_t overflow = 0;
+
+    while (position < parsed->length) {
+        bool found = simplet_find_placeholder(parsed->text, parsed->length, position, &placeholder);
+        size_t literal_end = found ? placeholder.start : parsed->length;
+
+        if (literal_end > position) {
+            add_segment(parsed, position, literal_end - position, SIMPLET_OP_LITERAL, 0, SIMPLET_FILTER_NONE);
+            parsed->literal_length += literal_end - position;
+        }
+        if (!found) break;
+        position = placeholder.end;
+
+        size_t name_start = 0;
+        uint32_t kind = simplet_block_kind(parsed->text + placeholder.key_start, placeholder.key_length, &name_start);
+        size_t key_start = placeholder.key_start + name_start;
+        size_t key_length = placeholder.key_length - name_start;
+
+        if (kind == SIMPLET_BLOCK_END) {
+            if (overflow > 0) {
+                overflow--;
+                continue;
+            }
+            for (size_t d = depth; d-- > 0;) {
+                const segment_t *block = &parsed->segments[open[d]];
+                if (block->length == key_length && memcmp(parsed->text + block->start, parsed->text + key_start, key_length) == 0) {
+                    for (size_t j = d; j < depth; j++) parsed->segments[open[j]].end = parsed->segment_count;
+                    depth = d;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        if (kind == SIMPLET_OP_PARTIAL) {
+            parsed->partial_count++;
+        } else if (kind != SIMPLET_OP_PLACEHOLDER) {
+            if (depth == SIMPLET_MAX_BLOCK_DEPTH) {
+                overflow++;
+                continue;
+            }
+            open[depth++] = parsed->segment_count;
+            parsed->block_count++;
+        } else if (key_length >= MAX_KEY_SIZE) {
+            continue;
+        }
+
+        size_t key = intern_key(parsed, parsed->text + key_start, key_length);
+        add_segment(parsed, key_start, key_length, kind, key, kind == SIMPLET_OP_PLACEHOLDER ? placeholder.filter : SIMPLET_FILTER_NONE);
+    }
+
+    for (size_t j = 0; j < depth; j++) parsed->segments[open[j]].end = parsed->segment_count;
+}
+
+/* Writes bytes as the body of a C string literal, wrapping long lines
+ * Octal escapes always use three digits so a following digit cannot extend them.
+ */
+static void write_string(FILE *out, const char *text, size_t length, const char *indent) {
+    size_t column = 0;
+    fprintf(out, "%s\"", indent);
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (column >= 72) {
+            fprintf(out, "\"\n%s\"", indent);
+            column = 0;
+        }
+
+        if (c == '"' || c == '\\') {
+            column += (size_t)fprintf(out, "\\%c", c);
+        } else if (c == '\n') {
+            column += (size_t)fprintf(out, "\\n");
+        } else if (c == '?') {
+            column += (size_t)fprintf(out, "\\?");   // No trigraphs
+        } else if (c >= 0x20 && c < 0x7f) {
+            fputc(c, out);
+            column++;
+        } else {
+            column += (size_t)fprintf(out, "\\%03o", c);
+        }
+
+        if (c == '\n' && i + 1 < length) {
+            fprintf(out, "\"\n%s\"", indent);
+            column = 0;
+        }
+    }
+
+    fprintf(out, "\"");
+}
+
+static void write_header(FILE *out, const parsed_t *parsed, const char *name, const char *source) {
+    char guard[256];
+    size_t i = 0;
+    for (; name[i]; i++) guard[i] = (char)toupper((unsigned char)name[i]);
+    strcpy(guard + i, "_TEMPLATE_H");
+
+    fprintf(out, "// Generated by simplet_compile from %s, do not edit\n", source);
+    fprintf(out, "#ifndef SIMPLET_%s\n#define SIMPLET_%s\n\n", guard, guard);
+    fprintf(out, "#include \"simplet.h\"\n\n");
+    const char *literal_note = "rendered whatever the dictionary holds";
+    if (parsed->partial_count) literal_note = "not counting partials";
+    if (parsed->block_count) literal_note = "including text inside sections and conditionals";
+    fprintf(out, "// Bytes of literal text, %s\n", literal_note);
+    fprintf(out, "#define SIMPLET_%.*s_LITERAL_LENGTH %zu\n\n", (int)(strlen(guard) - strlen("_TEMPLATE_H")), guard,
+            parsed->literal_length);
+    // Templates with partials are linked in place, so they cannot be const
+    const char *qualifier = parsed->partial_count ? "" : "const ";
+    fprintf(out, "// Compiled form for simplet_render_to_sink, simplet_render_into, caches and incremental renders\n");
+    if (parsed->partial_count) fprintf(out, "// Link it with simplet_partials_link before rendering\n");
+    fprintf(out, "extern %ssimplet_template_t simplet_template_%s;\n\n", qualifier, name);
+    fprintf(out, "/**\n * Compute the exact length of a render of %s\n", source);
+    fprintf(out, " * @param dictionary Key-value pairs for substitution (may be NULL)\n");
+    fprintf(out, " * @return Output length excluding the terminator\n */\n");
+    fprintf(out, "size_t simplet_render_%s_length(const simplet_dictionary_t *dictionary);\n\n", name);
+    fprintf(out, "/**\n * Render %s with dictionary substitutions\n", source);
+    fprintf(out, " * @param dictionary Key-value pairs for substitution (may be NULL)\n");
+    fprintf(out, " * @return Newly allocated string with substitutions, never returns NULL\n */\n");
+    fprintf(out, "char* simplet_render_%s(const simplet_dictionary_t *dictionary);\n\n", name);
+    fprintf(out, "#endif\n");
+}
+
+static const char* kind_name(uint32_t kind) {
+    switch (kind) {
+        case SIMPLET_OP_PLACEHOLDER: return "SIMPLET_OP_PLACEHOLDER";
+        case SIMPLET_OP_SECTION: return "SIMPLET_OP_SECTION";
+        case SIMPLET_OP_IF: return "SIMPLET_OP_IF";
+        case SIMPLET_OP_UNLESS: return "SIMPLET_OP_UNLESS";
+        case SIMPLET_OP_PARTIAL: return "SIMPLET_OP_PARTIAL";
+        default: return "SIMPLET_OP_LITERAL";
+    }
+}
+
+/* Names a filter in generated code; format hints are written as their encoding
+ * Returns: constant name, or hex literal in a buffer reused by the next call
+ */
+static const char* filter_name(uint32_t filter) {
+    static char format[16];
+
+    switch (filter) {
+        case SIMPLET_FILTER_HTML: return "SIMPLET_FILTER_HTML";
+        case SIMPLET_FILTER_URL: return "SIMPLET_FILTER_URL";
+        case SIMPLET_FILTER_JSON: return "SIMPLET_FILTER_JSON";
+        case SIMPLET_FILTER_NONE: return "SIMPLET_FILTER_NONE";
+        default:
+            snprintf(format, sizeof(format), "0x%04xu", (unsigned)filter);
+            return format;
+    }
+}
+
+/* Emits the output length sum shared by the length and render functions
+ * Filtered placeholders keep their escaped length in escaped_<segment>.
+ */
+static void write_length(FILE *out, const parsed_t *parsed) {
+    fprintf(out, "    size_t length = %zu;\n", parsed->literal_length);
+    for (size_t i = 0; i < parsed->segment_count; i++) {
+        const segment_t *segment = &parsed->segments[i];
+        if (segment->kind != SIMPLET_OP_PLACEHOLDER) continue;
+        if (segment->filter == SIMPLET_FILTER_NONE) {
+            fprintf(out, "    if (value_%zu) length += value_%zu->length;\n", segment->key_index, segment->key_index);
+        } else {
+            fprintf(out, "    size_t escaped_%zu = value_%zu ? simplet_escaped_length(%s, value_%zu->text, value_%zu->length) : 0;\n",
+                    i, segment->key_index, filter_name(segment->filter), segment->key_index, segment->key_index);
+            fprintf(out, "    length += escaped_%zu;\n", i);
+        }
+    }
+}
+
+/* Emits the lookups shared by the length and render functions
+ * A key holding a provider or a number hands the whole render to the
+ * generic function fallback, which formats as it goes; lists and empty
+ * strings count as missing, as in simplet_written_value.
+ */
+static void write_lookups(FILE *out, const parsed_t *parsed, const char *name, const char *fallback) {
+    for (size_t k = 0; k < parsed->key_count; k++) {
+        fprintf(out, "    const simplet_value_t *value_%zu = simplet_dictionary_find_value(dictionary, "
+                     "simplet_%s_key_%zu, %zu, 0x%08xu);\n",
+                k, name, k, parsed->keys[k].length, (unsigned)parsed->keys[k].hash);
+        fprintf(out, "    if (value_%zu && (value_%zu->kind == SIMPLET_VALUE_PROVIDER || "
+                     "SIMPLET_VALUE_IS_NUMBER(value_%zu->kind))) return %s(&simplet_template_%s, dictionary);\n",
+                k, k, k, fallback, name);
+        fprintf(out, "    if (value_%zu && (value_%zu->kind != SIMPLET_VALUE_TEXT || value_%zu->length == 0)) value_%zu = NULL;\n",
+                k, k, k, k);
+    }
+}
+
+/* Emits the placeholder counters, one addition per key for all of its placeholders */
+static void write_placeholder_stats(FILE *out, const parsed_t *parsed) {
+    for (size_t k = 0; k < parsed->key_count; k++) {
+        size_t uses = 0;
+        for (size_t i = 0; i < parsed->segment_count; i++) {
+            const segment_t *segment = &parsed->segments[i];
+            if (segment->kind == SIMPLET_OP_PLACEHOLDER && segment->key_index == k) uses++;
+        }
+        if (uses == 0) continue;
+        fprintf(out, "    SIMPLET_STAT_ADD(value_%zu ? SIMPLET_STAT_PLACEHOLDERS_RESOLVED : SIMPLET_STAT_PLACEHOLDERS_MISSED, %zu);\n",
+                k, uses);
+    }
+}
+
+static void write_source(FILE *out, const parsed_t *parsed, const char *name, const char *source, const char *header) {
+    fprintf(out, "// Generated by simplet_compile from %s, do not edit\n", source);
+    fprintf(out, "#include <stdlib.h>\n#include <string.h>\n#include \"%s\"\n\n", header);
+
+    // Literal segments and keys
+    size_t literal = 0;
+    for (size_t i = 0; i < parsed->segment_count; i++) {
+        const segment_t *segment = &parsed->segments[i];
+        if (segment->kind != SIMPLET_OP_LITERAL) continue;
+        fprintf(out, "static const char simplet_%s_literal_%zu[] =\n", name, literal++);
+        write_string(out, parsed->text + segment->start, segment->length, "    ");
+        fprintf(out, ";\n\n");
+    }
+    for (size_t k = 0; k < parsed->key_count; k++) {
+        fprintf(out, "static const char simplet_%s_key_%zu[] = ", name, k);
+        write_string(out, parsed->keys[k].text, parsed->keys[k].length, "");
+        fprintf(out, ";\n");
+    }
+    if (parsed->key_count) fprintf(out, "\n");
+
+    // Operation list for the generic compiled-template API
+    size_t placeholders = 0;
+    // Partials are linked into their operations at run time; otherwise the table can live in flash
+    const char *qualifier = parsed->partial_count ? "" : "const ";
+    fprintf(out, "static %ssimplet_op_t simplet_%s_ops[] = {\n", qualifier, name);
+    literal = 0;
+    for (size_t i = 0; i < parsed->segment_count; i++) {
+        const segment_t *segment = &parsed->segments[i];
+        if (segment->kind != SIMPLET_OP_LITERAL) {
+            const template_key_t *key = &parsed->keys[segment->key_index];
+            fprintf(out, "    { simplet_%s_key_%zu, %zu, 0x%08xu, %s, %s, { %zu } },\n", name, segment->key_index,
+                    key->length, (unsigned)key->hash, kind_name(segment->kind), filter_name(segment->filter),
+                    segment->end);
+            if (segment->kind == SIMPLET_OP_PLACEHOLDER) placeholders++;
+        } else {
+            fprintf(out, "    { simplet_%s_literal_%zu, %zu, 0, SIMPLET_OP_LITERAL, SIMPLET_FILTER_NONE, { 0 } },\n", name,
+                    literal++, segment->length);
+        }
+    }
+    if (parsed->segment_count == 0) fprintf(out, "    { \"\", 0, 0, SIMPLET_OP_LITERAL, SIMPLET_FILTER_NONE, { 0 } }\n");
+    fprintf(out, "};\n\n");
+    fprintf(out, "%ssimplet_template_t simplet_template_%s = { %ssimplet_%s_ops, %zu, %zu, %zu, %zu, %zu };\n\n",
+            qualifier, name, parsed->partial_count ? "" : "(simplet_op_t *)", name, parsed->segment_count, placeholders,
+            parsed->literal_length, parsed->block_count, parsed->partial_count);
+
+    // Blocks repeat and skip parts of the body and partials are linked at run time,
+    // so the generic renderer walks them
+    if (parsed->block_count > 0 || parsed->partial_count > 0) {
+        fprintf(out, "size_t simplet_render_%s_length(const simplet_dictionary_t *dictionary) {\n", name);
+        fprintf(out, "    return simplet_render_length(&simplet_template_%s, dictionary);\n}\n\n", name);
+        fprintf(out, "char* simplet_render_%s(const simplet_dictionary_t *dictionary) {\n", name);
+        fprintf(out, "    return simplet_template_render(&simplet_template_%s, dictionary);\n}\n", name);
+        return;
+    }
+
+    // Length
+    fprintf(out, "size_t simplet_render_%s_length(const simplet_dictionary_t *dictionary) {\n", name);
+    if (parsed->key_count == 0) fprintf(out, "    (void)dictionary;\n");
+    write_lookups(out, parsed, name, "simplet_render_length");
+    write_length(out, parsed);
+    fprintf(out, "    return length;\n}\n\n");
+
+    // Render: one lookup per unique key, then straight copies; reported and
+    // failing like simplet_template_render
+    fprintf(out, "char* simplet_render_%s(const simplet_dictionary_t *dictionary) {\n", name);
+    if (parsed->key_count == 0) fprintf(out, "    (void)dictionary;\n");
+    write_lookups(out, parsed, name, "simplet_template_render");
+    fprintf(out, "    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_BEGIN, 0);\n");
+    write_placeholder_stats(out, parsed);
+    write_length(out, parsed);
+    fprintf(out, "\n    char *output = simplet_malloc(length + 1);\n");
+    fprintf(out, "    if (!output) {\n");
+    fprintf(out, "        SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, 0);\n");
+    fprintf(out, "        output = simplet_malloc(1);\n");
+    fprintf(out, "        if (output) output[0] = '\\0';\n");
+    fprintf(out, "        return output;\n    }\n\n");
+    fprintf(out, "    char *cursor = output;\n");
+    literal = 0;
+    for (size_t i = 0; i < parsed->segment_count; i++) {
+        const segment_t *segment = &parsed->segments[i];
+        if (segment->kind == SIMPLET_OP_PLACEHOLDER && segment->filter != SIMPLET_FILTER_NONE) {
+            fprintf(out, "    if (value_%zu) cursor += simplet_escape(%s, value_%zu->text, value_%zu->length, cursor);\n",
+                    segment->key_index, filter_name(segment->filter), segment->key_index, segment->key_index);
+        } else if (segment->kind == SIMPLET_OP_PLACEHOLDER) {
+            fprintf(out, "    if (value_%zu) {\n", segment->key_index);
+            fprintf(out, "        memcpy(cursor, value_%zu->text, value_%zu->length);\n",
+                    segment->key_index, segment->key_index);
+            fprintf(out, "        cursor += value_%zu->length;\n    }\n", segment->key_index);
+        } else {
+            fprintf(out, "    memcpy(cursor, simplet_%s_literal_%zu, %zu);\n", name, literal++, segment->length);
+            fprintf(out, "    cursor += %zu;\n", segment->length);
+        }
+    }
+    fprintf(out, "    *cursor = '\\0';\n\n");
+    fprintf(out, "    SIMPLET_RENDER_NOTIFY(SIMPLET_RENDER_END, length);\n    return output;\n}\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc != 5) {
+        fprintf(stderr, "usage: simplet_compile <template> <output.c> <output.h> <name>\n");
+        return 2;
+    }
+
+    const char *name = argv[4];
+    for (const char *c = name; *c; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') fail("name must be a C identifier", name);
+    }
+    if (!name[0] || isdigit((unsigned char)name[0])) fail("name must be a C identifier", name);
+    if (strlen(name) > 200) fail("name too long", name);
+
+    parsed_t parsed = { 0 };
+    parsed.text = read_file(argv[1], &parsed.length);
+    parse(&parsed);
+
+    // The header is included by its file name; the build adds its directory to the include path
+    const char *header = strrchr(argv[3], '/');
+    header = header ? header + 1 : argv[3];
+    const char *source = strrchr(argv[1], '/');
+    source = source ? source + 1 : argv[1];
+
+    FILE *out = fopen(argv[3], "w");
+    if (!out) fail("cannot write", argv[3]);
+    write_header(out, &parsed, name, source);
+    if (fclose(out) != 0) fail("cannot write", argv[3]);
+
+    out = fopen(argv[2], "w");
+    if (!out) fail("cannot write", argv[2]);
+    write_source(out, &parsed, name, source, header);
+    if (fclose(out) != 0) fail("cannot write", argv[2]);
+
+    free(parsed.segments);
+    free(parsed.keys);
+    free((char *)parsed.text);
+    return 0;
+}